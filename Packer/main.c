@@ -1,21 +1,240 @@
 #define SDL_MAIN_HANDLED
 #include <SDL2/SDL.h>
+#include <string.h>
+#ifdef _MSC_VER
+#include "src/windowsdirent.h"
+#else
+#include <dirent.h>
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+#define STB_IMAGE_IMPLEMENTATION
+#include <VK2D/stb_image.h>
 #include "src/Packer.h"
+#include "src/TextureFormat.h"
+#include "src/Checksum.h"
+#include "src/cJSON.h"
+
+#define PACKER_CACHE_DIRECTORY "pak_cache"
+
+static const char *gImageExtensions[] = {".png", ".jpg", ".jpeg"};
+
+static void packerMakeDirectory(const char *path) {
+#ifdef _WIN32
+	CreateDirectoryA(path, NULL);
+#else
+	mkdir(path, 0755);
+#endif
+}
+
+// How the images in a directory are converted, from its assets.json
+typedef struct PackerTextureOptions {
+	VKSK_TextureEncoding encoding;
+	bool mipmaps;
+} PackerTextureOptions;
+
+// Decodes an image and saves it as a texture file so the engine doesn't have to decode the png/jpg every launch
+static bool packerConvertTexture(const char *source, const char *output, void *data) {
+	const PackerTextureOptions *options = data;
+	int w, h, channels;
+	uint8_t *pixels = stbi_load(source, &w, &h, &channels, 4);
+	if (pixels == NULL)
+		return false;
+	int size;
+	uint8_t *texture = vksk_TextureEncode(pixels, w, h, options->encoding, options->mipmaps, &size);
+	stbi_image_free(pixels);
+	if (texture == NULL)
+		return false;
+	FILE *f = fopen(output, "wb");
+	bool written = f != NULL && fwrite(texture, 1, size, f) == size;
+	if (f != NULL)
+		fclose(f);
+	free(texture);
+	return written;
+}
+
+// The bitmap fonts in a directory's assets.json
+typedef struct PackerFontList {
+	const char *directory;
+	cJSON *fonts;
+} PackerFontList;
+
+// Saves a bitmap font with only its alpha since glyphs are white, returning false for images that aren't one of
+// the fonts or have colour so they're converted like any other image
+static bool packerConvertFont(const char *source, const char *output, void *data) {
+	const PackerFontList *list = data;
+	bool listed = false;
+	cJSON *font;
+	cJSON_ArrayForEach(font, list->fonts) {
+		cJSON *file = cJSON_GetObjectItem(font, "file");
+		char path[1024];
+		if (cJSON_IsString(file)) {
+			snprintf(path, 1024, "%s/%s", list->directory, file->valuestring);
+			listed = listed || strcmp(path, source) == 0;
+		}
+	}
+	PackerTextureOptions options = {VKSK_TEXTURE_ENCODING_ALPHA, false};
+	return listed && packerConvertTexture(source, output, &options);
+}
+
+// Converts the bitmap fonts in every directory and the images in every directory whose assets.json has
+// "textureCompression" or "mipmaps", returning how many
+static int packerConvertDirectoryTextures(VKSK_Pak pak, const char *directory) {
+	static const char *names[] = {"lossless", "bc1", "bc3", "bc7"};
+	int converted = 0;
+	char path[1024];
+	snprintf(path, 1024, "%s/assets.json", directory);
+	FILE *f = fopen(path, "rb");
+	if (f != NULL) {
+		fseek(f, 0, SEEK_END);
+		long size = ftell(f);
+		fseek(f, 0, SEEK_SET);
+		char *text = malloc(size + 1);
+		text[fread(text, 1, size, f)] = 0;
+		fclose(f);
+		cJSON *json = cJSON_Parse(text);
+		cJSON *compression = json != NULL ? cJSON_GetObjectItem(json, "textureCompression") : NULL;
+		cJSON *mipmaps = json != NULL ? cJSON_GetObjectItem(json, "mipmaps") : NULL;
+		cJSON *fonts = json != NULL ? cJSON_GetObjectItem(json, "bitmap_fonts") : NULL;
+		PackerTextureOptions options = {VKSK_TEXTURE_ENCODING_LOSSLESS, cJSON_IsTrue(mipmaps)};
+
+		// Fonts go first so the passes below skip them, and each list of fonts gets its own cache so an image
+		// that stops being a font isn't packed from an old conversion
+		if (cJSON_GetArraySize(fonts) > 0) {
+			PackerFontList list = {directory, fonts};
+			char *listText = cJSON_PrintUnformatted(fonts);
+			char cache[1024];
+			uint32_t crc = vksk_CRC32C(vksk_CRC32C(0, directory, strlen(directory)), listText, strlen(listText));
+			snprintf(cache, 1024, PACKER_CACHE_DIRECTORY "/alpha_%08x", crc);
+			for (int i = 0; i < sizeof(gImageExtensions) / sizeof(gImageExtensions[0]); i++)
+				converted += vksk_PakConvertFiles(pak, directory, gImageExtensions[i], packerConvertFont, &list, cache);
+			cJSON_free(listText);
+		}
+
+		bool valid = true;
+		if (cJSON_IsString(compression)) {
+			valid = false;
+			for (int i = 1; i < 4; i++) {
+				if (strcmp(compression->valuestring, names[i]) == 0) {
+					options.encoding = i;
+					valid = true;
+				}
+			}
+			if (!valid)
+				printf("Unknown textureCompression \"%s\" in \"%s\"...", compression->valuestring, path);
+		}
+		if (valid && (options.encoding != VKSK_TEXTURE_ENCODING_LOSSLESS || options.mipmaps)) {
+			// Each set of options gets its own cache so changing them doesn't reuse old conversions
+			char cache[1024];
+			snprintf(cache, 1024, PACKER_CACHE_DIRECTORY "/%s%s", names[options.encoding], options.mipmaps ? "_mips" : "");
+			for (int i = 0; i < sizeof(gImageExtensions) / sizeof(gImageExtensions[0]); i++)
+				converted += vksk_PakConvertFiles(pak, directory, gImageExtensions[i], packerConvertTexture, &options, cache);
+		}
+		cJSON_Delete(json);
+		free(text);
+	}
+
+	DIR *dir = opendir(directory);
+	struct dirent *entry;
+	while (dir != NULL && (entry = readdir(dir)) != NULL) {
+		struct stat stbuf;
+		snprintf(path, 1024, "%s/%s", directory, entry->d_name);
+		if (entry->d_name[0] != '.' && stat(path, &stbuf) == 0 && (stbuf.st_mode & S_IFMT) == S_IFDIR)
+			converted += packerConvertDirectoryTextures(pak, path);
+	}
+	if (dir != NULL)
+		closedir(dir);
+	return converted;
+}
 
 int main(int argc, const char *argv[]) {
-	printf("Creating game.pak...");
+	// --rebuild skips reusing the existing game.pak and builds it from scratch, --patch <name> instead creates
+	// paks/<name>.pak with only the files that differ from game.pak and --trace <file> orders the pak by an
+	// access trace (which needs a full rebuild). --verify <pak> just checks an existing pak for corrupt files and
+	// --embed <executable> appends game.pak to the executable once its built. --keep-images packs images as they
+	// are instead of converting them to textures (or block compressing them).
+	bool rebuild = false;
+	bool keepImages = false;
+	const char *patch = NULL;
+	const char *trace = NULL;
+	const char *embed = NULL;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--rebuild") == 0) {
+			rebuild = true;
+		} else if (strcmp(argv[i], "--keep-images") == 0) {
+			keepImages = true;
+		} else if (strcmp(argv[i], "--patch") == 0 && i + 1 < argc) {
+			patch = argv[++i];
+		} else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			trace = argv[++i];
+			rebuild = true;
+		} else if (strcmp(argv[i], "--embed") == 0 && i + 1 < argc) {
+			embed = argv[++i];
+		} else if (strcmp(argv[i], "--verify") == 0 && i + 1 < argc) {
+			VKSK_Pak pak = vksk_PakLoad(argv[++i]);
+			if (pak == NULL) {
+				printf("Failed to load \"%s\"\n", argv[i]);
+				return 1;
+			}
+			int corrupt = vksk_PakVerify(pak);
+			vksk_PakFree(pak);
+			printf("%i corrupt files in \"%s\"\n", corrupt, argv[i]);
+			return corrupt > 0 ? 1 : 0;
+		} else {
+			printf("Unknown argument \"%s\"\n", argv[i]);
+			return 1;
+		}
+	}
+	if (patch != NULL && embed != NULL) {
+		printf("Patches can't be embedded, only game.pak\n");
+		return 1;
+	}
+	char output[1024] = "game.pak";
+	if (patch != NULL) {
+		snprintf(output, 1024, "paks/%s.pak", patch);
+		packerMakeDirectory("paks");
+	}
+	printf("Creating %s...", output);
 
 	// Creates a pak from prog and assets
 	VKSK_Pak pak = vksk_PakCreate();
 	printf("Packing data...");
 	vksk_PakAddDirectory(pak, "data");
+	if (!keepImages) {
+		// Directories with their own options go first since images that are already converted are skipped after
+		PackerTextureOptions options = {VKSK_TEXTURE_ENCODING_LOSSLESS, false};
+		printf("Converting images...");
+		packerMakeDirectory(PACKER_CACHE_DIRECTORY);
+		int converted = packerConvertDirectoryTextures(pak, "data");
+		for (int i = 0; i < sizeof(gImageExtensions) / sizeof(gImageExtensions[0]); i++)
+			converted += vksk_PakConvertFiles(pak, NULL, gImageExtensions[i], packerConvertTexture, &options, PACKER_CACHE_DIRECTORY);
+		printf("%i converted...", converted);
+	}
+	if (patch != NULL)
+		vksk_PakDropUnchanged(pak, "game.pak");
+	if (trace != NULL && !vksk_PakOrderFromTrace(pak, trace))
+		printf("Failed to open trace \"%s\"...", trace);
 	printf("Saving...");
-	vksk_PakSave(pak, "game.pak");
+	if (rebuild || patch != NULL)
+		vksk_PakSave(pak, output);
+	else if (vksk_PakSaveIncremental(pak, output))
+		printf("Updated existing pak...");
 	printf("Done.");
 	vksk_PakFree(pak);
 
-	pak = vksk_PakLoad("game.pak");
+	pak = vksk_PakLoad(output);
 	vksk_PakPrintContents(pak);
 	vksk_PakFree(pak);
+
+	if (embed != NULL) {
+		if (!vksk_PakEmbed(output, embed)) {
+			printf("Failed to embed %s in \"%s\"\n", output, embed);
+			return 1;
+		}
+		printf("Embedded %s in \"%s\"\n", output, embed);
+	}
 	return 0;
 }
@@ -0,0 +1,312 @@
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "src/Packer.h"
+
+// Generates synthetic paks of different sizes and times every part of the pak reader and writer against them,
+// printing the results as JSON so runs from before and after a change can be compared. Reads are done right after
+// the pak is built so they measure the reader itself with a warm file cache, not the disk.
+
+#define BENCH_DIRECTORY "pakbench_data"
+#define BENCH_PAK "pakbench.pak"
+#define BENCH_FILES_PER_DIR 100
+#define BENCH_MIN_TIME 0.25 // Timed loops repeat until they've taken at least this many seconds
+
+typedef struct BenchData {
+	char **names;   // Every file, in the order they were generated
+	char **dirs;    // Every directory, parents before children
+	int count;
+	int dirCount;
+	uint64_t totalBytes;
+} BenchData;
+
+typedef struct BenchThread {
+	VKSK_Pak pak;
+	BenchData *data;
+	int first;
+	int stride;
+	uint64_t bytes;
+} BenchThread;
+
+static uint64_t gRandom = 0x9E3779B97F4A7C15ull;
+
+static uint32_t benchRandom() {
+	gRandom ^= gRandom << 13;
+	gRandom ^= gRandom >> 7;
+	gRandom ^= gRandom << 17;
+	return gRandom >> 32;
+}
+
+static double benchNow() {
+	return (double)SDL_GetPerformanceCounter() / SDL_GetPerformanceFrequency();
+}
+
+static void benchMakeDir(const char *path) {
+#ifdef _WIN32
+	CreateDirectoryA(path, NULL);
+#else
+	mkdir(path, 0755);
+#endif
+}
+
+static void benchRemoveDir(const char *path) {
+#ifdef _WIN32
+	RemoveDirectoryA(path);
+#else
+	rmdir(path);
+#endif
+}
+
+static char *benchCopyString(const char *string) {
+	char *s = malloc(strlen(string) + 1);
+	strcpy(s, string);
+	return s;
+}
+
+// Mostly small files with a few big ones, about half of them text that compresses and half noise that doesn't
+static void benchWriteFile(const char *filename, int size, bool text, uint8_t *buffer) {
+	static const char *words[] = {"player", "enemy", "tile", "0.5", "sprite", "{\"x\": ", "level", "\n", "true", ", "};
+	int pos = 0;
+	while (pos < size) {
+		if (text) {
+			const char *word = words[benchRandom() % (sizeof(words) / sizeof(words[0]))];
+			int length = strlen(word);
+			memcpy(buffer + pos, word, pos + length > size ? size - pos : length);
+			pos += length;
+		} else {
+			buffer[pos++] = benchRandom();
+		}
+	}
+	FILE *f = fopen(filename, "wb");
+	if (f != NULL) {
+		fwrite(buffer, 1, size, f);
+		fclose(f);
+	}
+}
+
+static BenchData benchGenerate(int count) {
+	BenchData data = {0};
+	data.names = malloc(sizeof(char*) * count);
+	data.dirs = malloc(sizeof(char*) * (count / BENCH_FILES_PER_DIR + 2));
+	uint8_t *buffer = malloc(65536);
+	char path[256];
+
+	benchMakeDir(BENCH_DIRECTORY);
+	data.dirs[data.dirCount++] = benchCopyString(BENCH_DIRECTORY);
+	for (int i = 0; i < count; i++) {
+		if (i % BENCH_FILES_PER_DIR == 0) {
+			snprintf(path, 256, BENCH_DIRECTORY "/dir%i", i / BENCH_FILES_PER_DIR);
+			benchMakeDir(path);
+			data.dirs[data.dirCount++] = benchCopyString(path);
+		}
+		uint32_t kind = benchRandom() % 100;
+		int size = kind < 75 ? 64 + benchRandom() % 960 : (kind < 97 ? 1024 + benchRandom() % 7168 : 8192 + benchRandom() % 57344);
+		bool text = benchRandom() % 2 == 0;
+		snprintf(path, 256, BENCH_DIRECTORY "/dir%i/file%i.%s", i / BENCH_FILES_PER_DIR, i, text ? "txt" : "png");
+		benchWriteFile(path, size, text, buffer);
+		data.names[data.count++] = benchCopyString(path);
+		data.totalBytes += size;
+	}
+
+	free(buffer);
+	return data;
+}
+
+static void benchDestroy(BenchData *data) {
+	for (int i = 0; i < data->count; i++) {
+		remove(data->names[i]);
+		free(data->names[i]);
+	}
+	for (int i = data->dirCount - 1; i >= 0; i--) {
+		benchRemoveDir(data->dirs[i]);
+		free(data->dirs[i]);
+	}
+	free(data->names);
+	free(data->dirs);
+	remove(BENCH_PAK);
+}
+
+static int benchIterate(VKSK_Pak pak, const char *directory) {
+	VKSK_PakDir dir;
+	int count = 0;
+	for (const char *f = vksk_PakBeginLoop(pak, &dir, directory); f != NULL; f = vksk_PakNext(&dir)) {
+		count++;
+		if (f[strlen(f) - 1] == '/')
+			count += benchIterate(pak, f);
+	}
+	return count;
+}
+
+static uint64_t benchReadAll(VKSK_Pak pak, BenchData *data, int first, int stride) {
+	uint64_t bytes = 0;
+	for (int i = first; i < data->count; i += stride) {
+		int size;
+		uint8_t *buffer = vksk_PakGetFile(pak, data->names[i], &size);
+		if (buffer != NULL)
+			bytes += size;
+		free(buffer);
+	}
+	return bytes;
+}
+
+static int benchReadThread(void *ptr) {
+	BenchThread *thread = ptr;
+	thread->bytes = benchReadAll(thread->pak, thread->data, thread->first, thread->stride);
+	return 0;
+}
+
+static void benchRun(int count, bool last) {
+	gRandom = 0x9E3779B97F4A7C15ull ^ count;
+	BenchData data = benchGenerate(count);
+	const double mb = 1024.0 * 1024.0;
+
+	// Build
+	double start = benchNow();
+	VKSK_Pak pak = vksk_PakCreate();
+	vksk_PakAddDirectory(pak, BENCH_DIRECTORY);
+	vksk_PakSave(pak, BENCH_PAK);
+	vksk_PakFree(pak);
+	double buildTime = benchNow() - start;
+	FILE *f = fopen(BENCH_PAK, "rb");
+	uint64_t pakBytes = 0;
+	if (f != NULL) {
+		fseek(f, 0, SEEK_END);
+		pakBytes = ftell(f);
+		fclose(f);
+	}
+
+	// Index parse
+	int loads = 0;
+	start = benchNow();
+	do {
+		vksk_PakFree(vksk_PakLoad(BENCH_PAK));
+		loads++;
+	} while (benchNow() - start < BENCH_MIN_TIME);
+	double loadTime = (benchNow() - start) / loads;
+
+	// Lookups, half of them miss
+	pak = vksk_PakLoad(BENCH_PAK);
+	char **lookups = malloc(sizeof(char*) * count * 2);
+	char **misses = malloc(sizeof(char*) * count);
+	for (int i = 0; i < count; i++) {
+		misses[i] = malloc(64);
+		snprintf(misses[i], 64, BENCH_DIRECTORY "/missing/file%i.txt", i);
+		lookups[i * 2] = data.names[i];
+		lookups[i * 2 + 1] = misses[i];
+	}
+	for (int i = count * 2 - 1; i > 0; i--) {
+		int j = benchRandom() % (i + 1);
+		char *temp = lookups[i];
+		lookups[i] = lookups[j];
+		lookups[j] = temp;
+	}
+	int found = 0;
+	for (int i = 0; i < count * 2; i++)
+		found += vksk_PakFileExists(pak, lookups[i]);
+	uint64_t lookupCount = 0;
+	volatile int sink = 0;
+	start = benchNow();
+	do {
+		for (int i = 0; i < count * 2; i++)
+			sink += vksk_PakFileExists(pak, lookups[i]);
+		lookupCount += count * 2;
+	} while (benchNow() - start < BENCH_MIN_TIME);
+	double lookupTime = benchNow() - start;
+	for (int i = 0; i < count; i++)
+		free(misses[i]);
+	free(misses);
+	free(lookups);
+
+	// Iteration over the whole tree
+	int iterations = 0;
+	int iterated = 0;
+	start = benchNow();
+	do {
+		iterated = benchIterate(pak, "./");
+		iterations++;
+	} while (benchNow() - start < BENCH_MIN_TIME);
+	double iterateTime = (benchNow() - start) / iterations;
+
+	// Reads, one pass to warm the cache first
+	benchReadAll(pak, &data, 0, 1);
+	start = benchNow();
+	uint64_t readBytes = benchReadAll(pak, &data, 0, 1);
+	double readTime = benchNow() - start;
+	vksk_PakFree(pak);
+
+	pak = vksk_PakLoadMapped(BENCH_PAK);
+	start = benchNow();
+	uint64_t mappedBytes = benchReadAll(pak, &data, 0, 1);
+	double mappedTime = benchNow() - start;
+	vksk_PakFree(pak);
+
+	pak = vksk_PakLoad(BENCH_PAK);
+	int threadCount = SDL_GetCPUCount() > 1 ? SDL_GetCPUCount() : 1;
+	BenchThread *threads = malloc(sizeof(BenchThread) * threadCount);
+	SDL_Thread **handles = malloc(sizeof(SDL_Thread*) * threadCount);
+	start = benchNow();
+	for (int i = 0; i < threadCount; i++) {
+		threads[i].pak = pak;
+		threads[i].data = &data;
+		threads[i].first = i;
+		threads[i].stride = threadCount;
+		handles[i] = SDL_CreateThread(benchReadThread, "PakBenchRead", &threads[i]);
+	}
+	uint64_t parallelBytes = 0;
+	for (int i = 0; i < threadCount; i++) {
+		SDL_WaitThread(handles[i], NULL);
+		parallelBytes += threads[i].bytes;
+	}
+	double parallelTime = benchNow() - start;
+	free(handles);
+	free(threads);
+	vksk_PakFree(pak);
+
+	printf("\t\t{\n");
+	printf("\t\t\t\"entries\": %i,\n", count);
+	printf("\t\t\t\"total_bytes\": %llu,\n", (unsigned long long)data.totalBytes);
+	printf("\t\t\t\"pak_bytes\": %llu,\n", (unsigned long long)pakBytes);
+	printf("\t\t\t\"build_ms\": %.3f,\n", buildTime * 1000);
+	printf("\t\t\t\"load_ms\": %.4f,\n", loadTime * 1000);
+	printf("\t\t\t\"lookups_per_sec\": %.0f,\n", lookupCount / lookupTime);
+	printf("\t\t\t\"lookups_found\": %i,\n", found);
+	printf("\t\t\t\"iterate_ms\": %.4f,\n", iterateTime * 1000);
+	printf("\t\t\t\"iterated_entries\": %i,\n", iterated);
+	printf("\t\t\t\"read_mb_per_sec\": %.2f,\n", readBytes / mb / readTime);
+	printf("\t\t\t\"mapped_read_mb_per_sec\": %.2f,\n", mappedBytes / mb / mappedTime);
+	printf("\t\t\t\"parallel_read_mb_per_sec\": %.2f,\n", parallelBytes / mb / parallelTime);
+	printf("\t\t\t\"parallel_threads\": %i\n", threadCount);
+	printf("\t\t}%s\n", last ? "" : ",");
+	fflush(stdout);
+
+	benchDestroy(&data);
+}
+
+int main(int argc, const char *argv[]) {
+	// --entries <n> runs only that size instead of the whole suite
+	int sizes[] = {10, 1000, 10000, 100000};
+	int sizeCount = sizeof(sizes) / sizeof(sizes[0]);
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--entries") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+			sizes[0] = atoi(argv[++i]);
+			sizeCount = 1;
+		} else {
+			fprintf(stderr, "Unknown argument \"%s\"\n", argv[i]);
+			return 1;
+		}
+	}
+
+	printf("{\n\t\"cpu_count\": %i,\n\t\"runs\": [\n", SDL_GetCPUCount());
+	for (int i = 0; i < sizeCount; i++)
+		benchRun(sizes[i], i == sizeCount - 1);
+	printf("\t]\n}\n");
+	return 0;
+}
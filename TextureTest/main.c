@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#define STB_IMAGE_IMPLEMENTATION
+#include <VK2D/stb_image.h>
+#include "src/TextureFormat.h"
+
+// Checks that every texture encoding round trips within its error bound, with and without mip chains, and that
+// the decoders turn down truncated, corrupted and malformed files instead of reading past them. Everything runs
+// on the CPU so this needs no GPU. Returns non-zero if anything failed.
+
+#define TEST_HEADER_SIZE 24      // Size of a texture file's header, see TextureFormat.c
+#define TEST_LEVEL_HEADER_SIZE 8 // Size of each level's header
+#define TEST_FLIPS 300           // Corrupted copies decoded per texture
+
+typedef struct TestImage {
+	const char *name;
+	int w, h;
+	uint8_t *pixels;
+} TestImage;
+
+typedef struct TestEncoding {
+	const char *name;
+	VKSK_TextureEncoding encoding;
+	double maxColourRMSE; // Over pixels that are visible after encoding, for level 0
+	double maxAlphaRMSE;
+	bool binaryAlpha;     // Alpha is either 0 or 255 after encoding, split at 128
+} TestEncoding;
+
+static const TestEncoding gEncodings[] = {
+	{"lossless", VKSK_TEXTURE_ENCODING_LOSSLESS, 0, 0, false},
+	{"bc1", VKSK_TEXTURE_ENCODING_BC1, 5, 0, true},
+	{"bc3", VKSK_TEXTURE_ENCODING_BC3, 5, 1, false},
+	{"bc7", VKSK_TEXTURE_ENCODING_BC7, 3.5, 3, false},
+};
+
+static int gFailures = 0;
+static uint64_t gRandom = 0x9E3779B97F4A7C15ull;
+
+static uint32_t testRandom() {
+	gRandom ^= gRandom << 13;
+	gRandom ^= gRandom >> 7;
+	gRandom ^= gRandom << 17;
+	return gRandom >> 32;
+}
+
+static void testCheck(bool passed, const char *what, const char *image, const char *encoding) {
+	if (!passed) {
+		printf("FAIL: %s (%s, %s)\n", what, image, encoding);
+		gFailures++;
+	}
+}
+
+// Gradients with smooth alpha that change by at most a few steps a pixel, which is what block compression is meant for
+static TestImage testGradient(int w, int h) {
+	TestImage image = {"gradient", w, h, malloc((size_t)w * h * 4)};
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			uint8_t *px = &image.pixels[(y * w + x) * 4];
+			px[0] = x * 4 < 255 ? x * 4 : 255;
+			px[1] = y * 4 < 255 ? y * 4 : 255;
+			px[2] = 128 + (x - y) * 2 / 3;
+			px[3] = x * 3 < 191 ? 255 - x * 3 : 64;
+		}
+	}
+	return image;
+}
+
+// Random pixels with a few fully transparent ones, only lossless is expected to get these exactly right
+static TestImage testNoise(int w, int h) {
+	TestImage image = {"noise", w, h, malloc((size_t)w * h * 4)};
+	for (int i = 0; i < w * h; i++) {
+		uint32_t r = testRandom();
+		memcpy(&image.pixels[i * 4], &r, 4);
+		if (r % 7 == 0)
+			image.pixels[i * 4 + 3] = 0;
+	}
+	return image;
+}
+
+// White with varying alpha, like a font
+static TestImage testGlyphs(int w, int h) {
+	TestImage image = {"glyphs", w, h, malloc((size_t)w * h * 4)};
+	for (int i = 0; i < w * h; i++) {
+		image.pixels[i * 4] = image.pixels[i * 4 + 1] = image.pixels[i * 4 + 2] = 255;
+		image.pixels[i * 4 + 3] = (i * 37) % 5 == 0 ? 0 : (i * 13) & 0xFF;
+	}
+	return image;
+}
+
+// Compares decoded pixels against what was encoded, returning false if they're off by more than the encoding allows.
+// Each level down the gradients are twice as steep, so the error allowed doubles with it.
+static bool testCompare(const TestEncoding *encoding, const uint8_t *expected, const uint8_t *actual, int pixelCount, int level) {
+	double colourError = 0, alphaError = 0;
+	int visible = 0;
+	for (int i = 0; i < pixelCount; i++) {
+		const uint8_t *e = &expected[i * 4];
+		const uint8_t *a = &actual[i * 4];
+		if (encoding->binaryAlpha) {
+			if (a[3] != (e[3] >= 128 ? 255 : 0))
+				return false;
+		} else {
+			alphaError += (double)(e[3] - a[3]) * (e[3] - a[3]);
+		}
+		if (a[3] == 0)
+			continue;
+		for (int c = 0; c < 3; c++)
+			colourError += (double)(e[c] - a[c]) * (e[c] - a[c]);
+		visible++;
+	}
+	double colourRMSE = visible > 0 ? sqrt(colourError / (visible * 3)) : 0;
+	double alphaRMSE = sqrt(alphaError / pixelCount);
+	return colourRMSE <= encoding->maxColourRMSE * (1 << level) && alphaRMSE <= encoding->maxAlphaRMSE * (1 << level);
+}
+
+// Lossless textures are exact so their mip chains are what every other encoding's levels should look like
+static uint8_t *testReferenceLevel(const TestImage *image, int level) {
+	int size, w, h;
+	uint8_t *texture = vksk_TextureEncode(image->pixels, image->w, image->h, VKSK_TEXTURE_ENCODING_LOSSLESS, true, &size);
+	uint8_t *pixels = texture != NULL ? vksk_TextureDecodeLevel(texture, size, level, &w, &h) : NULL;
+	free(texture);
+	return pixels;
+}
+
+// Decodes a texture every way there is, which may fail but must never crash or read outside of it
+static void testDecodeAll(const uint8_t *data, int size) {
+	int w, h, levels;
+	free(vksk_TextureDecode(data, size, &w, &h));
+	free(vksk_TextureDecodeAlpha(data, size, &w, &h));
+	int count = vksk_TextureLevelCount(data, size);
+	for (int i = 0; i <= count; i++)
+		free(vksk_TextureDecodeLevel(data, size, i, &w, &h));
+	stbi_image_free(vksk_TextureLoadPixels(data, size, &w, &h, &levels));
+}
+
+// Copies a texture into a buffer of exactly `size` bytes so ASan catches any read past the end
+static uint8_t *testCopy(const uint8_t *data, int size) {
+	uint8_t *copy = malloc(size > 0 ? size : 1);
+	memcpy(copy, data, size);
+	return copy;
+}
+
+static void testMalformed(const TestImage *image, const TestEncoding *encoding, const uint8_t *texture, int size) {
+	int w, h;
+
+	// Anything cut off before the end of level 0 can't be decoded, past that only the later levels are lost
+	int levelZeroEnd = TEST_HEADER_SIZE + 4 + TEST_LEVEL_HEADER_SIZE;
+	uint32_t levelZeroSize;
+	memcpy(&levelZeroSize, texture + TEST_HEADER_SIZE + 4 + 4, 4);
+	levelZeroEnd += levelZeroSize;
+	bool truncatedOk = true;
+	for (int cut = 0; cut < size; cut += size > 4096 ? 7 : 1) {
+		uint8_t *copy = testCopy(texture, cut);
+		uint8_t *pixels = vksk_TextureDecode(copy, cut, &w, &h);
+		if (cut < levelZeroEnd && pixels != NULL)
+			truncatedOk = false;
+		free(pixels);
+		testDecodeAll(copy, cut);
+		free(copy);
+	}
+	testCheck(truncatedOk, "truncated texture decoded", image->name, encoding->name);
+
+	// Flipped bits may still decode to something, they just can't crash
+	uint8_t *copy = testCopy(texture, size);
+	for (int i = 0; i < TEST_FLIPS; i++) {
+		int bit = testRandom() % (size * 8);
+		copy[bit / 8] ^= 1 << (bit % 8);
+		testDecodeAll(copy, size);
+		copy[bit / 8] ^= 1 << (bit % 8);
+	}
+
+	// Headers that lie about the texture
+	uint32_t value;
+	memcpy(copy, "ASTROTEZ", 8);
+	testCheck(!vksk_TextureIsEncoded(copy, size) && vksk_TextureDecode(copy, size, &w, &h) == NULL, "wrong magic accepted", image->name, encoding->name);
+	memcpy(copy, texture, size);
+	value = 3;
+	memcpy(copy + 8, &value, 4);
+	testCheck(vksk_TextureDecode(copy, size, &w, &h) == NULL, "unknown version accepted", image->name, encoding->name);
+	memcpy(copy, texture, size);
+	value = 0;
+	memcpy(copy + 16, &value, 4);
+	testCheck(vksk_TextureDecode(copy, size, &w, &h) == NULL, "zero width accepted", image->name, encoding->name);
+	memcpy(copy, texture, size);
+	value = 40;
+	memcpy(copy + TEST_HEADER_SIZE, &value, 4);
+	testCheck(vksk_TextureLevelCount(copy, size) == 0 && vksk_TextureDecode(copy, size, &w, &h) == NULL, "too many levels accepted", image->name, encoding->name);
+	memcpy(copy, texture, size);
+	value = 99;
+	memcpy(copy + TEST_HEADER_SIZE + 4, &value, 4);
+	testCheck(vksk_TextureDecode(copy, size, &w, &h) == NULL, "unknown format accepted", image->name, encoding->name);
+	memcpy(copy, texture, size);
+	value = 0x7FFFFFFF;
+	memcpy(copy + TEST_HEADER_SIZE + 8, &value, 4);
+	testCheck(vksk_TextureDecode(copy, size, &w, &h) == NULL, "oversized level accepted", image->name, encoding->name);
+	free(copy);
+}
+
+static void testEncoding(const TestImage *image, const TestEncoding *encoding, bool mipmaps) {
+	char name[64];
+	snprintf(name, 64, "%s%s", encoding->name, mipmaps ? " with mips" : "");
+	int size, w, h;
+	uint8_t *texture = vksk_TextureEncode(image->pixels, image->w, image->h, encoding->encoding, mipmaps, &size);
+	testCheck(texture != NULL, "couldn't encode", image->name, name);
+	if (texture == NULL)
+		return;
+
+	// Each level against the same level of the lossless chain
+	int levels = vksk_TextureLevelCount(texture, size);
+	int expectedLevels = 1;
+	while (mipmaps && (image->w >> expectedLevels > 0 || image->h >> expectedLevels > 0))
+		expectedLevels++;
+	testCheck(levels == expectedLevels, "wrong number of levels", image->name, name);
+	size_t chainSize = 0;
+	for (int level = 0; level < levels; level++) {
+		uint8_t *pixels = vksk_TextureDecodeLevel(texture, size, level, &w, &h);
+		uint8_t *expected = testReferenceLevel(image, level);
+		bool sized = pixels != NULL && w == vksk_TextureLevelSize(image->w, level) && h == vksk_TextureLevelSize(image->h, level);
+		testCheck(sized, "level decoded at the wrong size", image->name, name);
+		if (sized && expected != NULL) {
+			if (encoding->encoding == VKSK_TEXTURE_ENCODING_LOSSLESS)
+				testCheck(memcmp(pixels, expected, (size_t)w * h * 4) == 0, "lossless level changed", image->name, name);
+			else
+				testCheck(testCompare(encoding, expected, pixels, w * h, level), "level over its error bound", image->name, name);
+		}
+		chainSize += (size_t)w * h * 4;
+		free(pixels);
+		free(expected);
+	}
+
+	// vksk_TextureLoadPixels gives the same chain all in one buffer
+	int loadedLevels;
+	uint8_t *chain = vksk_TextureLoadPixels(texture, size, &w, &h, &loadedLevels);
+	bool sameChain = chain != NULL && loadedLevels == levels && w == image->w && h == image->h;
+	size_t offset = 0;
+	for (int level = 0; level < levels && sameChain; level++) {
+		int lw, lh;
+		uint8_t *pixels = vksk_TextureDecodeLevel(texture, size, level, &lw, &lh);
+		sameChain = pixels != NULL && offset + (size_t)lw * lh * 4 <= chainSize && memcmp(chain + offset, pixels, (size_t)lw * lh * 4) == 0;
+		offset += (size_t)lw * lh * 4;
+		free(pixels);
+	}
+	testCheck(sameChain, "loaded chain doesn't match its levels", image->name, name);
+	stbi_image_free(chain);
+
+	testMalformed(image, encoding, texture, size);
+	free(texture);
+}
+
+// Textures from before mip chains were a single level right after the header
+static void testVersion1(const TestImage *image) {
+	int size, w, h;
+	uint8_t *texture = vksk_TextureEncode(image->pixels, image->w, image->h, VKSK_TEXTURE_ENCODING_LOSSLESS, false, &size);
+	if (texture == NULL)
+		return;
+	int payload = size - TEST_HEADER_SIZE - 4 - TEST_LEVEL_HEADER_SIZE;
+	uint8_t *old = malloc(TEST_HEADER_SIZE + payload);
+	uint32_t version = 1;
+	memcpy(old, texture, TEST_HEADER_SIZE);
+	memcpy(old + 8, &version, 4);
+	memcpy(old + TEST_HEADER_SIZE, texture + TEST_HEADER_SIZE + 4 + TEST_LEVEL_HEADER_SIZE, payload);
+	uint8_t *pixels = vksk_TextureDecode(old, TEST_HEADER_SIZE + payload, &w, &h);
+	testCheck(pixels != NULL && w == image->w && h == image->h && memcmp(pixels, image->pixels, (size_t)w * h * 4) == 0, "version 1 texture didn't decode", image->name, "lossless");
+	free(pixels);
+	free(old);
+	free(texture);
+}
+
+// Alpha textures only take images where every visible pixel is white
+static void testAlpha(const TestImage *image) {
+	bool white = true;
+	for (int i = 0; i < image->w * image->h; i++) {
+		const uint8_t *px = &image->pixels[i * 4];
+		if (px[3] > 0 && (px[0] != 255 || px[1] != 255 || px[2] != 255))
+			white = false;
+	}
+	int size, w, h;
+	uint8_t *texture = vksk_TextureEncode(image->pixels, image->w, image->h, VKSK_TEXTURE_ENCODING_ALPHA, false, &size);
+	if (!white) {
+		testCheck(texture == NULL, "coloured image encoded as alpha", image->name, "alpha");
+		free(texture);
+		return;
+	}
+	testCheck(texture != NULL, "couldn't encode", image->name, "alpha");
+	if (texture == NULL)
+		return;
+	uint8_t *alpha = vksk_TextureDecodeAlpha(texture, size, &w, &h);
+	uint8_t *pixels = vksk_TextureDecode(texture, size, &w, &h);
+	bool same = alpha != NULL && pixels != NULL && w == image->w && h == image->h;
+	for (int i = 0; same && i < w * h; i++)
+		same = alpha[i] == image->pixels[i * 4 + 3] && pixels[i * 4] == 255 && pixels[i * 4 + 1] == 255 &&
+			   pixels[i * 4 + 2] == 255 && pixels[i * 4 + 3] == alpha[i];
+	testCheck(same, "alpha texture changed", image->name, "alpha");
+	free(alpha);
+	free(pixels);
+	TestEncoding encoding = {"alpha", VKSK_TEXTURE_ENCODING_ALPHA, 0, 0, false};
+	testMalformed(image, &encoding, texture, size);
+	free(texture);
+}
+
+int main(int argc, const char *argv[]) {
+	static const int sizes[][2] = {{1, 1}, {3, 5}, {4, 4}, {17, 9}, {64, 64}, {100, 37}, {1, 300}};
+	int sizeCount = sizeof(sizes) / sizeof(sizes[0]);
+	for (int s = 0; s < sizeCount; s++) {
+		TestImage images[] = {testGradient(sizes[s][0], sizes[s][1]), testNoise(sizes[s][0], sizes[s][1]), testGlyphs(sizes[s][0], sizes[s][1])};
+		for (int i = 0; i < 3; i++) {
+			// Only the gradients are expected to come back close from block compression, the others are still fed to
+			// it to check nothing crashes and BC1 alpha is still cut off at 128
+			for (int e = 0; e < sizeof(gEncodings) / sizeof(gEncodings[0]); e++) {
+				TestEncoding encoding = gEncodings[e];
+				if (i != 0 && encoding.encoding != VKSK_TEXTURE_ENCODING_LOSSLESS)
+					encoding.maxColourRMSE = encoding.maxAlphaRMSE = 255;
+				testEncoding(&images[i], &encoding, false);
+				testEncoding(&images[i], &encoding, true);
+			}
+			testVersion1(&images[i]);
+			testAlpha(&images[i]);
+		}
+		for (int i = 0; i < 3; i++)
+			free(images[i].pixels);
+	}
+
+	// Images too big to be textures
+	uint8_t pixel[4] = {0};
+	int size;
+	testCheck(vksk_TextureEncode(pixel, 0, 1, VKSK_TEXTURE_ENCODING_LOSSLESS, false, &size) == NULL, "empty image encoded", "empty", "lossless");
+	testCheck(vksk_TextureEncode(pixel, 1 << 20, 1, VKSK_TEXTURE_ENCODING_LOSSLESS, false, &size) == NULL, "huge image encoded", "huge", "lossless");
+
+	if (gFailures == 0)
+		printf("All texture tests passed\n");
+	else
+		printf("%i texture tests failed\n", gFailures);
+	return gFailures == 0 ? 0 : 1;
+}
@@ -12,6 +12,13 @@ int main(int argc, char *argv[]) {
 	gEngineConfig.enableDebugOverlay = vksk_ConfigGetBool(engineConfig, "engine", "enableDebugOverlay", false);
 	gEngineConfig.enableAssetsPrint = vksk_ConfigGetBool(engineConfig, "engine", "enableAssetsPrint", false);
 	gEngineConfig.disableGamePak = vksk_ConfigGetBool(engineConfig, "engine", "disableGamePak", false);
+	gEngineConfig.disablePakMapping = vksk_ConfigGetBool(engineConfig, "engine", "disablePakMapping", false);
+	gEngineConfig.disableOverrideDirectory = vksk_ConfigGetBool(engineConfig, "engine", "disableOverrideDirectory", false);
+	gEngineConfig.recordAccessTrace = vksk_ConfigGetBool(engineConfig, "engine", "recordAccessTrace", false);
+	gEngineConfig.disableAssetCache = vksk_ConfigGetBool(engineConfig, "engine", "disableAssetCache", false);
+	gEngineConfig.disableFontCache = vksk_ConfigGetBool(engineConfig, "engine", "disableFontCache", false);
+	gEngineConfig.lazyAssets = vksk_ConfigGetBool(engineConfig, "engine", "lazyAssets", false);
+	gEngineConfig.atlasTextures = vksk_ConfigGetBool(engineConfig, "engine", "atlasTextures", false);
 	gEngineConfig.gcBetweenLevels = vksk_ConfigGetBool(engineConfig, "engine", "gcBetweenLevels", true);
 	vksk_ConfigFree(engineConfig);
 	gEngineConfig.argc = argc;
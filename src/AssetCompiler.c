@@ -10,11 +10,17 @@
 #include <sys/types.h>
 #include <string.h>
 #include <VK2D/Util.h>
+#include <VK2D/stb_image.h>
 
 #include "src/cJSON.h"
 #include "src/Runtime.h"
 #include "src/Validation.h"
 #include "src/ConfigFile.h"
+#include "src/Util.h"
+#include "src/VK2DTypes.h"
+#include "src/JUTypes.h"
+#include "src/InternalBindings.h"
+#include "src/AssetDecoder.h"
 
 // -------------------- NEW ASSET COMPILER -------------------- //
 //
@@ -36,55 +42,58 @@
 // |    | jump.ogg
 // | banner.jpg
 //
+// The Wren code only has the getters, the assets themselves are loaded by vksk_RuntimeAssetsLoadManifest from a
+// binary manifest the compiler writes alongside it (see "Manifest" below). It returns a list per directory with
+// the assets in the order the getters index them and sub-directories as nested lists. With lazyAssets the lists
+// start out as nulls and each getter loads its asset the first time it is used.
 //
 //     import "lib/Drawing" for Texture, Sprite, BitmapFont, Font
 //     import "lib/Audio" for AudioData
 //
-//     class dirspritesImpl {
-//         tex_player { _tex_player }
-//         spr_player { _spr_player }
-//         tex_player_run { _tex_player_run }
-//         spr_player_run { _spr_player_run }
+//     class Cdir_spritesImpl {
+//         tex_player { _a[0] || AssetsImpl.load_asset(1) }
+//         spr_player { _a[1] || AssetsImpl.load_asset(2) }
+//         tex_player_run { _a[2] || AssetsImpl.load_asset(3) }
+//         spr_player_run { _a[3] || AssetsImpl.load_asset(4) }
 //
-//         construct new(asset_map) {
-//             _tex_player = Texture.new("assets/dir/sprites/player.png")
-//             asset_map["dir.sprites.tex_player"] = _tex_player
-//             _spr_player = Sprite.from(_tex_player, ...)
-//             asset_map["dir.sprites.spr_player"] = _spr_player
-//             _tex_player_run = Texture.new("assets/dir/sprites/player_run.png")
-//             asset_map["dir.sprites.tex_player_run"] = _tex_player_run
-//             _spr_player_run = Sprite.from(_tex_player_run, ...)
-//             asset_map["dir.sprites.spr_player_run"] = _spr_player_run
+//         construct new(a) {
+//             _a = a
 //         }
 //     }
 //
-//     class dirImpl {
-//         sprites { _sprites }
-//         aud_jump { _aud_jump }
+//     class CdirImpl {
+//         aud_jump { _a[0] || AssetsImpl.load_asset(0) }
+//         dir_sprites { _dir_sprites }
 //
-//         construct new(asset_map) {
-//             _sprites = dirspritesImpl.new(asset_map)
-//             _aud_jump = AudioData.open("assets/dir/jump.ogg")
-//             asset_map["dir.aud_jump"] = _aud_jump
+//         construct new(a) {
+//             _a = a
+//             _dir_sprites = Cdir_spritesImpl.new(a[1])
 //         }
 //     }
 //
 //     class AssetsImpl {
-//         dir { _dir }
-//         tex_banner { _tex_banner }
-//
 //         construct new() {}
 //
+//         foreign static load_manifest()
+//         foreign static load_asset(asset)
+//         foreign static preload(group)
+//
+//         dir { _dir }
+//         tex_banner { _a[2] || AssetsImpl.load_asset(5) }
+//
 //         load_assets() {
-//             _asset_map = {}
-//             var asset_map = _asset_map
-//             _dir = dirImpl.new(asset_map)
-//             _tex_banner = Texture.new("assets/banner.jpg")
-//             asset_map["tex_banner"] = _tex_banner
+//             var a = AssetsImpl.load_manifest()
+//             _a = a
+//             _asset_map = a[0]
+//             _dir = CdirImpl.new(a[1])
+//         }
+//
+//         preload(group) {
+//             AssetsImpl.preload(group)
 //         }
 //
 //         [asset] {
-//             return _asset_map[asset]
+//             return _asset_map[asset] || AssetsImpl.load_asset(asset)
 //         }
 //     }
 //
@@ -113,33 +122,40 @@ const char *LOAD_FOOTER = "    }\n\n";
 
 const char *ASSET_FILE_HEADER = "import \"lib/Drawing\" for Texture, Sprite, BitmapFont, Font\nimport \"lib/Audio\" for AudioData\nimport \"lib/File\" for File\nimport \"lib/Util\" for Buffer\n\n";
 const char *ASSET_FILE_FOOTER = "\nvar Assets = AssetsImpl.new()\n";
-const char *ASSET_ASSET_CLASS_HEADER = "class AssetsImpl {\n\tconstruct new() {}\n\n";
-const char *ASSET_ASSET_CLASS_FOOTER = "\n\t[asset] {\n\t\treturn _asset_map[asset]\n\t}\n}\n";
+const char *ASSET_ASSET_CLASS_HEADER = "class AssetsImpl {\n\tconstruct new() {}\n\n\tforeign static load_manifest()\n\tforeign static load_asset(asset)\n\tforeign static preload(group)\n\n";
+const char *ASSET_ASSET_LOAD_HEADER = "\n\tload_assets() {\n\t\tvar a = AssetsImpl.load_manifest()\n\t\t_a = a\n\t\t_asset_map = a[0]\n";
+const char *ASSET_DIR_LOAD_HEADER = "\n\tconstruct new(a) {\n\t\t_a = a\n";
+const char *ASSET_ASSET_CLASS_FOOTER = "\n\tpreload(group) {\n\t\tAssetsImpl.preload(group)\n\t}\n\n\t[asset] {\n\t\treturn _asset_map[asset] || AssetsImpl.load_asset(asset)\n\t}\n}\n";
 const char *ASSET_DIR_CLASS_HEADER = "\n";
 const char *ASSET_DIR_CLASS_FOOTER = "}\n\n";
 
 const char* loadFile(const char *filename);
+unsigned char* loadFileRaw(const char *filename, int *size); // from InternalBindings.c
 
 // ------------------------------- Strings ------------------------------- //
 typedef struct String {
 	char *str;
 	int len;
+	int capacity;
 } *String;
 
 static String newString() {
 	String s = malloc(sizeof (struct String));
 	s->len = 0;
+	s->capacity = 0;
 	s->str = NULL;
 	return s;
 }
 
-// Returns the same string just for convenience
+// Returns the same string just for convenience, the buffer grows geometrically so appending is amortized O(1)
 static String appendString(String s, const char *new) {
 	if (new != NULL) {
 		int len = strlen(new);
-		s->str = realloc(s->str, s->len + len + 1);
-		s->str[s->len] = 0;
-		strcat(s->str, new);
+		if (s->len + len + 1 > s->capacity) {
+			s->capacity = s->capacity * 2 > s->len + len + 1 ? s->capacity * 2 : s->len + len + 1 + 256;
+			s->str = realloc(s->str, s->capacity);
+		}
+		memcpy(s->str + s->len, new, len + 1);
 		s->len += len;
 	}
 	return s;
@@ -147,14 +163,8 @@ static String appendString(String s, const char *new) {
 
 // Returns the same string just for convenience, frees the passed string
 static String appendStringAndFree(String s, const char *new) {
-	if (new != NULL) {
-		int len = strlen(new);
-		s->str = realloc(s->str, s->len + len + 1);
-		s->str[s->len] = 0;
-		strcat(s->str, new);
-		s->len += len;
-		free((void*)new);
-	}
+	appendString(s, new);
+	free((void*)new);
 	return s;
 }
 
@@ -171,6 +181,470 @@ static const char *popString(String s) {
 	return ss;
 }
 
+// ------------------------------- Asset files ------------------------------- //
+// Every file the compiled load code loads, in the order it loads them
+static char **gAssetPaths = NULL;
+static int gAssetPathCount = 0;
+static int gAssetPathSize = 0;
+
+static void addAssetPath(const char *basePath, const char *filename) {
+	if (gAssetPathCount == gAssetPathSize) {
+		gAssetPathSize = gAssetPathSize == 0 ? 64 : gAssetPathSize * 2;
+		gAssetPaths = realloc(gAssetPaths, sizeof(char*) * gAssetPathSize);
+	}
+	char *path = malloc(strlen(basePath) + strlen(filename) + 1);
+	strcpy(path, basePath);
+	strcat(path, filename);
+	gAssetPaths[gAssetPathCount++] = path;
+}
+
+// ------------------------------- Manifest ------------------------------- //
+/*
+ * The manifest is what vksk_RuntimeAssetsLoadManifest loads the assets from, it is a list of records each of which is
+ *  + 1 byte ASSET_TYPE_*
+ *  + 1 byte parameter count followed by that many doubles
+ *  + the file to load and its key in the asset map ("" for none), each a 4 byte length, the string, and a 0
+ * Every record but ASSET_TYPE_END is one element in its directory's list. ASSET_TYPE_DIRECTORY starts the list of a
+ * sub-directory which runs until the matching ASSET_TYPE_END and the last ASSET_TYPE_END ends the root directory.
+ * The file of an ASSET_TYPE_DIRECTORY is the directory itself, so it can be preloaded by name.
+ * Numbers are native endian since the manifest never leaves the machine that compiled it.
+ */
+#define ASSET_TYPE_END 0
+#define ASSET_TYPE_DIRECTORY 1
+#define ASSET_TYPE_TEXTURE 2      // Nothing, or where it is in the atlas if atlasTextures is on (see ATLAS_PARAM_*)
+#define ASSET_TYPE_SPRITE 3      // texture slot, x, y, w, h, delay, frames, origin x, origin y
+#define ASSET_TYPE_AUDIO 4
+#define ASSET_TYPE_TEXT 5        // File.read
+#define ASSET_TYPE_FONT 6        // size, aa, unicode start, unicode end
+#define ASSET_TYPE_BITMAP_FONT 7 // unicode start, unicode end, w, h
+#define ASSET_TYPE_BUFFER 8      // Buffer.open
+#define ASSET_MAX_PARAMS 11
+
+// Parameters of a texture in the atlas, the page is -1 if it was left out of the atlas
+#define ATLAS_PARAM_PAGE 0
+#define ATLAS_PARAM_PAGE_W 1
+#define ATLAS_PARAM_PAGE_H 2
+#define ATLAS_PARAM_X 3      // Where what was kept is in the page
+#define ATLAS_PARAM_Y 4
+#define ATLAS_PARAM_TRIM_X 5 // What was kept of the original image after trimming transparent borders
+#define ATLAS_PARAM_TRIM_Y 6
+#define ATLAS_PARAM_TRIM_W 7
+#define ATLAS_PARAM_TRIM_H 8
+#define ATLAS_PARAM_W 9      // Size of the original image
+#define ATLAS_PARAM_H 10
+#define ATLAS_PARAM_COUNT 11
+
+static uint8_t *gAssetManifest = NULL;
+static int gAssetManifestSize = 0;
+static int gAssetManifestCapacity = 0;
+static int gAssetManifestAssets = 0; // Assets in the manifest so far, which is also the index of the next one
+static int gAtlasPageCount = 0; // Atlas pages the manifest's textures were packed into, see packAtlas
+static char gAssetRoot[STRING_BUFFER_SIZE];
+
+static void writeManifest(const void *data, int size) {
+	if (gAssetManifestSize + size > gAssetManifestCapacity) {
+		gAssetManifestCapacity = gAssetManifestCapacity * 2 > gAssetManifestSize + size ? gAssetManifestCapacity * 2 : gAssetManifestSize + size + 1024;
+		gAssetManifest = realloc(gAssetManifest, gAssetManifestCapacity);
+	}
+	memcpy(gAssetManifest + gAssetManifestSize, data, size);
+	gAssetManifestSize += size;
+}
+
+static void writeManifestString(const char *string) {
+	uint32_t length = strlen(string);
+	writeManifest(&length, 4);
+	writeManifest(string, length + 1);
+}
+
+static void addManifestRecord(int type, const char *path, const char *key, const double *params, int paramCount) {
+	uint8_t header[2] = {type, paramCount};
+	writeManifest(header, 2);
+	if (paramCount > 0)
+		writeManifest(params, sizeof(double) * paramCount);
+	writeManifestString(path);
+	writeManifestString(key);
+}
+
+typedef struct ManifestRecord {
+	int type;
+	int paramCount;
+	double params[ASSET_MAX_PARAMS];
+	const char *path;
+	const char *key;
+} ManifestRecord;
+
+static bool readManifestString(const uint8_t **pos, const uint8_t *end, const char **string) {
+	uint32_t length;
+	if (end - *pos < 4)
+		return false;
+	memcpy(&length, *pos, 4);
+	if ((uint64_t)(end - *pos) < (uint64_t)length + 5 || (*pos)[4 + length] != 0)
+		return false;
+	*string = (const char*)*pos + 4;
+	*pos += length + 5;
+	return true;
+}
+
+// Reads the record at pos and moves pos past it, returns false if the manifest is cut off
+static bool readManifestRecord(const uint8_t **pos, const uint8_t *end, ManifestRecord *record) {
+	if (end - *pos < 2)
+		return false;
+	record->type = (*pos)[0];
+	record->paramCount = (*pos)[1];
+	*pos += 2;
+	if (record->paramCount > ASSET_MAX_PARAMS || end - *pos < (long)sizeof(double) * record->paramCount)
+		return false;
+	memset(record->params, 0, sizeof(record->params));
+	memcpy(record->params, *pos, sizeof(double) * record->paramCount);
+	*pos += sizeof(double) * record->paramCount;
+	return readManifestString(pos, end, &record->path) && readManifestString(pos, end, &record->key);
+}
+
+// Returns true if every record in the manifest is whole and every directory in it ends
+static bool manifestIsValid() {
+	const uint8_t *pos = gAssetManifest;
+	const uint8_t *end = gAssetManifest + gAssetManifestSize;
+	ManifestRecord record;
+	int depth = 0;
+	while (readManifestRecord(&pos, end, &record)) {
+		if (record.type == ASSET_TYPE_DIRECTORY)
+			depth++;
+		else if (record.type == ASSET_TYPE_END && depth-- == 0)
+			return pos == end;
+	}
+	return false;
+}
+
+// ------------------------------- Cache ------------------------------- //
+/*
+ * The compiled assets file is cached in ASSET_CACHE_FILE along with everything it was compiled from so the next
+ * launch can skip compiling it if none of that changed. The cache is a list of lines
+ *  + ASSET_CACHE_MAGIC
+ *  + "root\t<root directory>"
+ *  + "pak\t<vksk_PakHashDirectory of the root directory, or none if there is no pak>"
+ *  + "atlas\t<1 if atlasTextures was on, 0 otherwise>"
+ *  + "atlasPages\t<how many atlas pages the manifest's textures are on>"
+ *  + "dep\t<stamp>\t<path>" for every directory and json file on disk the compiler looked at
+ *  + "file\t<path>" for every file the compiled code loads (see vksk_PrefetchAssetFiles)
+ *  + "manifest\t<size>" followed by that many bytes of the binary manifest and a new line
+ *  + "source" followed by the compiled file itself until the end
+ * Stamps are "<modification time>:<size>", or "-" if the file didn't exist.
+ */
+#define ASSET_CACHE_FILE "Assets.cache"
+#define ASSET_CACHE_MAGIC "ASTRO ASSET CACHE 5"
+
+extern VKSK_EngineConfig gEngineConfig;
+static String gAssetDependencies = NULL; // "dep" lines for the cache, NULL while not recording them
+
+static void getFileStamp(const char *path, char *buffer, int size) {
+	struct stat stbuf;
+	if (stat(path, &stbuf) == 0)
+		snprintf(buffer, size, "%lld:%lld", (long long)stbuf.st_mtime, (long long)stbuf.st_size);
+	else
+		snprintf(buffer, size, "-");
+}
+
+static void getPakStamp(const char *rootDir, char *buffer, int size) {
+	if (gGamePak != NULL)
+		snprintf(buffer, size, "%016llx", (unsigned long long)vksk_PakHashDirectory(gGamePak, rootDir));
+	else
+		snprintf(buffer, size, "none");
+}
+
+static void addAssetDependency(const char *path) {
+	if (gAssetDependencies == NULL)
+		return;
+	char line[STRING_BUFFER_SIZE + 80];
+	char stamp[64];
+	getFileStamp(path, stamp, 64);
+	snprintf(line, STRING_BUFFER_SIZE + 80, "dep\t%s\t%s\n", stamp, path);
+	appendString(gAssetDependencies, line);
+}
+
+// Returns the cached assets file if nothing it was compiled from changed, the asset paths and manifest are loaded
+// from it too
+static const char *loadAssetCache(const char *rootDir) {
+	int size;
+	char *cache = (void*)loadFileRaw(ASSET_CACHE_FILE, &size);
+	if (cache == NULL)
+		return NULL;
+	cache = realloc(cache, size + 1);
+	cache[size] = 0;
+	char stamp[64];
+	char *line = cache;
+	char *source = NULL;
+	bool valid = true;
+	bool checkedRoot = false;
+	bool checkedPak = false;
+	bool checkedAtlas = false;
+	bool checkedAtlasPages = false;
+	bool checkedManifest = false;
+	bool first = true;
+	while (valid && source == NULL) {
+		char *next = strchr(line, '\n');
+		if (next == NULL) {
+			valid = false;
+			break;
+		}
+		*next = 0;
+		if (first) {
+			valid = strcmp(line, ASSET_CACHE_MAGIC) == 0;
+			first = false;
+		} else if (strncmp(line, "root\t", 5) == 0) {
+			valid = strcmp(line + 5, rootDir) == 0;
+			checkedRoot = true;
+		} else if (strncmp(line, "pak\t", 4) == 0) {
+			getPakStamp(rootDir, stamp, 64);
+			valid = strcmp(line + 4, stamp) == 0;
+			checkedPak = true;
+		} else if (strncmp(line, "atlas\t", 6) == 0) {
+			valid = atoi(line + 6) == gEngineConfig.atlasTextures;
+			checkedAtlas = true;
+		} else if (strncmp(line, "atlasPages\t", 11) == 0) {
+			gAtlasPageCount = atoi(line + 11);
+			checkedAtlasPages = gAtlasPageCount >= 0;
+		} else if (strncmp(line, "dep\t", 4) == 0) {
+			char *path = strchr(line + 4, '\t');
+			if (path != NULL) {
+				*path = 0;
+				getFileStamp(path + 1, stamp, 64);
+				valid = strcmp(line + 4, stamp) == 0;
+			} else {
+				valid = false;
+			}
+		} else if (strncmp(line, "file\t", 5) == 0) {
+			addAssetPath("", line + 5);
+		} else if (strncmp(line, "manifest\t", 9) == 0) {
+			long manifestSize = strtol(line + 9, NULL, 10);
+			if (manifestSize > 0 && manifestSize < (cache + size) - next - 1) {
+				writeManifest(next + 1, manifestSize);
+				next += manifestSize + 1;
+				checkedManifest = manifestIsValid();
+			} else {
+				valid = false;
+			}
+		} else if (strcmp(line, "source") == 0) {
+			source = next + 1;
+		} else {
+			valid = false;
+		}
+		line = next + 1;
+	}
+
+	if (!valid || !checkedRoot || !checkedPak || !checkedAtlas || !checkedAtlasPages || !checkedManifest) {
+		for (int i = 0; i < gAssetPathCount; i++)
+			free(gAssetPaths[i]);
+		gAssetPathCount = 0;
+		gAssetManifestSize = 0;
+		gAtlasPageCount = 0;
+		free(cache);
+		return NULL;
+	}
+	memmove(cache, source, strlen(source) + 1);
+	return cache;
+}
+
+static void saveAssetCache(const char *rootDir, const char *source) {
+	FILE *f = fopen(ASSET_CACHE_FILE, "wb");
+	if (f == NULL)
+		return;
+	char stamp[64];
+	getPakStamp(rootDir, stamp, 64);
+	fprintf(f, "%s\nroot\t%s\npak\t%s\natlas\t%i\natlasPages\t%i\n", ASSET_CACHE_MAGIC, rootDir, stamp, gEngineConfig.atlasTextures, gAtlasPageCount);
+	if (gAssetDependencies->str != NULL)
+		fputs(gAssetDependencies->str, f);
+	for (int i = 0; i < gAssetPathCount; i++)
+		fprintf(f, "file\t%s\n", gAssetPaths[i]);
+	fprintf(f, "manifest\t%i\n", gAssetManifestSize);
+	fwrite(gAssetManifest, 1, gAssetManifestSize, f);
+	fprintf(f, "\nsource\n");
+	fputs(source, f);
+	fclose(f);
+}
+
+// ------------------------------- Atlas ------------------------------- //
+/*
+ * With atlasTextures on, every texture small enough gets its transparent borders trimmed off and is packed into a
+ * few big atlas pages so drawing them doesn't have to keep switching textures. Where each one went is written into
+ * the parameters of its manifest record (see ATLAS_PARAM_*) which are filled in once every texture is known, and
+ * the pages themselves are put together from the images when they are loaded.
+ */
+#define ATLAS_PAGE_SIZE 2048
+#define ATLAS_MAX_IMAGE_SIZE 512 // Anything bigger than this in either direction gets its own texture
+#define ATLAS_PADDING 2          // Empty pixels between images so filtering doesn't bleed one into another
+
+typedef struct AtlasImage {
+	char *path;
+	int params; // Where its parameters are in the manifest
+	int w, h;
+	int trimX, trimY, trimW, trimH;
+	int page, x, y;
+} AtlasImage;
+
+typedef struct AtlasShelf {
+	int page;
+	int y, h;
+	int used; // How far along the page the shelf is filled
+} AtlasShelf;
+
+static AtlasImage *gAtlasImages = NULL;
+static int gAtlasImageCount = 0;
+
+// Adds a texture that was just added to the manifest with ATLAS_PARAM_COUNT parameters to the atlas
+static void addAtlasImage(const char *path, int params) {
+	gAtlasImages = realloc(gAtlasImages, sizeof(AtlasImage) * (gAtlasImageCount + 1));
+	AtlasImage *image = &gAtlasImages[gAtlasImageCount++];
+	memset(image, 0, sizeof(AtlasImage));
+	image->path = malloc(strlen(path) + 1);
+	strcpy(image->path, path);
+	image->params = params;
+	image->page = -1;
+}
+
+// Finds the smallest rectangle that has every pixel that isn't fully transparent
+static void trimAtlasImage(AtlasImage *image, const uint8_t *pixels) {
+	int left = image->w, top = image->h, right = -1, bottom = -1;
+	for (int y = 0; y < image->h; y++) {
+		const uint8_t *row = pixels + ((size_t)y * image->w * 4);
+		for (int x = 0; x < image->w; x++) {
+			if (row[x * 4 + 3] != 0) {
+				if (x < left) left = x;
+				if (x > right) right = x;
+				if (y < top) top = y;
+				bottom = y;
+			}
+		}
+	}
+
+	// Images that are entirely transparent keep a single pixel so they still have somewhere to be
+	if (right == -1) {
+		left = top = right = bottom = 0;
+	}
+	image->trimX = left;
+	image->trimY = top;
+	image->trimW = right - left + 1;
+	image->trimH = bottom - top + 1;
+}
+
+static int compareAtlasImages(const void *left, const void *right) {
+	const AtlasImage *l = &gAtlasImages[*(const int*)left];
+	const AtlasImage *r = &gAtlasImages[*(const int*)right];
+	if (l->trimH != r->trimH)
+		return r->trimH - l->trimH;
+	return r->trimW - l->trimW;
+}
+
+// Trims every image added with addAtlasImage and packs them into pages tallest first, each page being shelves of
+// images as tall as the first one put on it, then writes where they went into the manifest
+static void packAtlas() {
+	if (gAtlasImageCount == 0)
+		return;
+
+	// Images are decoded to find their size and what to trim, which is the slow part so it happens on every core
+	const char **paths = malloc(sizeof(char*) * gAtlasImageCount);
+	uint64_t *types = malloc(sizeof(uint64_t) * gAtlasImageCount);
+	int *order = malloc(sizeof(int) * gAtlasImageCount);
+	int count = 0;
+	for (int i = 0; i < gAtlasImageCount; i++) {
+		paths[i] = gAtlasImages[i].path;
+		types[i] = FOREIGN_TEXTURE;
+	}
+	int batchSize = vksk_DecodeBatchSize();
+	for (int start = 0; start < gAtlasImageCount; start += batchSize) {
+		int end = start + batchSize < gAtlasImageCount ? start + batchSize : gAtlasImageCount;
+		vksk_DecodeFiles(paths + start, types + start, end - start);
+		for (int i = start; i < end; i++) {
+			AtlasImage *image = &gAtlasImages[i];
+			uint8_t *pixels = vksk_TakeDecodedTexture(image->path, &image->w, &image->h, NULL);
+			if (pixels == NULL)
+				continue;
+			if (image->w <= ATLAS_MAX_IMAGE_SIZE && image->h <= ATLAS_MAX_IMAGE_SIZE) {
+				trimAtlasImage(image, pixels);
+				order[count++] = i;
+			}
+			stbi_image_free(pixels);
+		}
+		vksk_DropDecodedFiles();
+	}
+	qsort(order, count, sizeof(int), compareAtlasImages);
+
+	AtlasShelf *shelves = NULL;
+	int shelfCount = 0;
+	int pageCount = 0;
+	int pageBottom = 0; // Where the next shelf goes on the last page
+	for (int i = 0; i < count; i++) {
+		AtlasImage *image = &gAtlasImages[order[i]];
+		int w = image->trimW + ATLAS_PADDING;
+		int h = image->trimH + ATLAS_PADDING;
+		AtlasShelf *shelf = NULL;
+		for (int j = 0; j < shelfCount && shelf == NULL; j++)
+			if (shelves[j].h >= h && ATLAS_PAGE_SIZE - shelves[j].used >= w)
+				shelf = &shelves[j];
+		if (shelf == NULL) {
+			if (pageCount == 0 || ATLAS_PAGE_SIZE - pageBottom < h) {
+				pageCount++;
+				pageBottom = 0;
+			}
+			shelves = realloc(shelves, sizeof(AtlasShelf) * (shelfCount + 1));
+			shelf = &shelves[shelfCount++];
+			shelf->page = pageCount - 1;
+			shelf->y = pageBottom;
+			shelf->h = h;
+			shelf->used = 0;
+			pageBottom += h;
+		}
+		image->page = shelf->page;
+		image->x = shelf->used;
+		image->y = shelf->y;
+		shelf->used += w;
+	}
+
+	// Pages are only as big as what's on them
+	int *pageSizes = calloc(pageCount * 2 + 1, sizeof(int));
+	for (int i = 0; i < count; i++) {
+		AtlasImage *image = &gAtlasImages[order[i]];
+		if (image->x + image->trimW > pageSizes[image->page * 2])
+			pageSizes[image->page * 2] = image->x + image->trimW;
+		if (image->y + image->trimH > pageSizes[image->page * 2 + 1])
+			pageSizes[image->page * 2 + 1] = image->y + image->trimH;
+	}
+	for (int i = 0; i < gAtlasImageCount; i++) {
+		AtlasImage *image = &gAtlasImages[i];
+		double params[ATLAS_PARAM_COUNT] = {-1};
+		if (image->page != -1) {
+			params[ATLAS_PARAM_PAGE] = image->page;
+			params[ATLAS_PARAM_PAGE_W] = pageSizes[image->page * 2];
+			params[ATLAS_PARAM_PAGE_H] = pageSizes[image->page * 2 + 1];
+			params[ATLAS_PARAM_X] = image->x;
+			params[ATLAS_PARAM_Y] = image->y;
+			params[ATLAS_PARAM_TRIM_X] = image->trimX;
+			params[ATLAS_PARAM_TRIM_Y] = image->trimY;
+			params[ATLAS_PARAM_TRIM_W] = image->trimW;
+			params[ATLAS_PARAM_TRIM_H] = image->trimH;
+			params[ATLAS_PARAM_W] = image->w;
+			params[ATLAS_PARAM_H] = image->h;
+		}
+		memcpy(gAssetManifest + image->params, params, sizeof(params));
+	}
+	gAtlasPageCount = pageCount;
+	if (pageCount > 0)
+		vksk_Log("Packed %i textures into %i atlas pages", count, pageCount);
+
+	free(pageSizes);
+	free(shelves);
+	free(order);
+	free(types);
+	free(paths);
+}
+
+static void freeAtlas() {
+	for (int i = 0; i < gAtlasImageCount; i++)
+		free(gAtlasImages[i].path);
+	free(gAtlasImages);
+	gAtlasImages = NULL;
+	gAtlasImageCount = 0;
+}
+
 // ------------------------------- JSON Parsers ------------------------------- //
 typedef struct SpriteData {
 	const char *filename;
@@ -221,6 +695,7 @@ typedef struct DirectoryJSON {
 	cJSON *bitmapFontsPointer; // json for the bitmap fonts list
 	cJSON *buffersPointer; // json for the buffers list
 	cJSON *stringsPointer; // json for the strings list
+	bool atlas; // false if "atlas" is false, keeping the directory's textures out of the atlas
 } *DirectoryJSON;
 
 // Either copies the asset's name into the buffer or forms a name from the filename using
@@ -270,6 +745,7 @@ static bool jsonFindAsepriteData(const char *tex_filename, SpriteData *sprite) {
 		strncpy(jsonFilename, tex_filename, ext - tex_filename);
 		strcpy(jsonFilename + (ext - tex_filename), ".json");
 		jsonFilename[(ext - tex_filename) + 5] = 0;
+		addAssetDependency(jsonFilename);
 		const char *file = loadFile(jsonFilename);
 		cJSON *json = cJSON_Parse(file);
 		free((void*)file);
@@ -328,6 +804,7 @@ static DirectoryJSON openDirectoryJSON(const char *directory) {
 	char assetFile[STRING_BUFFER_SIZE];
 	snprintf(assetFile, STRING_BUFFER_SIZE, "%sassets.json", directory);
 	DirectoryJSON dir = NULL;
+	addAssetDependency(assetFile);
 
 	if (_vk2dFileExists(assetFile)) {
 		dir = malloc(sizeof(struct DirectoryJSON));
@@ -342,6 +819,7 @@ static DirectoryJSON openDirectoryJSON(const char *directory) {
 			dir->bitmapFontsPointer = cJSON_GetObjectItem(json, "bitmap_fonts");
 			dir->buffersPointer = cJSON_GetObjectItem(json, "buffers");
 			dir->stringsPointer = cJSON_GetObjectItem(json, "strings");
+			dir->atlas = GET_JSON_BOOL(cJSON_GetObjectItem(json, "atlas"), true);
 			dir->spritesPointer = dir->spritesPointer != NULL && cJSON_IsArray(dir->spritesPointer) ? dir->spritesPointer->child : NULL;
 			dir->fontsPointer = dir->fontsPointer != NULL && cJSON_IsArray(dir->fontsPointer) ? dir->fontsPointer->child : NULL;
 			dir->bitmapFontsPointer = dir->bitmapFontsPointer != NULL && cJSON_IsArray(dir->bitmapFontsPointer) ? dir->bitmapFontsPointer->child : NULL;
@@ -357,6 +835,11 @@ static DirectoryJSON openDirectoryJSON(const char *directory) {
 	return dir;
 }
 
+// Returns true if textures in the directory should be packed into the atlas
+static bool directoryJSONUsesAtlas(DirectoryJSON json) {
+	return gEngineConfig.atlasTextures && (json == NULL || json->atlas);
+}
+
 static void closeDirectoryJSON(DirectoryJSON json) {
 	if (json != NULL)
 		cJSON_Delete(json->root);
@@ -538,166 +1021,128 @@ static const char *folderToClass(const char *folder, char *buffer, int bufferSiz
 
 // ------------------------------- Asset compiler ------------------------------- //
 
-static void _vksk_CompileAssetFromSpriteData(const char *basePath, String getter, String method, SpriteData *sprite) {
-	char nameBuffer[STRING_BUFFER_SIZE];
+// Wren class for one directory, every asset in it gets a slot in the directory's list of loaded assets
+typedef struct AssetClass {
+	String getters;     // Getters for the assets and sub-directories
+	String constructor; // Constructor that wraps the sub-directory lists in their classes
+	char **names;       // Getter name for each slot, NULL for slots without one
+	int slots;
+} *AssetClass;
+
+static AssetClass newAssetClass(const char *header, const char *constructorHeader) {
+	AssetClass class = malloc(sizeof(struct AssetClass));
+	class->getters = appendString(newString(), header);
+	class->constructor = appendString(newString(), constructorHeader);
+	class->names = NULL;
+	class->slots = 0;
+	return class;
+}
+
+// Gives the next slot to an asset, returning it
+static int addAssetSlot(AssetClass class, const char *name) {
+	if ((class->slots & (class->slots - 1)) == 0)
+		class->names = realloc(class->names, sizeof(char*) * (class->slots == 0 ? 1 : class->slots * 2));
+	class->names[class->slots] = NULL;
+	if (name != NULL) {
+		class->names[class->slots] = malloc(strlen(name) + 1);
+		strcpy(class->names[class->slots], name);
+	}
+	return class->slots++;
+}
+
+// Returns the slot of the asset with a given getter name or -1 if there isn't one
+static int findAssetSlot(AssetClass class, const char *name) {
+	for (int i = 0; i < class->slots; i++)
+		if (class->names[i] != NULL && strcmp(class->names[i], name) == 0)
+			return i;
+	return -1;
+}
+
+// Adds an asset to both the manifest and the class, returning its slot. Getters load the asset themselves if it
+// hasn't been loaded yet.
+static int addAsset(AssetClass class, int type, const char *prefix, const char *name, const char *path, const char *key, const double *params, int paramCount) {
 	char output[STRING_BUFFER_SIZE];
+	addManifestRecord(type, path, key, params, paramCount);
+	snprintf(output, STRING_BUFFER_SIZE, "%s%s", prefix, name);
+	int slot = addAssetSlot(class, output);
+	snprintf(output, STRING_BUFFER_SIZE, "\t%s%s { _a[%i] || AssetsImpl.load_asset(%i) }\n", prefix, name, slot, gAssetManifestAssets++);
+	appendString(class->getters, output);
+	return slot;
+}
+
+// Frees the class returning its code
+static String finishAssetClass(AssetClass class, const char *footer) {
+	String out = class->getters;
+	appendStringAndFree(out, popString(appendString(class->constructor, "\t}\n")));
+	appendString(out, footer);
+	for (int i = 0; i < class->slots; i++)
+		free(class->names[i]);
+	free(class->names);
+	free(class);
+	return out;
+}
+
+static void _vksk_CompileAssetFromSpriteData(const char *basePath, AssetClass class, SpriteData *sprite) {
+	char nameBuffer[STRING_BUFFER_SIZE];
+	char textureName[STRING_BUFFER_SIZE];
 	char fileBuffer[STRING_BUFFER_SIZE];
 	char *finalPath = strrchr(sprite->filename, '/');
 	if (finalPath != NULL)
 		strncpy(fileBuffer, finalPath + 1, STRING_BUFFER_SIZE);
 	else
 		strncpy(fileBuffer, sprite->filename, STRING_BUFFER_SIZE);
+	fileBuffer[STRING_BUFFER_SIZE - 1] = 0;
 	char *ext = strrchr(fileBuffer, '.');
 	if (ext != NULL) {
 		*ext = 0;
 	}
 
+	// Sprites are made from a texture already loaded in the same directory
 	jsonGetAssetName(sprite->filename, sprite->name, nameBuffer, STRING_BUFFER_SIZE);
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\t\t_spr_%s = Sprite.from(_tex_%s, %.2f, %.2f, %.2f, %.2f, %.2f, %i)\n\t\t_spr_%s.origin_x = %.2f\n\t\t_spr_%s.origin_y = %.2f\n",
-			nameBuffer,
-			fileBuffer,
-			sprite->x,
-			sprite->y,
-			sprite->w,
-			sprite->h,
-			sprite->delay,
-			(int)sprite->frames,
-			nameBuffer,
-			sprite->originX,
-			nameBuffer,
-			sprite->originY
-	);
-	appendString(method, output);
-
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\tspr_%s { _spr_%s }\n",
-			nameBuffer,
-			nameBuffer
-	);
-	appendString(getter, output);
-}
-
-static void _vksk_CompileAssetFromBitmapFontData(const char *basePath, String getter, String method, BitmapFontData *bmp) {
-	char output[STRING_BUFFER_SIZE];
+	snprintf(textureName, STRING_BUFFER_SIZE, "tex_%s", fileBuffer);
+	int texture = findAssetSlot(class, textureName);
+	if (texture == -1) {
+		vksk_Log("Sprite \"%s\" in \"%s\" has no texture \"%s\" to load from", nameBuffer, basePath, sprite->filename);
+		return;
+	}
 
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\t\t_fnt_%s = BitmapFont.new(\"%s%s\", %i, %i, %.2f, %.2f)\n",
-			bmp->name,
-			basePath,
-			bmp->filename,
-			(int)bmp->ustart,
-			(int)bmp->uend,
-			bmp->w,
-			bmp->h
-	);
-	appendString(method, output);
-
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\tfnt_%s { _fnt_%s }\n",
-			bmp->name,
-			bmp->name
-	);
-	appendString(getter, output);
-}
-
-static void _vksk_CompileAssetFromTrueTypeData(const char *basePath, String getter, String method, TrueTypeFontData *ttf) {
-	char output[STRING_BUFFER_SIZE];
+	double params[] = {texture, sprite->x, sprite->y, sprite->w, sprite->h, sprite->delay, (int)sprite->frames, sprite->originX, sprite->originY};
+	addAsset(class, ASSET_TYPE_SPRITE, "spr_", nameBuffer, "", "", params, 9);
+}
 
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\t\t_fnt_%s = Font.open(\"%s%s\", %.2f, %s, %i, %i)\n\t\tasset_map[\"%s%s\"] = _fnt_%s\n",
-			ttf->name,
-			basePath,
-			ttf->filename,
-			ttf->size,
-			ttf->aa ? "true" : "false",
-			ttf->ustart,
-			ttf->uend,
-			basePath,
-			ttf->filename,
-			ttf->name
-	);
-	appendString(method, output);
-
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\tfnt_%s { _fnt_%s }\n",
-			ttf->name,
-			ttf->name
-	);
-	appendString(getter, output);
-}
-
-static void _vksk_CompileAssetFromBufferData(const char *basePath, String getter, String method, BufferData *buffer) {
-	char output[STRING_BUFFER_SIZE];
+static void _vksk_CompileAssetFromBitmapFontData(const char *basePath, AssetClass class, BitmapFontData *bmp) {
+	char path[STRING_BUFFER_SIZE];
+	snprintf(path, STRING_BUFFER_SIZE, "%s%s", basePath, bmp->filename);
+	double params[] = {bmp->ustart, bmp->uend, bmp->w, bmp->h};
+	addAsset(class, ASSET_TYPE_BITMAP_FONT, "fnt_", bmp->name, path, "", params, 4);
+	addAssetPath(basePath, bmp->filename);
+}
 
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\t\t_buf_%s = Buffer.open(\"%s%s\")\n\t\tasset_map[\"%s%s\"] = _buf_%s\n",
-			buffer->name,
-			basePath,
-			buffer->filename,
-			basePath,
-			buffer->filename,
-			buffer->name
-	);
-	appendString(method, output);
-
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\tbuf_%s { _buf_%s }\n",
-			buffer->name,
-			buffer->name
-	);
-	appendString(getter, output);
-}
-
-static void _vksk_CompileAssetFromStringData(const char *basePath, String getter, String method, StringData *text) {
-	char output[STRING_BUFFER_SIZE];
+static void _vksk_CompileAssetFromTrueTypeData(const char *basePath, AssetClass class, TrueTypeFontData *ttf) {
+	char path[STRING_BUFFER_SIZE];
+	snprintf(path, STRING_BUFFER_SIZE, "%s%s", basePath, ttf->filename);
+	double params[] = {ttf->size, ttf->aa, ttf->ustart, ttf->uend};
+	addAsset(class, ASSET_TYPE_FONT, "fnt_", ttf->name, path, path, params, 4);
+	addAssetPath(basePath, ttf->filename);
+}
+
+static void _vksk_CompileAssetFromBufferData(const char *basePath, AssetClass class, BufferData *buffer) {
+	char path[STRING_BUFFER_SIZE];
+	snprintf(path, STRING_BUFFER_SIZE, "%s%s", basePath, buffer->filename);
+	addAsset(class, ASSET_TYPE_BUFFER, "buf_", buffer->name, path, path, NULL, 0);
+}
+
+static void _vksk_CompileAssetFromStringData(const char *basePath, AssetClass class, StringData *text) {
+	char path[STRING_BUFFER_SIZE];
+	snprintf(path, STRING_BUFFER_SIZE, "%s%s", basePath, text->filename);
+	addAsset(class, ASSET_TYPE_BUFFER, "txt_", text->name, path, path, NULL, 0);
+}
 
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\t\t_txt_%s = Buffer.open(\"%s%s\")\n\t\tasset_map[\"%s%s\"] = _txt_%s\n",
-			text->name,
-			basePath,
-			text->filename,
-			basePath,
-			text->filename,
-			text->name
-	);
-	appendString(method, output);
-
-	snprintf(
-			output,
-			STRING_BUFFER_SIZE,
-			"\ttxt_%s { _txt_%s }\n",
-			text->name,
-			text->name
-	);
-	appendString(getter, output);
-}
-
-
-static void _vksk_CompileAssetFromFilename(String getter, String method, const char *directory, const char *path, const char *filename) {
+
+static void _vksk_CompileAssetFromFilename(AssetClass class, const char *directory, const char *path, const char *filename, bool atlas) {
 	const char *extension = strrchr(filename, '.');
 	char nameBuffer[STRING_BUFFER_SIZE];
-	char output[STRING_BUFFER_SIZE];
 	const char *pathNoRoot;
-	const char *getterPrefix = NULL;
 
 	if (extension != NULL) {
 		pathNoRoot = strchr(path, '/') + 1;
@@ -707,77 +1152,79 @@ static void _vksk_CompileAssetFromFilename(String getter, String method, const c
 			jsonGetAssetName(filename, NULL, nameBuffer, STRING_BUFFER_SIZE);
 			if (!variableNameIsValid(nameBuffer))
 				return;
-			snprintf(
-					output,
-					STRING_BUFFER_SIZE,
-					"\t\t_tex_%s = Texture.new(\"%s\")\n\t\tasset_map[\"%s\"] = _tex_%s\n",
-					nameBuffer,
-					path,
-					pathNoRoot,
-					nameBuffer
-			);
-			appendString(method, output);
+			if (atlas) {
+				// Where it goes in the atlas is filled in by packAtlas, and changing the image changes that
+				double params[ATLAS_PARAM_COUNT] = {-1};
+				addAtlasImage(path, gAssetManifestSize + 2);
+				addAsset(class, ASSET_TYPE_TEXTURE, "tex_", nameBuffer, path, pathNoRoot, params, ATLAS_PARAM_COUNT);
+				addAssetDependency(path);
+			} else {
+				addAsset(class, ASSET_TYPE_TEXTURE, "tex_", nameBuffer, path, pathNoRoot, NULL, 0);
+			}
+			addAssetPath("", path);
 
 			// Check for a sprite json
 			SpriteData sprite;
 			if (jsonFindAsepriteData(path, &sprite)) {
-				_vksk_CompileAssetFromSpriteData(directory, getter, method, &sprite);
+				_vksk_CompileAssetFromSpriteData(directory, class, &sprite);
 			}
-			getterPrefix = "tex_";
 		} else if (strcmp(extension, ".ogg") == 0 || strcmp(extension, ".wav") == 0) {
 			jsonGetAssetName(filename, NULL, nameBuffer, STRING_BUFFER_SIZE);
 			if (!variableNameIsValid(nameBuffer))
 				return;
-			snprintf(
-					output,
-					STRING_BUFFER_SIZE,
-					"\t\t_aud_%s = AudioData.open(\"%s\")\n\t\tasset_map[\"%s\"] = _aud_%s\n",
-					nameBuffer,
-					path,
-					pathNoRoot,
-					nameBuffer
-			);
-			appendString(method, output);
-			getterPrefix = "aud_";
+			addAsset(class, ASSET_TYPE_AUDIO, "aud_", nameBuffer, path, pathNoRoot, NULL, 0);
+			addAssetPath("", path);
 		} else if (strcmp(extension, ".txt") == 0) {
 			jsonGetAssetName(filename, NULL, nameBuffer, STRING_BUFFER_SIZE);
 			if (!variableNameIsValid(nameBuffer))
 				return;
-			snprintf(
-					output,
-					STRING_BUFFER_SIZE,
-					"\t\t_txt_%s = File.read(\"%s\")\n\t\tasset_map[\"%s\"] = _txt_%s\n",
-					nameBuffer,
-					path,
-					pathNoRoot,
-					nameBuffer
-			);
-			appendString(method, output);
-			getterPrefix = "txt_";
+			addAsset(class, ASSET_TYPE_TEXT, "txt_", nameBuffer, path, pathNoRoot, NULL, 0);
 		}
+	}
+}
 
-		if (getterPrefix != NULL) {
-			snprintf(
-					output,
-					STRING_BUFFER_SIZE,
-					"\t%s%s { _%s%s }\n",
-					getterPrefix,
-					nameBuffer,
-					getterPrefix,
-					nameBuffer
-			);
-			appendString(getter, output);
-		}
+// Adds a sub-directory's slot and class to its parent, the sub-directory's own assets follow it in the manifest
+static void _vksk_CompileAssetDirectory(AssetClass class, const char *classname, const char *path) {
+	char output[STRING_BUFFER_SIZE];
+	addManifestRecord(ASSET_TYPE_DIRECTORY, path, "", NULL, 0);
+	int slot = addAssetSlot(class, NULL);
+	snprintf(output, STRING_BUFFER_SIZE, "\t\t_%s = C%sImpl.new(a[%i])\n", classname, classname, slot);
+	appendString(class->constructor, output);
+	snprintf(output, STRING_BUFFER_SIZE, "\t%s { _%s }\n", classname, classname);
+	appendString(class->getters, output);
+}
+
+// Assets from the directory's assets.json, loaded after its files
+static void _vksk_CompileAssetsFromJSON(const char *directory, AssetClass class, DirectoryJSON json) {
+	SpriteData sprite;
+	while (directoryJSONGetNextSprite(json, &sprite)) {
+		_vksk_CompileAssetFromSpriteData(directory, class, &sprite);
+	}
+	TrueTypeFontData ttf;
+	while (directoryJSONGetNextTrueTypeFont(json, &ttf)) {
+		_vksk_CompileAssetFromTrueTypeData(directory, class, &ttf);
 	}
+	BitmapFontData bmf;
+	while (directoryJSONGetNextBitmapFont(json, &bmf)) {
+		_vksk_CompileAssetFromBitmapFontData(directory, class, &bmf);
+	}
+	BufferData buffer;
+	while (directoryJSONGetNextBuffer(json, &buffer)) {
+		_vksk_CompileAssetFromBufferData(directory, class, &buffer);
+	}
+	StringData text;
+	while (directoryJSONGetNextString(json, &text)) {
+		_vksk_CompileAssetFromStringData(directory, class, &text);
+	}
+	addManifestRecord(ASSET_TYPE_END, "", "", NULL, 0);
 }
 
 // Compiles the root directory, returning the code for that directory's class
-static String _vksk_CompileAssetsFromDirectory(const char *directory, const char *topOfClassString, const char *loadMethodString, const char *footerString) {
+static String _vksk_CompileAssetsFromDirectory(const char *directory, AssetClass class, const char *footerString) {
 	struct dirent *dp;
 	DIR *dfd;
+	addAssetDependency(directory); // Its modification time changes when anything is added to or removed from it
 	DirectoryJSON json = openDirectoryJSON(directory);
-	String topOfClass = appendString(newString(), topOfClassString); // for getters
-	String loadMethod = appendString(newString(), loadMethodString); // for the actual load method
 
 	if ((dfd = opendir(directory)) == NULL) {
 		vksk_Log("Can't access assets directory");
@@ -807,7 +1254,7 @@ static String _vksk_CompileAssetsFromDirectory(const char *directory, const char
 
 		if (!jsonItemInExcludeList(json, filedirnolead)) {
 			if ((stbuf.st_mode & S_IFMT) != S_IFDIR) {
-				_vksk_CompileAssetFromFilename(topOfClass, loadMethod, directory, filedir, filedirnolead);
+				_vksk_CompileAssetFromFilename(class, directory, filedir, filedirnolead, directoryJSONUsesAtlas(json));
 			} else {
 				char classname[STRING_BUFFER_SIZE];
 				folderToClass(filedirnolead, classname, STRING_BUFFER_SIZE);
@@ -816,57 +1263,27 @@ static String _vksk_CompileAssetsFromDirectory(const char *directory, const char
 					continue;
 				}
 
-				// Add the class bit to the loader
+				// Add the class bit to the loader and then prepend this class to the new class
 				char directoryAssetName[STRING_BUFFER_SIZE];
-				snprintf(directoryAssetName, STRING_BUFFER_SIZE, "\t\t_%s = C%sImpl.new(asset_map)\n", classname, classname);
-				appendString(loadMethod, directoryAssetName);
-
-				// Append this class to the new class
+				_vksk_CompileAssetDirectory(class, classname, filedir);
 				snprintf(directoryAssetName, STRING_BUFFER_SIZE, "class C%sImpl {\n", classname);
-				topOfClass = appendStringAndFree(_vksk_CompileAssetsFromDirectory(filedir, directoryAssetName, "\n\tconstruct new(asset_map) {\n", ASSET_DIR_CLASS_FOOTER), popString(topOfClass));
-
-				// Now the getter
-				snprintf(directoryAssetName, STRING_BUFFER_SIZE, "\t%s { _%s }\n", classname, classname);
-				appendString(topOfClass, directoryAssetName);
+				class->getters = appendStringAndFree(_vksk_CompileAssetsFromDirectory(filedir, newAssetClass(directoryAssetName, ASSET_DIR_LOAD_HEADER), ASSET_DIR_CLASS_FOOTER), popString(class->getters));
 			}
 		}
 		dp = readdir(dfd);
 	}
 
-	SpriteData sprite;
-	while (directoryJSONGetNextSprite(json, &sprite)) {
-		_vksk_CompileAssetFromSpriteData(directory, topOfClass, loadMethod, &sprite);
-	}
-	TrueTypeFontData ttf;
-	while (directoryJSONGetNextTrueTypeFont(json, &ttf)) {
-		_vksk_CompileAssetFromTrueTypeData(directory, topOfClass, loadMethod, &ttf);
-	}
-	BitmapFontData bmf;
-	while (directoryJSONGetNextBitmapFont(json, &bmf)) {
-		_vksk_CompileAssetFromBitmapFontData(directory, topOfClass, loadMethod, &bmf);
-	}
-	BufferData buffer;
-	while (directoryJSONGetNextBuffer(json, &buffer)) {
-		_vksk_CompileAssetFromBufferData(directory, topOfClass, loadMethod, &buffer);
-	}
-	StringData text;
-	while (directoryJSONGetNextString(json, &text)) {
-		_vksk_CompileAssetFromStringData(directory, topOfClass, loadMethod, &text);
-	}
-
+	_vksk_CompileAssetsFromJSON(directory, class, json);
 	closedir(dfd);
 	closeDirectoryJSON(json);
 
 	// Build output string
-	appendStringAndFree(topOfClass, popString(appendString(loadMethod, "\t}\n")));
-	return appendString(topOfClass, footerString);
+	return finishAssetClass(class, footerString);
 }
 
 // Basically the same as above but uses pak methods instead of dirent
-static String _vksk_CompileAssetsFromPak(const char *directory, const char *topOfClassString, const char *loadMethodString, const char *footerString) {
+static String _vksk_CompileAssetsFromPak(const char *directory, AssetClass class, const char *footerString) {
 	DirectoryJSON json = openDirectoryJSON(directory);
-	String topOfClass = appendString(newString(), topOfClassString); // for getters
-	String loadMethod = appendString(newString(), loadMethodString); // for the actual load method
 	VKSK_PakDir dir;
 
 	const char *f = vksk_PakBeginLoop(gGamePak, &dir, directory);
@@ -884,7 +1301,7 @@ static String _vksk_CompileAssetsFromPak(const char *directory, const char *topO
 
 		if (!jsonItemInExcludeList(json, filedirnolead)) {
 			if (f[strlen(f) - 1] != '/') {
-				_vksk_CompileAssetFromFilename(topOfClass, loadMethod, directory, filedir, filedirnolead);
+				_vksk_CompileAssetFromFilename(class, directory, filedir, filedirnolead, directoryJSONUsesAtlas(json));
 			} else {
 				char classname[STRING_BUFFER_SIZE];
 				folderToClass(filedirnolead, classname, STRING_BUFFER_SIZE);
@@ -893,64 +1310,529 @@ static String _vksk_CompileAssetsFromPak(const char *directory, const char *topO
 					continue;
 				}
 
-				// Add the class bit to the loader
+				// Add the class bit to the loader and then prepend this class to the new class
 				char directoryAssetName[STRING_BUFFER_SIZE];
-				snprintf(directoryAssetName, STRING_BUFFER_SIZE, "\t\t_%s = C%sImpl.new(asset_map)\n", classname, classname);
-				appendString(loadMethod, directoryAssetName);
-
-				// Append this class to the new class
+				_vksk_CompileAssetDirectory(class, classname, filedir);
 				snprintf(directoryAssetName, STRING_BUFFER_SIZE, "class C%sImpl {\n", classname);
-				topOfClass = appendStringAndFree(_vksk_CompileAssetsFromPak(filedir, directoryAssetName, "\n\tconstruct new(asset_map) {\n", ASSET_DIR_CLASS_FOOTER), popString(topOfClass));
-
-				// Now the getter
-				snprintf(directoryAssetName, STRING_BUFFER_SIZE, "\t%s { _%s }\n", classname, classname);
-				appendString(topOfClass, directoryAssetName);
+				class->getters = appendStringAndFree(_vksk_CompileAssetsFromPak(filedir, newAssetClass(directoryAssetName, ASSET_DIR_LOAD_HEADER), ASSET_DIR_CLASS_FOOTER), popString(class->getters));
 			}
 		}
 		f = vksk_PakNext(&dir);
 	}
 
-	SpriteData sprite;
-	while (directoryJSONGetNextSprite(json, &sprite)) {
-		_vksk_CompileAssetFromSpriteData(directory, topOfClass, loadMethod, &sprite);
-	}
-	TrueTypeFontData ttf;
-	while (directoryJSONGetNextTrueTypeFont(json, &ttf)) {
-		_vksk_CompileAssetFromTrueTypeData(directory, topOfClass, loadMethod, &ttf);
-	}
-	BitmapFontData bmf;
-	while (directoryJSONGetNextBitmapFont(json, &bmf)) {
-		_vksk_CompileAssetFromBitmapFontData(directory, topOfClass, loadMethod, &bmf);
-	}
-	BufferData buffer;
-	while (directoryJSONGetNextBuffer(json, &buffer)) {
-		_vksk_CompileAssetFromBufferData(directory, topOfClass, loadMethod, &buffer);
-	}
-	StringData text;
-	while (directoryJSONGetNextString(json, &text)) {
-		_vksk_CompileAssetFromStringData(directory, topOfClass, loadMethod, &text);
-	}
-
+	_vksk_CompileAssetsFromJSON(directory, class, json);
 	closeDirectoryJSON(json);
 
 	// Build output string
-	appendStringAndFree(topOfClass, popString(appendString(loadMethod, "\t}\n")));
-	return appendString(topOfClass, footerString);
+	return finishAssetClass(class, footerString);
 }
 
 const char *vksk_CompileAssetFile(const char *rootDir) {
 	String assets = NULL;
+	const char *output = NULL;
+	gAssetManifestSize = 0;
+	gAssetManifestAssets = 0;
+	gAtlasPageCount = 0;
+	snprintf(gAssetRoot, STRING_BUFFER_SIZE, "%s", rootDir);
+
+	if (!gEngineConfig.disableAssetCache) {
+		const char *cached = loadAssetCache(rootDir);
+		if (cached != NULL)
+			return cached;
+		gAssetDependencies = newString();
+	}
 
+	// Slot 0 of the root directory is the asset map
+	AssetClass root = newAssetClass(ASSET_ASSET_CLASS_HEADER, ASSET_ASSET_LOAD_HEADER);
+	addAssetSlot(root, NULL);
 	if (gGamePak != NULL)
-		assets = _vksk_CompileAssetsFromPak(rootDir, ASSET_ASSET_CLASS_HEADER, "\n\tload_assets() {\n\t\t_asset_map = {}\n\t\tvar asset_map = _asset_map\n", ASSET_ASSET_CLASS_FOOTER);
+		assets = _vksk_CompileAssetsFromPak(rootDir, root, ASSET_ASSET_CLASS_FOOTER);
 	else
-		assets = _vksk_CompileAssetsFromDirectory(rootDir, ASSET_ASSET_CLASS_HEADER, "\n\tload_assets() {\n\t\t_asset_map = {}\n\t\tvar asset_map = _asset_map\n", ASSET_ASSET_CLASS_FOOTER);
+		assets = _vksk_CompileAssetsFromDirectory(rootDir, root, ASSET_ASSET_CLASS_FOOTER);
 
 	if (assets != NULL) {
+		packAtlas();
 		String string = appendString(newString(), ASSET_FILE_HEADER);
-		appendString(string, popString(assets));
+		appendStringAndFree(string, popString(assets));
 		appendString(string, ASSET_FILE_FOOTER);
-		return popString(string);
+		output = popString(string);
 	}
-	return NULL;
+
+	freeAtlas();
+	if (gAssetDependencies != NULL) {
+		if (output != NULL)
+			saveAssetCache(rootDir, output);
+		freeString(gAssetDependencies);
+		gAssetDependencies = NULL;
+	}
+	return output;
+}
+
+// ------------------------------- Loader ------------------------------- //
+// Every asset in the manifest and where it goes once it is loaded
+typedef struct LoadedAsset {
+	const uint8_t *record; // Where its record is in the manifest
+	const char *key;       // Its key in the asset map, points into the manifest
+	int directory;
+	int slot;
+	int atlasPage;         // Atlas page its texture is on, -1 if it isn't in the atlas
+	bool loaded;           // True once it has been loaded (or failed to load)
+} LoadedAsset;
+
+typedef struct LoadedDirectory {
+	WrenHandle *list;
+	const char *path; // Points into the manifest
+	int *assets;      // Asset in each slot, -1 for the slots that aren't assets
+	int slots;
+} LoadedDirectory;
+
+// Atlas pages are put together from every texture on them the first time one of those textures is loaded
+typedef struct LoadedAtlasPage {
+	_vksk_AtlasPage *page; // NULL until it has been loaded or if it failed to
+	int *assets;
+	int count;
+	bool loaded;
+} LoadedAtlasPage;
+
+static LoadedAsset *gLoadedAssets = NULL;
+static int gLoadedAssetCount = 0;
+static LoadedDirectory *gLoadedDirectories = NULL;
+static int gLoadedDirectoryCount = 0;
+static int *gLoadedAssetKeys = NULL; // Assets with a key sorted by it, for looking them up by key
+static int gLoadedAssetKeyCount = 0;
+static LoadedAtlasPage *gLoadedAtlasPages = NULL;
+static int gLoadedAtlasPageCount = 0;
+static WrenHandle *gAssetMapHandle = NULL;
+
+// Slot 0 is where the loaders put what they load and 1-7 are their arguments
+#define ASSET_MAP_SLOT 8
+#define ASSET_LIST_SLOT 9
+
+static void _vksk_AssetsFreeLoaded(WrenVM *vm) {
+	for (int i = 0; i < gLoadedDirectoryCount; i++) {
+		if (gLoadedDirectories[i].list != NULL)
+			wrenReleaseHandle(vm, gLoadedDirectories[i].list);
+		free(gLoadedDirectories[i].assets);
+	}
+	if (gAssetMapHandle != NULL)
+		wrenReleaseHandle(vm, gAssetMapHandle);
+	for (int i = 0; i < gLoadedAtlasPageCount; i++) {
+		vksk_AtlasPageRelease(gLoadedAtlasPages[i].page);
+		free(gLoadedAtlasPages[i].assets);
+	}
+	free(gLoadedAtlasPages);
+	gLoadedAtlasPages = NULL;
+	gLoadedAtlasPageCount = 0;
+	free(gLoadedDirectories);
+	free(gLoadedAssets);
+	free(gLoadedAssetKeys);
+	gLoadedDirectories = NULL;
+	gLoadedAssets = NULL;
+	gLoadedAssetKeys = NULL;
+	gAssetMapHandle = NULL;
+	gLoadedDirectoryCount = 0;
+	gLoadedAssetCount = 0;
+	gLoadedAssetKeyCount = 0;
+}
+
+// Both lists only ever grow by one so they are resized at powers of two
+static int _vksk_AssetsAddDirectory(const char *path) {
+	if ((gLoadedDirectoryCount & (gLoadedDirectoryCount - 1)) == 0)
+		gLoadedDirectories = realloc(gLoadedDirectories, sizeof(LoadedDirectory) * (gLoadedDirectoryCount == 0 ? 1 : gLoadedDirectoryCount * 2));
+	LoadedDirectory *dir = &gLoadedDirectories[gLoadedDirectoryCount];
+	dir->list = NULL;
+	dir->path = path;
+	dir->assets = NULL;
+	dir->slots = 0;
+	return gLoadedDirectoryCount++;
+}
+
+static int _vksk_AssetsAddSlot(int directory, int asset) {
+	LoadedDirectory *dir = &gLoadedDirectories[directory];
+	if ((dir->slots & (dir->slots - 1)) == 0)
+		dir->assets = realloc(dir->assets, sizeof(int) * (dir->slots == 0 ? 1 : dir->slots * 2));
+	dir->assets[dir->slots] = asset;
+	return dir->slots++;
+}
+
+static int _vksk_AssetsCompareKeys(const void *left, const void *right) {
+	return strcmp(gLoadedAssets[*(const int*)left].key, gLoadedAssets[*(const int*)right].key);
+}
+
+static int _vksk_AssetsFindKey(const char *key) {
+	int low = 0;
+	int high = gLoadedAssetKeyCount - 1;
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		int cmp = strcmp(key, gLoadedAssets[gLoadedAssetKeys[mid]].key);
+		if (cmp == 0)
+			return gLoadedAssetKeys[mid];
+		else if (cmp < 0)
+			high = mid - 1;
+		else
+			low = mid + 1;
+	}
+	return -1;
+}
+
+// Adds an asset to the atlas page its texture is on
+static void _vksk_AssetsAddToAtlasPage(int asset, int page) {
+	if (page >= gLoadedAtlasPageCount) {
+		gLoadedAtlasPages = realloc(gLoadedAtlasPages, sizeof(LoadedAtlasPage) * (page + 1));
+		memset(&gLoadedAtlasPages[gLoadedAtlasPageCount], 0, sizeof(LoadedAtlasPage) * (page + 1 - gLoadedAtlasPageCount));
+		gLoadedAtlasPageCount = page + 1;
+	}
+	LoadedAtlasPage *atlas = &gLoadedAtlasPages[page];
+	atlas->assets = realloc(atlas->assets, sizeof(int) * (atlas->count + 1));
+	atlas->assets[atlas->count++] = asset;
+	gLoadedAssets[asset].atlasPage = page;
+}
+
+// Copies each texture's pixels into where it was packed and uploads the page, textures that don't match what
+// was packed (or don't load at all) are taken out of the atlas and get their own texture instead
+static void _vksk_AssetsLoadAtlasPage(int page) {
+	LoadedAtlasPage *atlas = &gLoadedAtlasPages[page];
+	atlas->loaded = true;
+	ManifestRecord *records = malloc(sizeof(ManifestRecord) * atlas->count);
+	uint8_t **pixels = calloc(atlas->count, sizeof(uint8_t*));
+	int *sizes = calloc(atlas->count * 2, sizeof(int));
+	const char **missing = malloc(sizeof(char*) * atlas->count);
+	uint64_t *types = malloc(sizeof(uint64_t) * atlas->count);
+	int missingCount = 0;
+
+	// Textures that weren't already decoded ahead of time get decoded together
+	for (int i = 0; i < atlas->count; i++) {
+		const uint8_t *pos = gLoadedAssets[atlas->assets[i]].record;
+		readManifestRecord(&pos, gAssetManifest + gAssetManifestSize, &records[i]);
+		pixels[i] = vksk_TakeDecodedTexture(records[i].path, &sizes[i * 2], &sizes[i * 2 + 1], NULL);
+		if (pixels[i] == NULL) {
+			missing[missingCount] = records[i].path;
+			types[missingCount++] = FOREIGN_TEXTURE;
+		}
+	}
+	vksk_DecodeFiles(missing, types, missingCount);
+
+	int pageW = (int)records[0].params[ATLAS_PARAM_PAGE_W];
+	int pageH = (int)records[0].params[ATLAS_PARAM_PAGE_H];
+	if (pageW <= 0 || pageH <= 0 || pageW > ATLAS_PAGE_SIZE || pageH > ATLAS_PAGE_SIZE)
+		pageW = pageH = 0;
+	uint8_t *pagePixels = calloc((size_t)pageW * pageH * 4 + 1, 1);
+	for (int i = 0; i < atlas->count; i++) {
+		const double *p = records[i].params;
+		if (pixels[i] == NULL)
+			pixels[i] = vksk_TakeDecodedTexture(records[i].path, &sizes[i * 2], &sizes[i * 2 + 1], NULL);
+		int w = sizes[i * 2], h = sizes[i * 2 + 1];
+		int x = (int)p[ATLAS_PARAM_X], y = (int)p[ATLAS_PARAM_Y];
+		int trimX = (int)p[ATLAS_PARAM_TRIM_X], trimY = (int)p[ATLAS_PARAM_TRIM_Y];
+		int trimW = (int)p[ATLAS_PARAM_TRIM_W], trimH = (int)p[ATLAS_PARAM_TRIM_H];
+		if (pixels[i] == NULL || w != (int)p[ATLAS_PARAM_W] || h != (int)p[ATLAS_PARAM_H] ||
+			trimX + trimW > w || trimY + trimH > h || x + trimW > pageW || y + trimH > pageH) {
+			gLoadedAssets[atlas->assets[i]].atlasPage = -1;
+		} else {
+			for (int row = 0; row < trimH; row++)
+				memcpy(pagePixels + (((size_t)(y + row) * pageW + x) * 4), pixels[i] + (((size_t)(trimY + row) * w + trimX) * 4), (size_t)trimW * 4);
+		}
+		stbi_image_free(pixels[i]);
+	}
+	atlas->page = pageW > 0 ? vksk_AtlasPageCreate(pagePixels, pageW, pageH) : NULL;
+	if (atlas->page == NULL)
+		vksk_Error(false, "Failed to create atlas page %i", page);
+
+	free(pagePixels);
+	free(sizes);
+	free(types);
+	free(missing);
+	free(pixels);
+	free(records);
+}
+
+// Decodes the textures and sounds among the first assets of a list on worker threads ahead of loading them, stopping
+// once it has a batch worth (see vksk_DecodeBatchSize). Returns how many of the assets it went through.
+static int _vksk_AssetsDecode(const int *assets, int count) {
+	int batchSize = vksk_DecodeBatchSize();
+	const char **files = malloc(sizeof(char*) * (batchSize + 1));
+	uint64_t *types = malloc(sizeof(uint64_t) * (batchSize + 1));
+	int fileCount = 0;
+	int i = 0;
+	for (; i < count && fileCount < batchSize; i++) {
+		// Textures in an atlas are decoded by _vksk_AssetsLoadAtlasPage with the rest of their page
+		if (gLoadedAssets[assets[i]].loaded || gLoadedAssets[assets[i]].atlasPage != -1)
+			continue;
+		const uint8_t *pos = gLoadedAssets[assets[i]].record;
+		ManifestRecord record;
+		readManifestRecord(&pos, gAssetManifest + gAssetManifestSize, &record);
+		if (record.type == ASSET_TYPE_TEXTURE || record.type == ASSET_TYPE_AUDIO) {
+			files[fileCount] = record.path;
+			types[fileCount++] = record.type == ASSET_TYPE_TEXTURE ? FOREIGN_TEXTURE : FOREIGN_AUDIO_DATA;
+		}
+	}
+	vksk_DecodeFiles(files, types, fileCount);
+	free(files);
+	free(types);
+	return i;
+}
+
+// Loads an asset into slot 0 and its directory's list, or just puts it in slot 0 if it was already loaded
+static void _vksk_AssetsLoad(WrenVM *vm, int index) {
+	LoadedAsset *asset = &gLoadedAssets[index];
+	LoadedDirectory *dir = &gLoadedDirectories[asset->directory];
+	if (asset->loaded) {
+		wrenSetSlotHandle(vm, ASSET_LIST_SLOT, dir->list);
+		wrenGetListElement(vm, ASSET_LIST_SLOT, asset->slot, 0);
+		return;
+	}
+	asset->loaded = true;
+
+	// The manifest was checked when the assets were listed so this can't fail
+	const uint8_t *pos = asset->record;
+	ManifestRecord record;
+	readManifestRecord(&pos, gAssetManifest + gAssetManifestSize, &record);
+	const double *p = record.params;
+	switch (record.type) {
+		case ASSET_TYPE_TEXTURE:
+			wrenGetVariable(vm, "lib/Drawing", "Texture", 0);
+			if (asset->atlasPage != -1 && !gLoadedAtlasPages[asset->atlasPage].loaded)
+				_vksk_AssetsLoadAtlasPage(asset->atlasPage);
+			if (asset->atlasPage != -1 && gLoadedAtlasPages[asset->atlasPage].page != NULL) {
+				_vksk_TextureRegion region;
+				region.page = gLoadedAtlasPages[asset->atlasPage].page;
+				region.x = p[ATLAS_PARAM_X];
+				region.y = p[ATLAS_PARAM_Y];
+				region.trimX = p[ATLAS_PARAM_TRIM_X];
+				region.trimY = p[ATLAS_PARAM_TRIM_Y];
+				region.trimW = p[ATLAS_PARAM_TRIM_W];
+				region.trimH = p[ATLAS_PARAM_TRIM_H];
+				region.w = p[ATLAS_PARAM_W];
+				region.h = p[ATLAS_PARAM_H];
+				vksk_RuntimeVK2DTextureFromRegion(vm, &region);
+			} else {
+				wrenSetSlotString(vm, 1, record.path);
+				vksk_RuntimeVK2DTextureAllocate(vm);
+			}
+			break;
+		case ASSET_TYPE_SPRITE: {
+			// Sprites need their texture loaded first
+			int slot = (int)p[0];
+			int texture = slot >= 0 && slot < dir->slots ? dir->assets[slot] : -1;
+			if (texture != -1)
+				_vksk_AssetsLoad(vm, texture);
+			if (texture == -1 || wrenGetSlotType(vm, 0) != WREN_TYPE_FOREIGN) {
+				wrenSetSlotNull(vm, 0);
+				break;
+			}
+			wrenSetSlotHandle(vm, ASSET_LIST_SLOT, dir->list);
+			wrenGetListElement(vm, ASSET_LIST_SLOT, slot, 1);
+			for (int i = 1; i < 7; i++)
+				wrenSetSlotDouble(vm, i + 1, p[i]);
+			vksk_RuntimeJUSpriteFrom(vm);
+			if (wrenGetSlotType(vm, 0) == WREN_TYPE_FOREIGN) {
+				wrenSetSlotDouble(vm, 1, p[7]);
+				vksk_RuntimeJUSpriteSetOriginX(vm);
+				wrenSetSlotDouble(vm, 1, p[8]);
+				vksk_RuntimeJUSpriteSetOriginY(vm);
+			}
+		} break;
+		case ASSET_TYPE_AUDIO:
+			wrenGetVariable(vm, "lib/Audio", "AudioData", 0);
+			wrenSetSlotString(vm, 1, record.path);
+			vksk_RuntimeJUAudioDataAllocate(vm);
+			break;
+		case ASSET_TYPE_TEXT:
+			wrenSetSlotString(vm, 1, record.path);
+			vksk_RuntimeFileRead(vm);
+			break;
+		case ASSET_TYPE_FONT:
+			wrenGetVariable(vm, "lib/Drawing", "Font", 0);
+			wrenSetSlotString(vm, 1, record.path);
+			wrenSetSlotDouble(vm, 2, p[0]);
+			wrenSetSlotBool(vm, 3, p[1] != 0);
+			wrenSetSlotDouble(vm, 4, p[2]);
+			wrenSetSlotDouble(vm, 5, p[3]);
+			vksk_RuntimeFontAllocate(vm);
+			break;
+		case ASSET_TYPE_BITMAP_FONT:
+			wrenGetVariable(vm, "lib/Drawing", "BitmapFont", 0);
+			wrenSetSlotString(vm, 1, record.path);
+			for (int i = 0; i < 4; i++)
+				wrenSetSlotDouble(vm, i + 2, p[i]);
+			vksk_RuntimeJUBitmapFontAllocate(vm);
+			break;
+		case ASSET_TYPE_BUFFER:
+			wrenSetSlotString(vm, 1, record.path);
+			vksk_RuntimeBufferOpen(vm);
+			break;
+		default:
+			wrenSetSlotNull(vm, 0);
+			break;
+	}
+
+	wrenSetSlotHandle(vm, ASSET_LIST_SLOT, dir->list);
+	wrenSetListElement(vm, ASSET_LIST_SLOT, asset->slot, 0);
+	if (asset->key[0] != 0) {
+		wrenSetSlotHandle(vm, ASSET_MAP_SLOT, gAssetMapHandle);
+		wrenSetSlotString(vm, 1, asset->key);
+		wrenSetMapValue(vm, ASSET_MAP_SLOT, 1, 0);
+	}
+}
+
+// Loads a list of assets a batch at a time so only one batch of decoded textures and sounds is held at once, each
+// one is freed as soon as its asset is loaded
+static void _vksk_AssetsLoadList(WrenVM *vm, const int *assets, int count) {
+	for (int start = 0; start < count;) {
+		int end = start + _vksk_AssetsDecode(assets + start, count - start);
+		for (int i = start; i < end; i++)
+			_vksk_AssetsLoad(vm, assets[i]);
+		vksk_DropDecodedFiles();
+		start = end;
+	}
+}
+
+void vksk_RuntimeAssetsLoadManifest(WrenVM *vm) {
+	_vksk_AssetsFreeLoaded(vm);
+	wrenEnsureSlots(vm, ASSET_LIST_SLOT + 1);
+	wrenSetSlotNewMap(vm, ASSET_MAP_SLOT);
+	gAssetMapHandle = wrenGetSlotHandle(vm, ASSET_MAP_SLOT);
+
+	// List every asset and build each directory's list with nulls where its assets go, the root's first slot is
+	// the asset map
+	int *stack = malloc(sizeof(int) * 8); // Directory being listed at each depth
+	int stackSize = 8;
+	int depth = 0;
+	stack[0] = _vksk_AssetsAddDirectory(gAssetRoot);
+	wrenSetSlotNewList(vm, ASSET_LIST_SLOT);
+	gLoadedDirectories[stack[0]].list = wrenGetSlotHandle(vm, ASSET_LIST_SLOT);
+	wrenInsertInList(vm, ASSET_LIST_SLOT, -1, ASSET_MAP_SLOT);
+	_vksk_AssetsAddSlot(stack[0], -1);
+
+	const uint8_t *pos = gAssetManifest;
+	const uint8_t *end = gAssetManifest + gAssetManifestSize;
+	ManifestRecord record;
+	bool done = false;
+	while (!done) {
+		const uint8_t *start = pos;
+		if (!readManifestRecord(&pos, end, &record)) {
+			vksk_Error(false, "Assets manifest is corrupt");
+			break;
+		}
+		if (record.type == ASSET_TYPE_END) {
+			if (depth == 0) {
+				done = true;
+			} else {
+				wrenInsertInList(vm, ASSET_LIST_SLOT + depth - 1, -1, ASSET_LIST_SLOT + depth);
+				depth--;
+			}
+		} else if (record.type == ASSET_TYPE_DIRECTORY) {
+			_vksk_AssetsAddSlot(stack[depth], -1);
+			if (++depth == stackSize) {
+				stackSize *= 2;
+				stack = realloc(stack, sizeof(int) * stackSize);
+			}
+			stack[depth] = _vksk_AssetsAddDirectory(record.path);
+			wrenEnsureSlots(vm, ASSET_LIST_SLOT + depth + 1);
+			wrenSetSlotNewList(vm, ASSET_LIST_SLOT + depth);
+			gLoadedDirectories[stack[depth]].list = wrenGetSlotHandle(vm, ASSET_LIST_SLOT + depth);
+		} else {
+			if ((gLoadedAssetCount & (gLoadedAssetCount - 1)) == 0)
+				gLoadedAssets = realloc(gLoadedAssets, sizeof(LoadedAsset) * (gLoadedAssetCount == 0 ? 1 : gLoadedAssetCount * 2));
+			LoadedAsset *asset = &gLoadedAssets[gLoadedAssetCount];
+			asset->record = start;
+			asset->key = record.key;
+			asset->directory = stack[depth];
+			asset->slot = _vksk_AssetsAddSlot(stack[depth], gLoadedAssetCount);
+			asset->atlasPage = -1;
+			asset->loaded = false;
+			// Textures on a page that doesn't exist are loaded on their own like any other texture
+			if (record.type == ASSET_TYPE_TEXTURE && record.paramCount == ATLAS_PARAM_COUNT &&
+				record.params[ATLAS_PARAM_PAGE] >= 0 && record.params[ATLAS_PARAM_PAGE] < gAtlasPageCount)
+				_vksk_AssetsAddToAtlasPage(gLoadedAssetCount, (int)record.params[ATLAS_PARAM_PAGE]);
+			gLoadedAssetCount++;
+			wrenSetSlotNull(vm, 0);
+			wrenInsertInList(vm, ASSET_LIST_SLOT + depth, -1, 0);
+		}
+	}
+
+	// Lists that were cut off by a corrupt manifest still get added to their parents so the slots line up
+	for (; depth > 0; depth--)
+		wrenInsertInList(vm, ASSET_LIST_SLOT + depth - 1, -1, ASSET_LIST_SLOT + depth);
+	free(stack);
+
+	gLoadedAssetKeys = malloc(sizeof(int) * (gLoadedAssetCount + 1));
+	for (int i = 0; i < gLoadedAssetCount; i++)
+		if (gLoadedAssets[i].key[0] != 0)
+			gLoadedAssetKeys[gLoadedAssetKeyCount++] = i;
+	qsort(gLoadedAssetKeys, gLoadedAssetKeyCount, sizeof(int), _vksk_AssetsCompareKeys);
+
+	// Lazy assets are loaded by their getters instead
+	if (!gEngineConfig.lazyAssets) {
+		int *assets = malloc(sizeof(int) * (gLoadedAssetCount + 1));
+		for (int i = 0; i < gLoadedAssetCount; i++)
+			assets[i] = i;
+		_vksk_AssetsLoadList(vm, assets, gLoadedAssetCount);
+		free(assets);
+	}
+
+	wrenSetSlotHandle(vm, 0, gLoadedDirectories[0].list);
+}
+
+void vksk_RuntimeAssetsLoadAsset(WrenVM *vm) {
+	int index = -1;
+	if (wrenGetSlotType(vm, 1) == WREN_TYPE_NUM)
+		index = (int)wrenGetSlotDouble(vm, 1);
+	else if (wrenGetSlotType(vm, 1) == WREN_TYPE_STRING)
+		index = _vksk_AssetsFindKey(wrenGetSlotString(vm, 1));
+	if (index < 0 || index >= gLoadedAssetCount) {
+		wrenSetSlotNull(vm, 0);
+		return;
+	}
+	wrenEnsureSlots(vm, ASSET_LIST_SLOT + 1);
+	_vksk_AssetsLoad(vm, index);
+}
+
+void vksk_RuntimeAssetsPreload(WrenVM *vm) {
+	if (wrenGetSlotType(vm, 1) != WREN_TYPE_STRING) {
+		vksk_Error(false, "Assets.preload expects the name of a directory");
+		wrenSetSlotNull(vm, 0);
+		return;
+	}
+	const char *group = wrenGetSlotString(vm, 1);
+	char prefix[STRING_BUFFER_SIZE];
+	int length = snprintf(prefix, STRING_BUFFER_SIZE, "%s%s", gAssetRoot, group);
+	if (group[0] != 0 && group[strlen(group) - 1] != '/' && length < STRING_BUFFER_SIZE - 1)
+		strcat(prefix, "/");
+
+	// Everything under the directory that isn't loaded yet is read from the pak in one batch first
+	int *assets = malloc(sizeof(int) * (gLoadedAssetCount + 1));
+	const char **files = malloc(sizeof(char*) * (gLoadedAssetCount + 1));
+	int count = 0;
+	int fileCount = 0;
+	for (int i = 0; i < gLoadedAssetCount; i++) {
+		if (!gLoadedAssets[i].loaded && strncmp(gLoadedDirectories[gLoadedAssets[i].directory].path, prefix, strlen(prefix)) == 0) {
+			const uint8_t *pos = gLoadedAssets[i].record;
+			ManifestRecord record;
+			readManifestRecord(&pos, gAssetManifest + gAssetManifestSize, &record);
+			assets[count++] = i;
+			if (record.path[0] != 0)
+				files[fileCount++] = record.path;
+		}
+	}
+
+	wrenEnsureSlots(vm, ASSET_LIST_SLOT + 1);
+	vksk_PrefetchFiles(files, fileCount);
+	_vksk_AssetsLoadList(vm, assets, count);
+	vksk_DropPrefetchedFiles();
+	free(assets);
+	free(files);
+	wrenSetSlotNull(vm, 0);
+}
+
+void vksk_PrefetchAssetFiles() {
+	// Lazy assets are prefetched by Assets.preload instead since most of them won't be loaded right away
+	if (!gEngineConfig.lazyAssets)
+		vksk_PrefetchFiles((const char **)gAssetPaths, gAssetPathCount);
+	for (int i = 0; i < gAssetPathCount; i++)
+		free(gAssetPaths[i]);
+	free(gAssetPaths);
+	gAssetPaths = NULL;
+	gAssetPathCount = 0;
+	gAssetPathSize = 0;
 }
\ No newline at end of file
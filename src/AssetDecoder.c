@@ -0,0 +1,189 @@
+/// \file AssetDecoder.c
+/// \author Paolo Mazzon
+#include <SDL2/SDL.h>
+#include <string.h>
+#define STB_VORBIS_HEADER_ONLY
+#include <src/stb_vorbis.h>
+#include <VK2D/stb_image.h>
+
+#include "src/AssetDecoder.h"
+#include "src/TextureFormat.h"
+#include "src/IntermediateTypes.h"
+#include "src/Util.h"
+
+typedef struct _vksk_DecodedFile {
+	char *filename;     // NULL once the file has been taken
+	uint64_t type;
+	VKSK_FileView view; // Only held while decoding
+	uint8_t *pixels;    // For textures, the whole mip chain if it has one
+	int w, h, levels;
+	JUSound sound;      // For audio
+} _vksk_DecodedFile;
+
+typedef struct _vksk_DecodeState {
+	_vksk_DecodedFile *files;
+	int count;
+	SDL_atomic_t next; // Next file for a worker to take
+} _vksk_DecodeState;
+
+static _vksk_DecodedFile *gDecoded = NULL;
+static int gDecodedCount = 0;
+static int gDecodedLeft = 0; // Files that haven't been taken yet
+static int gDecodedNext = 0; // Files are usually taken in the order they were decoded
+
+static void _vksk_DecodeFile(_vksk_DecodedFile *file) {
+	if (file->type == FOREIGN_TEXTURE) {
+		file->pixels = vksk_TextureLoadPixels(file->view.data, file->view.size, &file->w, &file->h, &file->levels);
+	} else {
+		const char *ext = strrchr(file->filename, '.');
+		if (ext == NULL)
+			return;
+		JUSound sound = calloc(1, sizeof(struct JUSound));
+		if (strcmp(ext, ".wav") == 0)
+			cs_read_mem_wav(file->view.data, file->view.size, &sound->sound);
+		else if (strcmp(ext, ".ogg") == 0)
+			cs_read_mem_ogg(file->view.data, file->view.size, &sound->sound);
+		if (sound->sound.channels[0] != NULL)
+			file->sound = sound;
+		else
+			free(sound);
+	}
+}
+
+static int _vksk_DecodeWorker(void *data) {
+	_vksk_DecodeState *state = data;
+	for (int i = SDL_AtomicAdd(&state->next, 1); i < state->count; i = SDL_AtomicAdd(&state->next, 1))
+		_vksk_DecodeFile(&state->files[i]);
+	return 0;
+}
+
+int vksk_DecodeBatchSize() {
+	// Twice the cores so a few slow files don't leave the rest of the cores waiting on them
+	int cores = SDL_GetCPUCount();
+	return cores > 2 ? cores * 2 : 4;
+}
+
+void vksk_DecodeFiles(const char **filenames, const uint64_t *types, int count) {
+	if (count <= 0)
+		return;
+	gDecoded = realloc(gDecoded, sizeof(_vksk_DecodedFile) * (gDecodedCount + count));
+	_vksk_DecodedFile *files = &gDecoded[gDecodedCount];
+
+	// Files are read on this thread since the pak and prefetched files aren't safe to use from others, and
+	// files with the same contents in game.pak share one asset so only the first is decoded. Blobs seen so far go
+	// in an open addressed (linear probe) table of indices into files, -1 meaning the slot is empty.
+	int tableSize = 16;
+	while (tableSize < count * 2)
+		tableSize *= 2;
+	int *table = malloc(sizeof(int) * tableSize);
+	memset(table, -1, sizeof(int) * tableSize);
+	uint64_t *blobs = malloc(sizeof(uint64_t) * count);
+	int fileCount = 0;
+	for (int i = 0; i < count; i++) {
+		uint64_t blob = vksk_GetFileBlobID(filenames[i]);
+		int slot = -1;
+		if (blob != 0) {
+			if (vksk_AssetCacheContains(types[i], blob))
+				continue;
+			uint64_t hash = (blob ^ types[i]) * 0x9e3779b97f4a7c15ull;
+			slot = (int)(hash >> 32) & (tableSize - 1);
+			while (table[slot] != -1 && (blobs[table[slot]] != blob || files[table[slot]].type != types[i]))
+				slot = (slot + 1) & (tableSize - 1);
+			if (table[slot] != -1)
+				continue;
+		}
+		_vksk_DecodedFile *file = &files[fileCount];
+		memset(file, 0, sizeof(_vksk_DecodedFile));
+		file->type = types[i];
+		if (!vksk_GetFileView(filenames[i], &file->view))
+			continue;
+		file->filename = malloc(strlen(filenames[i]) + 1);
+		strcpy(file->filename, filenames[i]);
+		if (slot != -1)
+			table[slot] = fileCount;
+		blobs[fileCount++] = blob;
+	}
+	free(table);
+	free(blobs);
+
+	_vksk_DecodeState state = {0};
+	state.files = files;
+	state.count = fileCount;
+	int threadCount = SDL_GetCPUCount() > 1 ? SDL_GetCPUCount() : 1;
+	if (threadCount > fileCount)
+		threadCount = fileCount;
+	if (threadCount > 1) {
+		SDL_Thread **threads = malloc(sizeof(SDL_Thread *) * threadCount);
+		for (int i = 0; i < threadCount; i++)
+			threads[i] = SDL_CreateThread(_vksk_DecodeWorker, "AssetDecodeWorker", &state);
+		for (int i = 0; i < threadCount; i++)
+			SDL_WaitThread(threads[i], NULL);
+		free(threads);
+	} else {
+		_vksk_DecodeWorker(&state);
+	}
+
+	// Whatever didn't decode is left for its allocator so the error gets reported where it normally would
+	int decoded = 0;
+	for (int i = 0; i < fileCount; i++) {
+		vksk_ReleaseFileView(&files[i].view);
+		if (files[i].pixels != NULL || files[i].sound != NULL)
+			files[decoded++] = files[i];
+		else
+			free(files[i].filename);
+	}
+	gDecodedCount += decoded;
+	gDecodedLeft += decoded;
+}
+
+// Takes a decoded file out of the list if its there, taken files are only marked as such so taking them in the
+// order they were decoded finds each one right away
+static bool _vksk_TakeDecodedFile(const char *filename, uint64_t type, _vksk_DecodedFile *out) {
+	for (int n = 0; n < gDecodedCount && gDecodedLeft > 0; n++) {
+		int i = (gDecodedNext + n) % gDecodedCount;
+		if (gDecoded[i].filename != NULL && gDecoded[i].type == type && strcmp(gDecoded[i].filename, filename) == 0) {
+			*out = gDecoded[i];
+			free(gDecoded[i].filename);
+			gDecoded[i].filename = NULL;
+			gDecoded[i].pixels = NULL;
+			gDecoded[i].sound = NULL;
+			gDecodedNext = i + 1;
+			if (--gDecodedLeft == 0)
+				vksk_DropDecodedFiles();
+			return true;
+		}
+	}
+	return false;
+}
+
+uint8_t *vksk_TakeDecodedTexture(const char *filename, int *w, int *h, int *levels) {
+	_vksk_DecodedFile file;
+	if (!_vksk_TakeDecodedFile(filename, FOREIGN_TEXTURE, &file))
+		return NULL;
+	*w = file.w;
+	*h = file.h;
+	if (levels != NULL)
+		*levels = file.levels;
+	return file.pixels;
+}
+
+JUSound vksk_TakeDecodedSound(const char *filename) {
+	_vksk_DecodedFile file;
+	if (!_vksk_TakeDecodedFile(filename, FOREIGN_AUDIO_DATA, &file))
+		return NULL;
+	return file.sound;
+}
+
+void vksk_DropDecodedFiles() {
+	for (int i = 0; i < gDecodedCount; i++) {
+		free(gDecoded[i].filename);
+		stbi_image_free(gDecoded[i].pixels);
+		if (gDecoded[i].sound != NULL)
+			juSoundFree(gDecoded[i].sound);
+	}
+	free(gDecoded);
+	gDecoded = NULL;
+	gDecodedCount = 0;
+	gDecodedLeft = 0;
+	gDecodedNext = 0;
+}
@@ -0,0 +1,27 @@
+/// \file AssetDecoder.h
+/// \author Paolo Mazzon
+/// \brief Decodes textures and sounds on worker threads ahead of their allocators
+#pragma once
+#include <stdint.h>
+
+#include "src/JamUtil.h"
+
+// Decodes a batch of textures and sounds (types are FOREIGN_TEXTURE or FOREIGN_AUDIO_DATA) on a thread per core so
+// their allocators only have to do the GPU upload and Wren side on the main thread. Anything that fails to decode
+// is skipped and left for its allocator to load and report like normal.
+void vksk_DecodeFiles(const char **filenames, const uint64_t *types, int count);
+
+// How many files vksk_DecodeFiles should be given at once to keep every core busy, decoding more than this at a
+// time only holds more decoded files in memory
+int vksk_DecodeBatchSize();
+
+// Takes the RGBA pixels decoded for a texture, returns NULL if it wasn't decoded. Free them with stbi_image_free.
+// Textures with a mip chain have every level one after the other (see vksk_TextureLoadPixels), the number of which
+// is put into `levels` if it isn't NULL.
+uint8_t *vksk_TakeDecodedTexture(const char *filename, int *w, int *h, int *levels);
+
+// Takes the sound decoded for a file, returns NULL if it wasn't decoded
+JUSound vksk_TakeDecodedSound(const char *filename);
+
+// Frees anything decoded that was never taken
+void vksk_DropDecodedFiles();
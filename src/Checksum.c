@@ -0,0 +1,100 @@
+/// \file Checksum.c
+/// \author Paolo Mazzon
+#include <string.h>
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+
+#include "src/Checksum.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VKSK_CRC32C_X86
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define VKSK_CRC32C_ARM
+#include <arm_acle.h>
+#endif
+
+#define CRC32C_POLY 0x82F63B78u // Reversed Castagnoli polynomial
+
+// Slicing-by-8 tables, table[k][b] is the crc of byte b followed by k zero bytes
+static uint32_t gCRCTable[8][256];
+static SDL_atomic_t gCRCTableReady; // Only set once the table is filled in
+static SDL_SpinLock gCRCTableLock = 0;
+
+static void _vksk_CRCBuildTable() {
+	for (int b = 0; b < 256; b++) {
+		uint32_t crc = b;
+		for (int i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (CRC32C_POLY & (0 - (crc & 1)));
+		gCRCTable[0][b] = crc;
+	}
+	for (int b = 0; b < 256; b++)
+		for (int k = 1; k < 8; k++)
+			gCRCTable[k][b] = (gCRCTable[k - 1][b] >> 8) ^ gCRCTable[0][gCRCTable[k - 1][b] & 0xFF];
+}
+
+static uint32_t _vksk_CRCSoftware(uint32_t crc, const uint8_t *p, size_t size) {
+	// The pak save pipeline's workers all get here at once the first time, only one of them builds the table and
+	// the atomic makes sure the others see it filled in
+	if (!SDL_AtomicGet(&gCRCTableReady)) {
+		SDL_AtomicLock(&gCRCTableLock);
+		if (!SDL_AtomicGet(&gCRCTableReady)) {
+			_vksk_CRCBuildTable();
+			SDL_AtomicSet(&gCRCTableReady, 1);
+		}
+		SDL_AtomicUnlock(&gCRCTableLock);
+	}
+	for (; size >= 8; size -= 8, p += 8) {
+		uint32_t low = (p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24)) ^ crc;
+		crc = gCRCTable[7][low & 0xFF] ^ gCRCTable[6][(low >> 8) & 0xFF] ^
+			  gCRCTable[5][(low >> 16) & 0xFF] ^ gCRCTable[4][low >> 24] ^
+			  gCRCTable[3][p[4]] ^ gCRCTable[2][p[5]] ^ gCRCTable[1][p[6]] ^ gCRCTable[0][p[7]];
+	}
+	while (size-- > 0)
+		crc = (crc >> 8) ^ gCRCTable[0][(crc ^ *p++) & 0xFF];
+	return crc;
+}
+
+#if defined(VKSK_CRC32C_X86)
+__attribute__((target("sse4.2")))
+static uint32_t _vksk_CRCHardware(uint32_t crc, const uint8_t *p, size_t size) {
+#if defined(__x86_64__)
+	uint64_t crc64 = crc;
+	for (; size >= 8; size -= 8, p += 8) {
+		uint64_t v;
+		memcpy(&v, p, 8);
+		crc64 = __builtin_ia32_crc32di(crc64, v);
+	}
+	crc = (uint32_t)crc64;
+#endif
+	for (; size >= 4; size -= 4, p += 4) {
+		uint32_t v;
+		memcpy(&v, p, 4);
+		crc = __builtin_ia32_crc32si(crc, v);
+	}
+	while (size-- > 0)
+		crc = __builtin_ia32_crc32qi(crc, *p++);
+	return crc;
+}
+#elif defined(VKSK_CRC32C_ARM)
+static uint32_t _vksk_CRCHardware(uint32_t crc, const uint8_t *p, size_t size) {
+	for (; size >= 8; size -= 8, p += 8) {
+		uint64_t v;
+		memcpy(&v, p, 8);
+		crc = __crc32cd(crc, v);
+	}
+	while (size-- > 0)
+		crc = __crc32cb(crc, *p++);
+	return crc;
+}
+#endif
+
+uint32_t vksk_CRC32C(uint32_t crc, const void *data, size_t size) {
+	crc = ~crc;
+#if defined(VKSK_CRC32C_X86)
+	if (__builtin_cpu_supports("sse4.2"))
+		return ~_vksk_CRCHardware(crc, data, size);
+#elif defined(VKSK_CRC32C_ARM)
+	return ~_vksk_CRCHardware(crc, data, size);
+#endif
+	return ~_vksk_CRCSoftware(crc, data, size);
+}
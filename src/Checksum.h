@@ -0,0 +1,10 @@
+/// \file Checksum.h
+/// \author Paolo Mazzon
+/// \brief CRC32C (Castagnoli) used for checking pak entries
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Continues a CRC32C over `size` more bytes, start with a crc of 0. Uses the CPU's crc32 instructions when it has
+// them and a table driven version otherwise, both give the same result.
+uint32_t vksk_CRC32C(uint32_t crc, const void *data, size_t size);
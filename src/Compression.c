@@ -0,0 +1,166 @@
+/// \file Compression.c
+/// \author Paolo Mazzon
+#include <string.h>
+
+#include "src/Compression.h"
+
+/*
+ * Compressed data is a list of sequences, each of which is
+ *  + 1 byte token, the top 4 bits are the literal count and the bottom 4 are the match length - 4
+ *  + if the literal count is 15, more bytes follow that are added to it until one is not 255
+ *  + the literals themselves
+ *  + 2 bytes little-endian offset backwards from the current output position to copy the match from
+ *  + if the match length is 15, more bytes follow that are added to it until one is not 255
+ * The final sequence only has literals and stops at the end of the input.
+ */
+
+#define LZ_MIN_MATCH 4
+#define LZ_HASH_BITS 14
+#define LZ_MAX_OFFSET 65535
+#define LZ_LAST_LITERALS 5 // The last few bytes are always literals so the decoder can't overrun
+#define LZ_MATCH_LIMIT 12  // No matches start this close to the end of the input
+
+static uint32_t _vksk_LZRead32(const uint8_t *p) {
+	uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+static uint32_t _vksk_LZHash(uint32_t sequence) {
+	return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static uint8_t *_vksk_LZWriteLength(uint8_t *op, int length) {
+	while (length >= 255) {
+		*op++ = 255;
+		length -= 255;
+	}
+	*op++ = length;
+	return op;
+}
+
+// Writes a token, its literals and optionally the match that follows them
+static uint8_t *_vksk_LZWriteSequence(uint8_t *op, const uint8_t *literals, int literalCount, int offset, int matchLength) {
+	uint8_t *token = op++;
+	*token = (literalCount >= 15 ? 15 : literalCount) << 4;
+	if (literalCount >= 15)
+		op = _vksk_LZWriteLength(op, literalCount - 15);
+	memcpy(op, literals, literalCount);
+	op += literalCount;
+
+	if (matchLength > 0) {
+		*op++ = offset & 0xFF;
+		*op++ = offset >> 8;
+		matchLength -= LZ_MIN_MATCH;
+		*token |= matchLength >= 15 ? 15 : matchLength;
+		if (matchLength >= 15)
+			op = _vksk_LZWriteLength(op, matchLength - 15);
+	}
+	return op;
+}
+
+int vksk_LZCompressBound(int size) {
+	return size + (size / 255) + 16;
+}
+
+int vksk_LZCompress(const uint8_t *src, int srcSize, uint8_t *dst, int dstCapacity) {
+	if (srcSize < 0 || dstCapacity < vksk_LZCompressBound(srcSize))
+		return 0;
+
+	int table[1 << LZ_HASH_BITS];
+	memset(table, -1, sizeof(table));
+	const uint8_t *ip = src;
+	const uint8_t *anchor = src;
+	const uint8_t *end = src + srcSize;
+	uint8_t *op = dst;
+
+	if (srcSize > LZ_MATCH_LIMIT) {
+		const uint8_t *matchStartLimit = end - LZ_MATCH_LIMIT;
+		const uint8_t *matchEndLimit = end - LZ_LAST_LITERALS;
+		while (ip < matchStartLimit) {
+			uint32_t sequence = _vksk_LZRead32(ip);
+			uint32_t hash = _vksk_LZHash(sequence);
+			int candidate = table[hash];
+			table[hash] = ip - src;
+			if (candidate < 0 || (ip - src) - candidate > LZ_MAX_OFFSET || _vksk_LZRead32(src + candidate) != sequence) {
+				ip++;
+				continue;
+			}
+
+			// Extend the match backwards into the pending literals and then forwards as far as it goes
+			const uint8_t *match = src + candidate;
+			while (ip > anchor && match > src && ip[-1] == match[-1]) {
+				ip--;
+				match--;
+			}
+			int matchLength = LZ_MIN_MATCH;
+			while (ip + matchLength < matchEndLimit && ip[matchLength] == match[matchLength])
+				matchLength++;
+
+			op = _vksk_LZWriteSequence(op, anchor, ip - anchor, ip - match, matchLength);
+			ip += matchLength;
+			anchor = ip;
+		}
+	}
+
+	op = _vksk_LZWriteSequence(op, anchor, end - anchor, 0, 0);
+	return op - dst;
+}
+
+// Reads the extra length bytes after a token nibble of 15, returns false if it runs off the input
+static bool _vksk_LZReadLength(const uint8_t **ip, const uint8_t *end, size_t *length) {
+	uint8_t byte;
+	do {
+		if (*ip >= end)
+			return false;
+		byte = *(*ip)++;
+		*length += byte;
+	} while (byte == 255);
+	return true;
+}
+
+bool vksk_LZDecompress(const uint8_t *src, int srcSize, uint8_t *dst, int dstSize) {
+	const uint8_t *ip = src;
+	const uint8_t *iend = src + srcSize;
+	uint8_t *op = dst;
+	uint8_t *oend = dst + dstSize;
+
+	while (ip < iend) {
+		uint8_t token = *ip++;
+
+		// Literals
+		size_t literalCount = token >> 4;
+		if (literalCount == 15 && !_vksk_LZReadLength(&ip, iend, &literalCount))
+			return false;
+		if (literalCount > (size_t)(iend - ip) || literalCount > (size_t)(oend - op))
+			return false;
+		memcpy(op, ip, literalCount);
+		ip += literalCount;
+		op += literalCount;
+		if (ip == iend)
+			break;
+
+		// Match
+		if (iend - ip < 2)
+			return false;
+		size_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !_vksk_LZReadLength(&ip, iend, &matchLength))
+			return false;
+		matchLength += LZ_MIN_MATCH;
+		if (offset == 0 || offset > (size_t)(op - dst) || matchLength > (size_t)(oend - op))
+			return false;
+		const uint8_t *match = op - offset;
+		if (offset >= matchLength) {
+			memcpy(op, match, matchLength);
+			op += matchLength;
+		} else {
+			// Overlapping copies repeat the last `offset` bytes so they have to go one at a time
+			for (size_t i = 0; i < matchLength; i++)
+				*op++ = *match++;
+		}
+	}
+
+	return op == oend;
+}
@@ -0,0 +1,17 @@
+/// \file Compression.h
+/// \author Paolo Mazzon
+/// \brief Small LZ77 codec (LZ4 style sequences) used for compressing pak entries
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// Largest possible output of vksk_LZCompress for an input of `size` bytes
+int vksk_LZCompressBound(int size);
+
+// Compresses `srcSize` bytes into dst, returning the compressed size. dst must be able to hold at least
+// vksk_LZCompressBound(srcSize) bytes, otherwise nothing is written and 0 is returned.
+int vksk_LZCompress(const uint8_t *src, int srcSize, uint8_t *dst, int dstCapacity);
+
+// Decompresses src into exactly `dstSize` bytes of dst, returns false if the data is malformed or does not
+// decompress to exactly `dstSize` bytes. Never reads or writes outside of either buffer.
+bool vksk_LZDecompress(const uint8_t *src, int srcSize, uint8_t *dst, int dstSize);
@@ -0,0 +1,309 @@
+/// \file FontBaker.c
+/// \author Paolo Mazzon
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+#include "src/stb_truetype.h"
+
+#include "src/FontBaker.h"
+#include "src/Checksum.h"
+#include "src/Compression.h"
+
+/*
+ * Font cache file specification (version 1)
+ *
+ * Cache files never leave the machine that made them so everything is in its byte order. Each file is named after
+ * the CRC32C of the font file and of its settings, and starts with a _vksk_FontCacheHeader that repeats the font's
+ * size, CRC32C and settings so a file that only shares a name with the font isn't used. After it are
+ * unicodeEnd - unicodeStart + 1 _vksk_FontCacheGlyph and then the atlas' coverage compressed with vksk_LZCompress.
+ */
+
+#define FONT_CACHE_MAGIC "ASTROFNT"
+#define FONT_CACHE_VERSION 1
+#define FONT_ATLAS_MAX_WIDTH 4096 // Glyphs wrap onto a new row past this
+#define FONT_GLYPH_PADDING 4      // Space around each glyph so filtering doesn't pick up its neighbours
+#define FONT_ALIASED_CUTOFF 50    // Coverage at or below this is dropped from fonts without anti-aliasing
+
+typedef struct _vksk_FontCacheHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t fontSize;
+	uint32_t fontCRC;
+	float size;
+	uint32_t aa;
+	int32_t unicodeStart;
+	int32_t unicodeEnd;
+	float newLineHeight;
+	uint32_t w;
+	uint32_t h;
+	uint32_t compressedSize;
+} _vksk_FontCacheHeader;
+
+typedef struct _vksk_FontCacheGlyph {
+	float x, y, w, h;
+	float ykern;
+	uint32_t drawn;
+} _vksk_FontCacheGlyph;
+
+// What each worker needs to rasterise glyphs straight into the atlas
+typedef struct _vksk_FontBakeState {
+	stbtt_fontinfo *info;
+	float scale;
+	bool aa;
+	VKSK_BakedFont *font;
+	int *glyphIndices; // stb_truetype glyph index of each code point
+	int *sizes;        // Width and height of each glyph's bitmap
+	int count;
+	SDL_atomic_t next; // Next glyph for a worker to take
+} _vksk_FontBakeState;
+
+/*************** Cache ***************/
+static void _vksk_FontCachePath(const char *cacheDirectory, uint32_t fontCRC, float size, bool aa, int unicodeStart, int unicodeEnd, char *path, int length) {
+	int32_t settings[] = {unicodeStart, unicodeEnd, aa};
+	uint32_t settingsCRC = vksk_CRC32C(vksk_CRC32C(0, &size, sizeof(float)), settings, sizeof(settings));
+	snprintf(path, length, "%s/%08x%08x.fnt", cacheDirectory, fontCRC, settingsCRC);
+}
+
+static bool _vksk_FontCacheLoad(const char *path, const _vksk_FontCacheHeader *expected, VKSK_BakedFont *out) {
+	FILE *f = fopen(path, "rb");
+	if (f == NULL)
+		return false;
+	_vksk_FontCacheHeader header;
+	bool valid = fread(&header, sizeof(header), 1, f) == 1 &&
+				 memcmp(header.magic, expected->magic, 8) == 0 && header.version == expected->version &&
+				 header.fontSize == expected->fontSize && header.fontCRC == expected->fontCRC &&
+				 header.size == expected->size && header.aa == expected->aa &&
+				 header.unicodeStart == expected->unicodeStart && header.unicodeEnd == expected->unicodeEnd &&
+				 header.w > 0 && header.h > 0 && header.w <= FONT_ATLAS_MAX_WIDTH && (uint64_t)header.w * header.h <= INT32_MAX &&
+				 header.compressedSize <= (uint32_t)vksk_LZCompressBound(header.w * header.h);
+	if (!valid) {
+		fclose(f);
+		return false;
+	}
+
+	int count = header.unicodeEnd - header.unicodeStart + 1;
+	_vksk_FontCacheGlyph *glyphs = malloc(sizeof(_vksk_FontCacheGlyph) * count);
+	uint8_t *compressed = malloc(header.compressedSize + 1);
+	out->coverage = malloc((size_t)header.w * header.h);
+	valid = fread(glyphs, sizeof(_vksk_FontCacheGlyph), count, f) == count &&
+			fread(compressed, 1, header.compressedSize, f) == header.compressedSize &&
+			vksk_LZDecompress(compressed, header.compressedSize, out->coverage, header.w * header.h);
+	fclose(f);
+	free(compressed);
+	if (!valid) {
+		free(glyphs);
+		free(out->coverage);
+		return false;
+	}
+
+	out->w = header.w;
+	out->h = header.h;
+	out->newLineHeight = header.newLineHeight;
+	out->unicodeStart = header.unicodeStart;
+	out->unicodeEnd = header.unicodeEnd;
+	out->glyphs = malloc(sizeof(VKSK_BakedGlyph) * count);
+	for (int i = 0; i < count; i++) {
+		out->glyphs[i].x = glyphs[i].x;
+		out->glyphs[i].y = glyphs[i].y;
+		out->glyphs[i].w = glyphs[i].w;
+		out->glyphs[i].h = glyphs[i].h;
+		out->glyphs[i].ykern = glyphs[i].ykern;
+		out->glyphs[i].drawn = glyphs[i].drawn != 0;
+	}
+	free(glyphs);
+	return true;
+}
+
+// Failing to save is fine, the font just gets baked again next time
+static void _vksk_FontCacheSave(const char *cacheDirectory, const char *path, _vksk_FontCacheHeader *header, const VKSK_BakedFont *font) {
+#ifdef _WIN32
+	CreateDirectoryA(cacheDirectory, NULL);
+#else
+	mkdir(cacheDirectory, 0755);
+#endif
+	int count = font->unicodeEnd - font->unicodeStart + 1;
+	uint8_t *compressed = malloc(vksk_LZCompressBound(font->w * font->h));
+	header->compressedSize = vksk_LZCompress(font->coverage, font->w * font->h, compressed, vksk_LZCompressBound(font->w * font->h));
+	header->newLineHeight = font->newLineHeight;
+	header->w = font->w;
+	header->h = font->h;
+	_vksk_FontCacheGlyph *glyphs = malloc(sizeof(_vksk_FontCacheGlyph) * count);
+	for (int i = 0; i < count; i++) {
+		glyphs[i].x = font->glyphs[i].x;
+		glyphs[i].y = font->glyphs[i].y;
+		glyphs[i].w = font->glyphs[i].w;
+		glyphs[i].h = font->glyphs[i].h;
+		glyphs[i].ykern = font->glyphs[i].ykern;
+		glyphs[i].drawn = font->glyphs[i].drawn;
+	}
+
+	FILE *f = fopen(path, "wb");
+	if (f != NULL) {
+		bool written = fwrite(header, sizeof(_vksk_FontCacheHeader), 1, f) == 1 &&
+					   fwrite(glyphs, sizeof(_vksk_FontCacheGlyph), count, f) == count &&
+					   fwrite(compressed, 1, header->compressedSize, f) == header->compressedSize;
+		fclose(f);
+		if (!written)
+			remove(path);
+	}
+	free(glyphs);
+	free(compressed);
+}
+
+/*************** Baking ***************/
+static int _vksk_FontBakeWorker(void *data) {
+	_vksk_FontBakeState *state = data;
+	VKSK_BakedFont *font = state->font;
+	for (int i = SDL_AtomicAdd(&state->next, 1); i < state->count; i = SDL_AtomicAdd(&state->next, 1)) {
+		VKSK_BakedGlyph *glyph = &font->glyphs[i];
+		int w = state->sizes[i * 2], h = state->sizes[i * 2 + 1];
+		if (!glyph->drawn || w <= 0 || h <= 0)
+			continue;
+
+		// Each glyph has its own spot in the atlas so they're rasterised right into it
+		uint8_t *dst = &font->coverage[(size_t)glyph->y * font->w + (size_t)glyph->x];
+		stbtt_MakeGlyphBitmap(state->info, dst, w, h, font->w, state->scale, state->scale, state->glyphIndices[i]);
+		if (!state->aa) {
+			for (int y = 0; y < h; y++)
+				for (int x = 0; x < w; x++)
+					if (dst[y * font->w + x] <= FONT_ALIASED_CUTOFF)
+						dst[y * font->w + x] = 0;
+		}
+	}
+	return 0;
+}
+
+bool vksk_FontBake(const uint8_t *ttf, int ttfSize, float size, bool aa, int unicodeStart, int unicodeEnd, const char *cacheDirectory, VKSK_BakedFont *out) {
+	memset(out, 0, sizeof(VKSK_BakedFont));
+	int count = unicodeEnd - unicodeStart + 1;
+	if (ttf == NULL || ttfSize <= 0 || count <= 0)
+		return false;
+
+	// Fonts are cached by their contents and settings so a changed font is baked again
+	char path[1024];
+	_vksk_FontCacheHeader header = {0};
+	if (cacheDirectory != NULL) {
+		memcpy(header.magic, FONT_CACHE_MAGIC, 8);
+		header.version = FONT_CACHE_VERSION;
+		header.fontSize = ttfSize;
+		header.fontCRC = vksk_CRC32C(0, ttf, ttfSize);
+		header.size = size;
+		header.aa = aa;
+		header.unicodeStart = unicodeStart;
+		header.unicodeEnd = unicodeEnd;
+		_vksk_FontCachePath(cacheDirectory, header.fontCRC, size, aa, unicodeStart, unicodeEnd, path, 1024);
+		if (_vksk_FontCacheLoad(path, &header, out))
+			return true;
+	}
+
+	stbtt_fontinfo info = {0};
+	if (!stbtt_InitFont(&info, ttf, 0))
+		return false;
+	int ascent, descent, lineGap;
+	float scale = stbtt_ScaleForPixelHeight(&info, size);
+	stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
+	out->newLineHeight = (ascent * scale) - (descent * scale) + (lineGap * scale);
+	out->unicodeStart = unicodeStart;
+	out->unicodeEnd = unicodeEnd;
+	out->glyphs = calloc(count, sizeof(VKSK_BakedGlyph));
+
+	// Glyph sizes come from their boxes which is cheap, glyphs without one are as wide as half an average glyph
+	_vksk_FontBakeState state = {0};
+	state.info = &info;
+	state.scale = scale;
+	state.aa = aa;
+	state.font = out;
+	state.count = count;
+	state.glyphIndices = malloc(sizeof(int) * count);
+	state.sizes = calloc(count * 2, sizeof(int));
+	int *yOffsets = calloc(count, sizeof(int));
+	float average = 0;
+	int drawnCount = 0;
+	for (int i = 0; i < count; i++) {
+		int x0, y0, x1, y1;
+		VKSK_BakedGlyph *glyph = &out->glyphs[i];
+		state.glyphIndices[i] = stbtt_FindGlyphIndex(&info, unicodeStart + i);
+		if (stbtt_IsGlyphEmpty(&info, state.glyphIndices[i]) == 0) {
+			stbtt_GetGlyphBox(&info, state.glyphIndices[i], &x0, &y0, &x1, &y1);
+			glyph->w = (x1 * scale) - (x0 * scale);
+			glyph->h = (y1 * scale) - (y0 * scale) + 2;
+			glyph->drawn = true;
+			average += glyph->w;
+			drawnCount++;
+			stbtt_GetGlyphBitmapBox(&info, state.glyphIndices[i], scale, scale, &x0, &y0, &x1, &y1);
+			state.sizes[i * 2] = x1 - x0;
+			state.sizes[i * 2 + 1] = y1 - y0;
+			yOffsets[i] = y0;
+		}
+	}
+	float spaceSize = drawnCount > 0 ? (average / drawnCount) * 0.5 : out->newLineHeight / 2;
+
+	// Glyphs go left to right in rows as wide as all of them or FONT_ATLAS_MAX_WIDTH, whichever is less
+	int totalWidth = 0;
+	for (int i = 0; i < count; i++) {
+		VKSK_BakedGlyph *glyph = &out->glyphs[i];
+		if (!glyph->drawn)
+			glyph->w = spaceSize;
+		glyph->w += 1;
+		int cellW = (int)ceilf(glyph->w) > state.sizes[i * 2] ? (int)ceilf(glyph->w) : state.sizes[i * 2];
+		totalWidth += cellW + FONT_GLYPH_PADDING;
+		if (cellW > out->w)
+			out->w = cellW;
+	}
+	if (totalWidth > out->w)
+		out->w = totalWidth < FONT_ATLAS_MAX_WIDTH ? totalWidth : FONT_ATLAS_MAX_WIDTH;
+	int x = 0, y = 0, rowHeight = 0;
+	for (int i = 0; i < count; i++) {
+		VKSK_BakedGlyph *glyph = &out->glyphs[i];
+		int cellW = (int)ceilf(glyph->w) > state.sizes[i * 2] ? (int)ceilf(glyph->w) : state.sizes[i * 2];
+		int cellH = (int)ceilf(glyph->h) > state.sizes[i * 2 + 1] ? (int)ceilf(glyph->h) : state.sizes[i * 2 + 1];
+		if (x > 0 && x + cellW > out->w) {
+			y += rowHeight + FONT_GLYPH_PADDING;
+			x = 0;
+			rowHeight = 0;
+		}
+		glyph->x = x;
+		glyph->y = y;
+		glyph->ykern = glyph->drawn ? (ascent * scale) + yOffsets[i] : 0;
+		x += cellW + FONT_GLYPH_PADDING;
+		if (cellH > rowHeight)
+			rowHeight = cellH;
+	}
+	out->h = y + rowHeight > 0 ? y + rowHeight : 1;
+	out->coverage = calloc((size_t)out->w * out->h, 1);
+
+	// Rasterising is the slow part, big ranges like CJK get every core
+	int threadCount = SDL_GetCPUCount() > 1 ? SDL_GetCPUCount() : 1;
+	if (threadCount > (drawnCount + 63) / 64)
+		threadCount = (drawnCount + 63) / 64;
+	if (threadCount > 1) {
+		SDL_Thread **threads = malloc(sizeof(SDL_Thread *) * threadCount);
+		for (int i = 0; i < threadCount; i++)
+			threads[i] = SDL_CreateThread(_vksk_FontBakeWorker, "FontBakeWorker", &state);
+		for (int i = 0; i < threadCount; i++)
+			SDL_WaitThread(threads[i], NULL);
+		free(threads);
+	} else {
+		_vksk_FontBakeWorker(&state);
+	}
+	free(state.glyphIndices);
+	free(state.sizes);
+	free(yOffsets);
+
+	if (cacheDirectory != NULL)
+		_vksk_FontCacheSave(cacheDirectory, path, &header, out);
+	return true;
+}
+
+void vksk_BakedFontFree(VKSK_BakedFont *font) {
+	free(font->coverage);
+	free(font->glyphs);
+	font->coverage = NULL;
+	font->glyphs = NULL;
+}
@@ -0,0 +1,33 @@
+/// \file FontBaker.h
+/// \author Paolo Mazzon
+/// \brief Rasterises TrueType fonts into glyph atlases, caching them on disk between launches
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// Where a glyph is in the atlas, same meaning as JUCharacter
+typedef struct VKSK_BakedGlyph {
+	float x, y, w, h;
+	float ykern;
+	bool drawn; // False for glyphs with width but nothing to draw, like space
+} VKSK_BakedGlyph;
+
+// A font's glyphs rasterised into one atlas
+typedef struct VKSK_BakedFont {
+	int w, h;                // Size of the atlas
+	uint8_t *coverage;       // w * h bytes of how much each pixel is covered by a glyph, 0 to 255
+	float newLineHeight;
+	int unicodeStart;        // First code point in the atlas
+	int unicodeEnd;          // Last code point in the atlas (inclusive)
+	VKSK_BakedGlyph *glyphs; // One for each code point from unicodeStart to unicodeEnd
+} VKSK_BakedFont;
+
+// Rasterises every code point from `unicodeStart` to `unicodeEnd` (inclusive) of a TrueType font at `size` pixels
+// high on a thread per core. Without `aa`, pixels that are barely covered are left out. If `cacheDirectory` isn't
+// NULL the atlas is loaded from there if the same font was baked with the same settings before, and saved there
+// once it's baked otherwise. Returns false if the font couldn't be read, the atlas must be freed with
+// vksk_BakedFontFree otherwise.
+bool vksk_FontBake(const uint8_t *ttf, int ttfSize, float size, bool aa, int unicodeStart, int unicodeEnd, const char *cacheDirectory, VKSK_BakedFont *out);
+
+// Frees an atlas from vksk_FontBake
+void vksk_BakedFontFree(VKSK_BakedFont *font);
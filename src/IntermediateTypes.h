@@ -36,9 +36,35 @@ extern const uint64_t FOREIGN_HITBOX;
 extern const uint64_t FOREIGN_SHADOW;
 extern const uint64_t FOREIGN_LIGHT_SOURCE;
 
+// A page of the texture atlas the asset compiler packed textures into, every texture on it holds a reference
+typedef struct _vksk_AtlasPage {
+	VK2DTexture tex;
+	VK2DImage image;
+	int references;
+} _vksk_AtlasPage;
+
+// Where a texture is on its atlas page, transparent borders are trimmed off so only part of it is really there
+typedef struct _vksk_TextureRegion {
+	_vksk_AtlasPage *page; // NULL if the texture isn't in an atlas
+	float x, y;            // Top-left of what was kept, in the page
+	float trimX, trimY;    // Top-left of what was kept, in the original image
+	float trimW, trimH;    // Size of what was kept
+	float w, h;            // Size of the original image
+} _vksk_TextureRegion;
+
+// Smaller copies of a texture loaded from a mip chain (see TextureFormat.h), freed with the texture they belong to
+typedef struct _vksk_MipChain {
+	VK2DTexture base;    // Level 0
+	VK2DTexture *levels; // Level i is levels[i - 1], each half the size of the one before it
+	int count;           // Not counting the base
+} _vksk_MipChain;
+
 // To protect Textures from garbage collection kinda
 typedef struct _vksk_RuntimeTexture {
-	VK2DTexture tex;
+	VK2DTexture tex; // The page's texture for textures in an atlas
+	_vksk_TextureRegion region;
+	_vksk_MipChain *mips; // NULL if the texture doesn't have one
+	bool mipmaps;         // Whether to draw from the mip chain when scaled down
 }_vksk_RuntimeTexture;
 
 // For the renderer lighting system internally
@@ -77,6 +103,7 @@ typedef struct _vksk_RuntimeBuffer {
 typedef struct _vksk_RuntimeSprite {
 	JUSprite spr;
 	VK2DTexture tex;
+	_vksk_TextureRegion region; // Region of the texture it was made from, cells are relative to the original image
 } _vksk_RuntimeSprite;
 
 typedef struct _vksk_RuntimeShader {
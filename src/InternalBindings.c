@@ -19,12 +19,17 @@
 #include "src/IntermediateTypes.h"
 #include "src/Runtime.h"
 #include "src/Util.h"
+#include "src/FontBaker.h"
+#include "src/JUTypes.h"
+#include "src/VK2DTypes.h"
 
 static const double NO_MORE_LAYERS = 0;
 static const double TILE_LAYER = 1;
 static const double OBJECT_LAYER = 2;
 
-extern uint32_t rmask, gmask, bmask, amask;
+extern VKSK_EngineConfig gEngineConfig;
+
+#define FONT_CACHE_DIRECTORY "font_cache" // Where fonts are cached between launches, see FontBaker.h
 
 typedef struct _VKSK_GamepadInputs {
 	bool inputs[15];
@@ -115,6 +120,7 @@ void vksk_RuntimeFileRead(WrenVM *vm) {
 void vksk_RuntimeFileReadFromPak(WrenVM *vm) {
 	VALIDATE_FOREIGN_ARGS(vm, FOREIGN_STRING, FOREIGN_END)
 	const char *fname = wrenGetSlotString(vm, 1);
+	vksk_TraceFileAccess(fname);
 	if (!vksk_PakFileExists(gGamePak, fname)) {
 		wrenSetSlotNull(vm, 0);
 	} else {
@@ -218,10 +224,9 @@ void vksk_RuntimeFileGetDirectory(WrenVM *vm) {
 void vksk_RuntimeTiledAllocate(WrenVM *vm) {
 	VALIDATE_FOREIGN_ARGS(vm, FOREIGN_STRING, FOREIGN_END)
 	VKSK_RuntimeForeign *tiled = wrenSetSlotNewForeign(vm, 0, 0, sizeof(struct VKSK_RuntimeForeign));
-	int size;
-	void *buffer = vksk_GetFileBuffer(wrenGetSlotString(vm, 1), &size);
-	if (buffer != NULL) {
-		tiled->tiled.map = cute_tiled_load_map_from_memory(buffer, size, NULL);
+	VKSK_FileView view;
+	if (vksk_GetFileView(wrenGetSlotString(vm, 1), &view)) {
+		tiled->tiled.map = cute_tiled_load_map_from_memory(view.data, view.size, NULL);
 		tiled->tiled.layer = NULL;
 		tiled->type = FOREIGN_TILED_MAP;
 		fflush(stdout);
@@ -230,7 +235,7 @@ void vksk_RuntimeTiledAllocate(WrenVM *vm) {
 			vksk_Error(false, "Failed to load Tiled map '%s'", wrenGetSlotString(vm, 1));
 			wrenSetSlotNull(vm, 0);
 		}
-		free(buffer);
+		vksk_ReleaseFileView(&view);
 	} else {
 		vksk_Error(false, "Failed to load Tiled map '%s'", wrenGetSlotString(vm, 1));
 		wrenSetSlotNull(vm, 0);
@@ -486,6 +491,7 @@ void vksk_RuntimeBufferOpenFromPak(WrenVM *vm) {
 	buffer->buffer.size = 0;
 	const char *fname = wrenGetSlotString(vm, 1);
 
+	vksk_TraceFileAccess(fname);
 	if (vksk_PakFileExists(gGamePak, fname)) {
 		buffer->buffer.data = (void*)vksk_PakGetFile(gGamePak, fname, &buffer->buffer.size);
 	}
@@ -1007,21 +1013,6 @@ void vksk_RuntimeControllerName(WrenVM *vm) {
 	}
 }
 
-static inline uint32_t *alphaToRGBA(uint8_t *pixels, int w, int h, bool aa) {
-	uint32_t *out = calloc(1, w * h * sizeof(uint32_t));
-	for (int i = 0; i < w * h; i++) {
-		if (pixels[i] > 0) {
-			uint32_t t = pixels[i];
-			uint32_t alpha = amask == 0xff000000 ? t << 24 : pixels[i];
-			if (aa || (!aa && pixels[i] > 50))
-				out[i] = rmask + gmask + bmask + (amask & alpha);
-		}
-	}
-
-	free(pixels);
-	return (void*)out;
-}
-
 void vksk_RuntimeFontAllocate(WrenVM *vm) {
 	VALIDATE_FOREIGN_ARGS(vm, FOREIGN_STRING, FOREIGN_NUM, FOREIGN_BOOL, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_END)
 	VKSK_RuntimeForeign *font = wrenSetSlotNewForeign(vm, 0, 0, sizeof(VKSK_RuntimeForeign));
@@ -1034,98 +1025,33 @@ void vksk_RuntimeFontAllocate(WrenVM *vm) {
 	int uniEnd = wrenGetSlotDouble(vm, 5);
 	bool error = false;
 
-	// Load initial font data
-	int bufferSize, lineGap, ascent, descent;
-	void *fntData = vksk_GetFileBuffer(filename, &bufferSize);
-	if (fntData != NULL) {
-		stbtt_fontinfo info = {0};
-		if (stbtt_InitFont(&info, fntData, 0)) {
-			float scale = stbtt_ScaleForPixelHeight(&info, size);
-			stbtt_GetFontVMetrics(&info, &ascent, &descent, &lineGap);
-			font->bitmapFont->newLineHeight = (ascent * scale) - (descent * scale) + (lineGap * scale);
+	// Glyphs are rasterised on every core, or loaded from the cache if this font was baked on a previous launch
+	VKSK_FileView fntData;
+	if (vksk_GetFileView(filename, &fntData)) {
+		VKSK_BakedFont baked;
+		if (vksk_FontBake(fntData.data, fntData.size, size, aa, uniStart, uniEnd, gEngineConfig.disableFontCache ? NULL : FONT_CACHE_DIRECTORY, &baked)) {
+			font->bitmapFont->newLineHeight = baked.newLineHeight;
 			font->bitmapFont->unicodeStart = uniStart;
 			font->bitmapFont->unicodeEnd = uniEnd;
-			float spaceSize = font->bitmapFont->newLineHeight / 2;
-
-			// Calculate space size
-			float average = 0;
-			int count = 0;
-            for (int i = 0; i <= (uniEnd - uniStart); i++) {
-                int codePoint = i + uniStart;
-                int x0, y0, x1, y1;
-                stbtt_GetCodepointBox(&info, codePoint, &x0, &y0, &x1, &y1);
-                if (stbtt_IsGlyphEmpty(&info, stbtt_FindGlyphIndex(&info, codePoint)) == 0) {
-                    average += (x1 * scale) - (x0 * scale);
-                    count++;
-                }
-            }
-            spaceSize = (average / count) * 0.5;
-
-			// Calculate the width and height of the image we'll need
 			font->bitmapFont->characters = calloc(uniEnd - uniStart + 1, sizeof(struct JUCharacter));
-			float w = 0;
-			float h = 0;
-			for (int i = 0; i <= (uniEnd - uniStart); i++) {
-				int codePoint = i + uniStart;
-				int x0, y0, x1, y1;
-				JUCharacter *c = &font->bitmapFont->characters[i];
-				stbtt_GetCodepointBox(&info, codePoint, &x0, &y0, &x1, &y1);
-				if (stbtt_IsGlyphEmpty(&info, stbtt_FindGlyphIndex(&info, codePoint)) == 0) {
-					c->w = (x1 * scale) - (x0 * scale);
-					c->h = (y1 * scale) - (y0 * scale) + 2;
-					c->x = w;
-					c->drawn = true;
-				} else {
-					c->w = spaceSize;
-					c->h = 0;
-					c->x = w;
-					c->drawn = false;
-				}
-				w += c->w + 4;
-				if (h < c->h) h = c->h;
-			}
-			SDL_Surface *bitmap = SDL_CreateRGBSurface(0, w, h, 32, rmask, gmask, bmask, amask);
-			VALIDATE_SDL(bitmap)
-
-			for (int i = 0; i <= (uniEnd - uniStart); i++) {
-				JUCharacter *c = &font->bitmapFont->characters[i];
-				c->w += 1;
-			}
-
-			// Draw each glyph to the surface
 			for (int i = 0; i <= (uniEnd - uniStart); i++) {
-				int codePoint = i + uniStart;
 				JUCharacter *c = &font->bitmapFont->characters[i];
-				if (c->drawn) {
-					c->ykern = c->h;
-					int xoff, yoff, width, height;
-					uint8_t *alpha = stbtt_GetCodepointBitmap(&info, scale, scale, codePoint, &width, &height, &xoff,
-															  &yoff);
-					uint32_t *pixels = alphaToRGBA(alpha, width, height, aa);
-					SDL_Surface *temp = SDL_CreateRGBSurfaceFrom(pixels, width, height, 32, 4 * width, rmask, gmask,
-																 bmask,
-																 amask);
-					VALIDATE_SDL(temp)
-					c->ykern = ((-(float) ascent * scale) + yoff) + ((ascent * scale) * 2);
-					SDL_Rect dst = {c->x, c->y, width, height};
-					if (SDL_BlitSurface(temp, NULL, bitmap, &dst) < 0)
-					    vksk_Log("Failed to copy character u%i", codePoint);
-					SDL_FreeSurface(temp);
-					free(pixels);
-				}
+				c->x = baked.glyphs[i].x;
+				c->y = baked.glyphs[i].y;
+				c->w = baked.glyphs[i].w;
+				c->h = baked.glyphs[i].h;
+				c->ykern = baked.glyphs[i].ykern;
+				c->drawn = baked.glyphs[i].drawn;
 			}
 
-			// Create image and texture from surface
-			SDL_LockSurface(bitmap);
-			font->bitmapFont->image = vk2dImageFromPixels(vk2dRendererGetDevice(), bitmap->pixels, bitmap->w,
-														  bitmap->h, true);
-			SDL_UnlockSurface(bitmap);
-			SDL_FreeSurface(bitmap);
-			font->bitmapFont->bitmap = vk2dTextureLoadFromImage(font->bitmapFont->image);
+			// Glyphs are white so the colour mod colours them, the atlas is widened to RGBA for the upload like before
+			font->bitmapFont->image = NULL;
+			font->bitmapFont->bitmap = vksk_TextureFromCoverage(baked.coverage, baked.w, baked.h);
+			vksk_BakedFontFree(&baked);
 		} else {
 			error = true;
 		}
-		free(fntData);
+		vksk_ReleaseFileView(&fntData);
 	} else {
 		error = true;
 	}
@@ -1138,8 +1064,7 @@ void vksk_RuntimeFontAllocate(WrenVM *vm) {
 void vksk_RuntimeFontFinalize(void *data) {
 	VKSK_RuntimeForeign *font = data;
 	vk2dRendererWait();
-	vk2dImageFree(vk2dTextureGetImage(font->bitmapFont->bitmap));
-	juFontFree(font->bitmapFont);
+	vksk_BitmapFontFree(font->bitmapFont);
 }
 
 void vksk_RuntimeFontSize(WrenVM *vm) {
@@ -1158,7 +1083,6 @@ void vksk_RuntimeFontSize(WrenVM *vm) {
 void vksk_RuntimeFontFree(WrenVM *vm) {
 	VKSK_RuntimeForeign *font = wrenGetSlotForeign(vm, 0);
 	vk2dRendererWait();
-	vk2dImageFree(vk2dTextureGetImage(font->bitmapFont->bitmap));
-	juFontFree(font->bitmapFont);
+	vksk_BitmapFontFree(font->bitmapFont);
 	font->bitmapFont = NULL;
 }
\ No newline at end of file
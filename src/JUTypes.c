@@ -12,18 +12,28 @@
 #include "src/JUTypes.h"
 #include "src/IntermediateTypes.h"
 #include "src/Util.h"
+#include "src/AssetDecoder.h"
+#include "src/VK2DTypes.h"
 
 /********************* Bitmap Fonts *********************/
+void vksk_BitmapFontFree(JUFont font) {
+	if (font != NULL) {
+		VK2DTexture tex = font->bitmap;
+		font->bitmap = NULL;
+		juFontFree(font);
+		vksk_TextureFree(tex);
+	}
+}
+
 void vksk_RuntimeJUBitmapFontAllocate(WrenVM *vm) {
 	VALIDATE_FOREIGN_ARGS(vm, FOREIGN_STRING, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_END)
 	VKSK_RuntimeForeign *font = wrenSetSlotNewForeign(vm, 0, 0, sizeof(VKSK_RuntimeForeign));
 	bool error = false;
 
 	VK2DTexture tex;
-	int size;
-	void *buffer = vksk_GetFileBuffer(wrenGetSlotString(vm, 1), &size);
-	if (buffer != NULL) {
-		tex = vk2dTextureFrom(buffer, size);
+	VKSK_FileView view;
+	if (vksk_GetFileView(wrenGetSlotString(vm, 1), &view)) {
+		tex = vksk_TextureFromFileData(view.data, view.size, false);
 
 		if (tex != NULL) {
 			font->bitmapFont = juFontLoadFromTexture(
@@ -37,7 +47,7 @@ void vksk_RuntimeJUBitmapFontAllocate(WrenVM *vm) {
 		} else {
 			error = true;
 		}
-		free(buffer);
+		vksk_ReleaseFileView(&view);
 	} else {
 		error = true;
 	}
@@ -50,7 +60,7 @@ void vksk_RuntimeJUBitmapFontAllocate(WrenVM *vm) {
 void vksk_RuntimeJUBitmapFontFinalize(void *data) {
 	VKSK_RuntimeForeign *font = data;
 	vk2dRendererWait();
-	juFontFree(font->bitmapFont);
+	vksk_BitmapFontFree(font->bitmapFont);
 }
 
 void vksk_RuntimeJUBitmapFontSize(WrenVM *vm) {
@@ -109,7 +119,7 @@ void vksk_RuntimeJUBitmapFontSizeExtWrapped(WrenVM *vm) {
 void vksk_RuntimeJUBitmapFontFree(WrenVM *vm) {
 	VKSK_RuntimeForeign *font = wrenGetSlotForeign(vm, 0);
 	vk2dRendererWait();
-	juFontFree(font->bitmapFont);
+	vksk_BitmapFontFree(font->bitmapFont);
 	font->bitmapFont = NULL;
 }
 
@@ -118,18 +128,18 @@ void vksk_RuntimeJUSpriteAllocate(WrenVM *vm) {
 	VALIDATE_FOREIGN_ARGS(vm, FOREIGN_STRING, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_END)
 	VKSK_RuntimeForeign *spr = wrenSetSlotNewForeign(vm, 0, 0, sizeof(VKSK_RuntimeForeign));
 	bool error = false;
+	spr->sprite.region.page = NULL;
 
 	const char *fname = wrenGetSlotString(vm, 1);
-	int size;
-	void *buffer = vksk_GetFileBuffer(fname, &size);
+	VKSK_FileView view;
 
-	if (buffer != NULL) {
-		spr->sprite.tex = vk2dTextureFrom(buffer, size);
+	if (vksk_GetFileView(fname, &view)) {
+		spr->sprite.tex = vksk_TextureFromFileData(view.data, view.size, false);
 		if (spr->sprite.tex == NULL) {
 			vksk_Error(false, "Failed to create texture for sprite \"%s\"", wrenGetSlotString(vm, 1));
 			error = true;
 		}
-		free(buffer);
+		vksk_ReleaseFileView(&view);
 	} else {
 		vksk_Error(false, "Failed to load sprite \"%s\"", wrenGetSlotString(vm, 1));
 		error = true;
@@ -154,17 +164,20 @@ void vksk_RuntimeJUSpriteAllocate(WrenVM *vm) {
 void vksk_RuntimeJUSpriteFinalize(void *data) {
 	VKSK_RuntimeForeign *spr = data;
 	vk2dRendererWait();
-	vk2dTextureFree(spr->sprite.tex);
+	vksk_TextureFree(spr->sprite.tex);
 	juSpriteFree(spr->sprite.spr);
+	vksk_AtlasPageRelease(spr->sprite.region.page);
 }
 
 void vksk_RuntimeJUSpriteFree(WrenVM *vm) {
 	VKSK_RuntimeForeign *spr = wrenGetSlotForeign(vm, 0);
 	vk2dRendererWait();
 	juSpriteFree(spr->sprite.spr);
-	vk2dTextureFree(spr->sprite.tex);
+	vksk_TextureFree(spr->sprite.tex);
+	vksk_AtlasPageRelease(spr->sprite.region.page);
 	spr->sprite.tex = NULL;
 	spr->sprite.spr = NULL;
+	spr->sprite.region.page = NULL;
 }
 
 void vksk_RuntimeJUSpriteCopy(WrenVM *vm) {
@@ -172,9 +185,13 @@ void vksk_RuntimeJUSpriteCopy(WrenVM *vm) {
 	wrenGetVariable(vm, "lib/Drawing", "Sprite", 0);
 	VKSK_RuntimeForeign *newspr = wrenSetSlotNewForeign(vm, 0, 0, sizeof(VKSK_RuntimeForeign));
 	newspr->sprite.spr = juSpriteCopy(spr->sprite.spr);
+	newspr->sprite.region.page = NULL;
 	if (newspr->sprite.spr != NULL) {
 		newspr->sprite.tex = NULL;
 		newspr->type = FOREIGN_SPRITE;
+		newspr->sprite.region = spr->sprite.region;
+		if (newspr->sprite.region.page != NULL)
+			newspr->sprite.region.page->references++;
 	} else {
 		wrenSetSlotNull(vm, 0);
 		vksk_Error(false, "Failed to copy sprite.");
@@ -193,6 +210,7 @@ void vksk_RuntimeJUSpriteFrom(WrenVM *vm) {
 	wrenGetVariable(vm, "lib/Drawing", "Sprite", 0);
 	VKSK_RuntimeForeign *newspr = wrenSetSlotNewForeign(vm, 0, 0, sizeof(VKSK_RuntimeForeign));
 	newspr->sprite.tex = NULL;
+	newspr->sprite.region.page = NULL;
 	newspr->sprite.spr = juSpriteFrom(
 			tex->type == FOREIGN_SURFACE ? tex->surface : tex->texture.tex,
 			x,
@@ -205,6 +223,10 @@ void vksk_RuntimeJUSpriteFrom(WrenVM *vm) {
 	if (newspr->sprite.spr == NULL) {
 		wrenSetSlotNull(vm, 0);
 		vksk_Error(false, "Failed to create sprite from texture.");
+	} else if (tex->type == FOREIGN_TEXTURE && tex->texture.region.page != NULL) {
+		// Cells stay in the original image's coordinates and get mapped onto the page when drawn
+		newspr->sprite.region = tex->texture.region;
+		newspr->sprite.region.page->references++;
 	}
 }
 
@@ -314,22 +336,36 @@ void vksk_RuntimeJUAudioDataAllocate(WrenVM *vm) {
 	VKSK_RuntimeForeign *snd = wrenSetSlotNewForeign(vm, 0, 0, sizeof(VKSK_RuntimeForeign));
 	const char *fname = wrenGetSlotString(vm, 1);
 	const char *ext = strrchr(fname, '.');
-	int size;
-	void *buffer = vksk_GetFileBuffer(fname, &size);
-	if (buffer != NULL) {
+	snd->type = FOREIGN_AUDIO_DATA;
+
+	// Files with the same contents in game.pak share one decoded sound
+	uint64_t blob = vksk_GetFileBlobID(fname);
+	snd->audioData = vksk_AssetCacheGet(FOREIGN_AUDIO_DATA, blob);
+	if (snd->audioData != NULL)
+		return;
+
+	// Assets.load_assets decodes sounds ahead of time on other threads
+	snd->audioData = vksk_TakeDecodedSound(fname);
+	if (snd->audioData != NULL) {
+		vksk_AssetCacheAdd(FOREIGN_AUDIO_DATA, blob, snd->audioData);
+		return;
+	}
+
+	VKSK_FileView view;
+	if (vksk_GetFileView(fname, &view)) {
 		if (strcmp(ext, ".wav") == 0) {
 			snd->audioData = malloc(sizeof(struct JUSound));
-			cs_read_mem_wav(buffer, size, &snd->audioData->sound);
+			cs_read_mem_wav(view.data, view.size, &snd->audioData->sound);
 			memset(&snd->audioData->soundInfo, 0, sizeof(snd->audioData->soundInfo));
 		} else if (strcmp(ext, ".ogg") == 0) {
 			snd->audioData = malloc(sizeof(struct JUSound));
-			cs_read_mem_ogg(buffer, size, &snd->audioData->sound);
+			cs_read_mem_ogg(view.data, view.size, &snd->audioData->sound);
 			memset(&snd->audioData->soundInfo, 0, sizeof(snd->audioData->soundInfo));
 		} else {
 			snd->audioData = NULL;
 			vksk_Error(false, "Unrecognized sound file type for file \"%s\"", fname);
 		}
-		free(buffer);
+		vksk_ReleaseFileView(&view);
 	} else {
 		vksk_Error(false, "Failed to load audio file \"%s\"", fname);
 	}
@@ -337,18 +373,19 @@ void vksk_RuntimeJUAudioDataAllocate(WrenVM *vm) {
 	if (cs_error_reason != NULL) {
 		vksk_Error(false, "Error loading '%s', %s", wrenGetSlotString(vm, 1), cs_error_reason);
 	}
-
-	snd->type = FOREIGN_AUDIO_DATA;
+	vksk_AssetCacheAdd(FOREIGN_AUDIO_DATA, blob, snd->audioData);
 }
 
 void vksk_RuntimeJUAudioDataFinalize(void *data) {
 	VKSK_RuntimeForeign *d = data;
-	juSoundFree(d->audioData);
+	if (d->audioData != NULL && vksk_AssetCacheRelease(d->audioData))
+		juSoundFree(d->audioData);
 }
 
 void vksk_RuntimeJUAudioDataFree(WrenVM *vm) {
-	VKSK_RuntimeForeign *snd = wrenGetSlotForeign(vm, 1);
-	juSoundFree(snd->audioData);
+	VKSK_RuntimeForeign *snd = wrenGetSlotForeign(vm, 0);
+	if (snd->audioData != NULL && vksk_AssetCacheRelease(snd->audioData))
+		juSoundFree(snd->audioData);
 	snd->audioData = NULL;
 }
 
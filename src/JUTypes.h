@@ -3,6 +3,10 @@
 /// \brief JamUtil types
 #pragma once
 #include <wren.h>
+#include "src/JamUtil.h"
+
+// Frees a font whose texture may own its image (see vksk_TextureFromFileData), which juFontFree doesn't know about
+void vksk_BitmapFontFree(JUFont font);
 
 void vksk_RuntimeJUBitmapFontAllocate(WrenVM *vm);
 void vksk_RuntimeJUBitmapFontFinalize(void *data);
@@ -10,11 +10,60 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/uio.h>
+#endif
 
 #include "src/Packer.h"
+#include "src/Compression.h"
+#include "src/Checksum.h"
 
 /*
- * .pak file specification
+ * .pak file specification (version 2)
+ *
+ * All numbers are little-endian. The top of a .pak file is the header, which contains
+ *  + 8 bytes for the magic "ASTROPAK"
+ *  + 4 bytes for the version (2)
+ *  + 4 bytes for the file count
+ *  + 8 bytes for the offset of the index
+ *  + 8 bytes for the size of the index
+ *  + 4 bytes for the size of each record in the index not counting its filename (call it r)
+ *  + 4 reserved bytes
+ * After the header each file's data is placed at an offset aligned to VKSK_PAK_ALIGNMENT. The index
+ * comes after all of the data and has the following for each file
+ *  + 8 bytes for the offset of the file's data in the .pak file
+ *  + 8 bytes for how many bytes the data takes up in the .pak
+ *  + 8 bytes for the size of the file once loaded
+ *  + 4 bytes of flags (VKSK_PAK_ENTRY_*)
+ *  + 4 bytes for the length of the filename (call it x)
+ *  + 8 bytes for a hash of the file's contents (see _vksk_HashBytes)
+ *  + 8 bytes for the modification time of the file when it was packed
+ *  + 4 bytes for the CRC32C of the file's stored data (only if VKSK_PAK_ENTRY_CHECKSUM is set)
+ *  + 4 reserved bytes
+ *  + r - 56 bytes of fields newer versions may add, loaders skip what they don't know
+ *  + x bytes for the file's name (no terminating 0, loader does that)
+ * Files with identical contents share one copy of the data, so several records may have the same offset.
+ * Packer may append new data and a new index after an old one and point the header at the new index, so
+ * not every byte of a pak is necessarily referenced by its index.
+ * Compressed files are split into VKSK_PAK_BLOCK_SIZE blocks (the last may be smaller), each stored as
+ *  + 4 bytes for the stored length of the block, the top bit is set if the block is stored raw
+ *  + the block compressed with vksk_LZCompress or raw
+ * A pak can also be appended to the end of an executable (see vksk_PakEmbed), in which case every offset is
+ * from the start of the pak and the executable ends with a trailer of
+ *  + 8 bytes for the offset of the pak in the executable
+ *  + 8 bytes for the magic "ASTROEMB"
+ *
+ * .pak file specification (version 1, still loaded but no longer written)
  *
  * The top of a .pak file is the header, which contains the following information
  *  + 4 bytes for the endianness of the file (SDL macros)
@@ -27,34 +76,96 @@
  *  + After the header, the contents of each is placed at its specified offset
  */
 
+#define VKSK_PAK_MAGIC "ASTROPAK"
+#define VKSK_PAK_EMBED_MAGIC "ASTROEMB"
+#define VKSK_PAK_TRAILER_SIZE 16
+#define VKSK_PAK_VERSION 2
+#define VKSK_PAK_HEADER_SIZE 40
+#define VKSK_PAK_RECORD_SIZE 56
+#define VKSK_PAK_MIN_RECORD_SIZE 32 // Records smaller than this are missing required fields
+#define VKSK_PAK_ALIGNMENT 16
+#define VKSK_PAK_BLOCK_SIZE 65536
+#define VKSK_PAK_BLOCK_RAW 0x80000000u
+#define VKSK_PAK_ENTRY_COMPRESSED 1
+#define VKSK_PAK_ENTRY_CHECKSUM 2 // The record's checksum is valid, paks from before checksums don't have one
+#define VKSK_PAK_HASH_SEED 0x41535452u
+#define VKSK_PAK_BATCH_GAP 65536            // Batched reads read through gaps up to this big between files
+#define VKSK_PAK_BATCH_MAX_RUN (16 * 1048576) // Most bytes a single batched read will cover
+#define VKSK_PAK_BATCH_MAX_FILES 256       // Most files in one batched read, each needs up to 2 iovecs
+
 // Paks are not r/w compatible, one or the other
 typedef enum {
 	PAK_TYPE_READ = 1,
 	PAK_TYPE_WRITE = 2,
+	PAK_TYPE_LAYERED = 3,   // Merged index over other paks, see vksk_PakMount
+	PAK_TYPE_DIRECTORY = 4, // Loose files in a directory, filenames are relative to it
 } VKSK_PakType;
 
 typedef struct VKSK_PakFileInfo {
 	const char *filename;
-	int size;
-	int pointer;
+	const char *source;  // Where a file being packed is read from if not from filename (see vksk_PakConvertFiles)
+	uint64_t size;       // Size of the file once its loaded
+	uint64_t storedSize; // How many bytes it takes up in the pak, only differs from size if its compressed
+	uint64_t pointer;
+	uint64_t contentHash;
+	int64_t mtime;
+	uint32_t flags;
+	uint32_t hash;
+	uint32_t checksum; // CRC32C of the stored data
+	SDL_atomic_t verified; // Non-zero once the checksum was checked, entries are checked the first time they're loaded
+	int layer; // Which layer of a layered pak this file comes from
 } VKSK_PakFileInfo;
 
+// A directory in a read pak, its files and sub-directories are contiguous ranges of the sorted tables
+typedef struct VKSK_PakDirNode {
+	const char *path; // Full path ending in '/', the root directory is ""
+	int firstChild;   // Sub-directories in VKSK_PakHeader::dirs
+	int childCount;
+	int firstFile;    // Files directly in this directory in VKSK_PakHeader::sortedFiles
+	int fileCount;
+} VKSK_PakDirNode;
+
 typedef struct VKSK_PakHeader {
 	VKSK_PakFileInfo *files;
 	int fileCount;
 	int endian;
+	int version;
+	uint64_t dataEnd;  // Where the last thing in the pak (its index) ends
+	char *stringArena; // Read paks keep every filename in this one block instead of a malloc per name
+	int *hashTable;    // Open addressed (linear probe) indices into files, -1 means the slot is empty
+	int hashTableSize; // Always a power of 2
+	int *sortedFiles;  // Indices into files sorted by directory and then name
+	VKSK_PakDirNode *dirs; // Sorted the same way so each directory's children are next to each other, root is first
+	int dirCount;
+	char *dirArena;    // Directory paths
 } VKSK_PakHeader;
 
 struct VKSK_Pak {
 	VKSK_PakType type;
 	VKSK_PakHeader header;
-	const char *filename;
+	const char *filename;   // For directory paks this is the directory
+	const uint8_t *mapping; // Entire pak file if it was loaded with vksk_PakLoadMapped, NULL otherwise
+	uint64_t base;          // Where the pak starts in its file, only non-zero for paks embedded in an executable
+	VKSK_Pak *layers;       // Layered paks only, in order of priority from lowest to highest
+	int layerCount;
+	size_t mappingSize;
+#ifdef _WIN32
+	HANDLE fileHandle; // Kept open for the lifetime of a read pak
+	HANDLE mappingHandle;
+#else
+	int fd; // Kept open for the lifetime of a read pak
+#endif
 };
 
 static VKSK_Pak _vksk_PakMakeEmpty(VKSK_PakType type) {
 	VKSK_Pak pak = calloc(1, sizeof(struct VKSK_Pak));
 	pak->header.endian = SDL_BYTEORDER;
 	pak->type = type;
+#ifdef _WIN32
+	pak->fileHandle = INVALID_HANDLE_VALUE;
+#else
+	pak->fd = -1;
+#endif
 	return pak;
 }
 
@@ -66,84 +177,106 @@ static const char *_vksk_CopyString(const char *string) {
 	return s;
 }
 
-// Returns how many /'s are in a path
-static int _vksk_DirectoriesDeep(const char *path) {
-	int deep = 0;
-	while (*path != 0) {
-		if (*path == '/')
-			deep += 1;
-		path++;
-	}
-	return deep;
+static uint32_t _vksk_GetU32(const uint8_t *p) {
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
 }
 
-// Copies a directory name given how many deep in the path to copy, so "assets/test/thing" with a dirsDeep of 2 would
-// give "assets/test/". Copies into buffer and returns it.
-static const char *_vksk_CopyDirectoryXDeep(const char *path, int dirsDeep, char *buffer, int bufferSize) {
-	if (dirsDeep == 0) {
-		buffer[0] = 0;
-	} else {
-		int i;
-		for (i = 0; i < bufferSize - 1 && path[i] != 0 && dirsDeep > 0; i++) {
-			buffer[i] = path[i];
-			if (path[i] == '/')
-				dirsDeep -= 1;
-		}
-		buffer[i] = 0;
-	}
-	return buffer;
+static uint64_t _vksk_GetU64(const uint8_t *p) {
+	return _vksk_GetU32(p) | ((uint64_t)_vksk_GetU32(p + 4) << 32);
 }
 
-static unsigned char* _vksk_LoadFileRaw(const char *filename, int *size) {
-	FILE* file = fopen(filename, "rb");
-	unsigned char *buffer = NULL;
-	*size = 0;
+static void _vksk_PutU32(uint8_t *p, uint32_t val) {
+	for (int i = 0; i < 4; i++)
+		p[i] = (val >> (i * 8)) & 0xFF;
+}
 
-	if (file != NULL) {
-		// Find file size
-		fseek(file, 0, SEEK_END);
-		*size = ftell(file);
-		rewind(file);
+static void _vksk_PutU64(uint8_t *p, uint64_t val) {
+	_vksk_PutU32(p, val & 0xFFFFFFFF);
+	_vksk_PutU32(p + 4, val >> 32);
+}
 
-		buffer = malloc(*size);
+static uint64_t _vksk_HashMix(uint64_t h) {
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDull;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ull;
+	h ^= h >> 33;
+	return h;
+}
 
-		if (buffer != NULL) {
-			// Fill the buffer
-			fread(buffer, 1, *size, file);
-		}
-		fclose(file);
+// 64-bit content hash, 8 bytes at a time. Whole files are hashed by feeding each block's hash back in as the
+// seed of the next so blocks can be hashed on different threads.
+static uint64_t _vksk_HashBytes(const uint8_t *data, size_t size, uint64_t seed) {
+	uint64_t h = seed ^ (size * 0x9E3779B97F4A7C15ull);
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		h ^= _vksk_HashMix(_vksk_GetU64(data + i));
+		h = ((h << 27) | (h >> 37)) * 0x9E3779B97F4A7C15ull + 0x52DCE729;
+	}
+	if (i < size) {
+		uint8_t tail[8] = {0};
+		memcpy(tail, data + i, size - i);
+		h ^= _vksk_HashMix(_vksk_GetU64(tail));
 	}
+	return _vksk_HashMix(h);
+}
 
-	return (unsigned char*)buffer;
+static uint64_t _vksk_HashCombine(uint64_t hash, uint64_t blockHash) {
+	uint8_t bytes[8];
+	_vksk_PutU64(bytes, blockHash);
+	return _vksk_HashBytes(bytes, 8, hash);
 }
 
-static int _vksk_FileSize(const char *filename) {
-	int size = 0;
-	FILE *f = fopen(filename, "rb");
-	fseek(f, 0, SEEK_END);
-	size = ftell(f);
-	fclose(f);
-	return size;
+// Files that are already compressed aren't worth running through the compressor again
+static bool _vksk_PakShouldCompress(const char *filename) {
+	static const char *skip[] = {".png", ".jpg", ".jpeg", ".ogg", ".zip", ".gz"};
+	const char *ext = strrchr(filename, '.');
+	if (ext == NULL)
+		return true;
+	for (int i = 0; i < sizeof(skip) / sizeof(skip[0]); i++)
+		if (SDL_strcasecmp(ext, skip[i]) == 0)
+			return false;
+	return true;
 }
 
-static int _vksk_CalculateHeaderSize(VKSK_Pak pak) {
-	int size = 0;
-	size += 4; // endianness
-	size += 4; // file count
-	for (int i = 0; i < pak->header.fileCount; i++) {
-		size += 12; // filename length, file size, file offset
-		size += strlen(pak->header.files[i].filename);
+// Decompresses a list of blocks that are already in memory straight into dst
+static bool _vksk_PakDecompressBlocks(const uint8_t *src, uint64_t srcSize, uint8_t *dst, uint64_t dstSize) {
+	uint64_t pos = 0;
+	for (uint64_t written = 0; written < dstSize;) {
+		if (srcSize - pos < 4)
+			return false;
+		uint32_t blockHeader = _vksk_GetU32(src + pos);
+		uint32_t storedLength = blockHeader & ~VKSK_PAK_BLOCK_RAW;
+		int blockSize = dstSize - written > VKSK_PAK_BLOCK_SIZE ? VKSK_PAK_BLOCK_SIZE : dstSize - written;
+		pos += 4;
+		if (storedLength > srcSize - pos)
+			return false;
+		if (blockHeader & VKSK_PAK_BLOCK_RAW) {
+			if (storedLength != blockSize)
+				return false;
+			memcpy(dst + written, src + pos, blockSize);
+		} else if (!vksk_LZDecompress(src + pos, storedLength, dst + written, blockSize)) {
+			return false;
+		}
+		pos += storedLength;
+		written += blockSize;
 	}
-	return size;
+	return true;
 }
 
-static void _vksk_AddHeaderInfo(VKSK_Pak pak, const char *file) {
+static void _vksk_AddHeaderInfo(VKSK_Pak pak, const char *file, uint64_t size, int64_t mtime) {
 	pak->header.files = realloc(pak->header.files, sizeof(VKSK_PakFileInfo) * (pak->header.fileCount + 1));
 	VKSK_PakFileInfo *info = &pak->header.files[pak->header.fileCount];
 	pak->header.fileCount += 1;
+	memset(info, 0, sizeof(VKSK_PakFileInfo));
 	info->filename = _vksk_CopyString(file);
-	info->pointer = 0;
-	info->size = _vksk_FileSize(file);
+	info->size = size;
+	info->mtime = mtime;
+}
+
+// Where the contents of a file being packed come from
+static const char *_vksk_PakSourceOf(const VKSK_PakFileInfo *info) {
+	return info->source != NULL ? info->source : info->filename;
 }
 
 static void _vksk_IterateDirectory(VKSK_Pak pak, const char *dir) {
@@ -161,11 +294,12 @@ static void _vksk_IterateDirectory(VKSK_Pak pak, const char *dir) {
 		struct stat stbuf ;
 		sprintf( filename_qfd , "%s/%s",dir,dp->d_name) ;
 		if( stat(filename_qfd,&stbuf ) == -1 ) {
+			dp = readdir(dfd);
 			continue;
 		}
 
 		if ((stbuf.st_mode & S_IFMT) != S_IFDIR) {
-			_vksk_AddHeaderInfo(pak, filename_qfd);
+			_vksk_AddHeaderInfo(pak, filename_qfd, stbuf.st_size, stbuf.st_mtime);
 		} else if (( stbuf.st_mode & S_IFMT ) == S_IFDIR) {
 			if (filename_qfd[strlen(filename_qfd) - 1] != '.') {
 				_vksk_IterateDirectory(pak, filename_qfd);
@@ -173,12 +307,323 @@ static void _vksk_IterateDirectory(VKSK_Pak pak, const char *dir) {
 		}
 		dp = readdir(dfd);
 	}
+	closedir(dfd);
+}
+
+// FNV-1a, filenames are short so this is plenty
+static uint32_t _vksk_HashString(const char *string) {
+	uint32_t hash = 2166136261u;
+	while (*string != 0) {
+		hash ^= (uint8_t)*string;
+		hash *= 16777619u;
+		string++;
+	}
+	return hash;
+}
+
+// Builds the hash table for a loaded pak, the table is kept at most half full so probes stay short
+static void _vksk_PakBuildIndex(VKSK_Pak pak) {
+	int tableSize = 16;
+	while (tableSize < pak->header.fileCount * 2)
+		tableSize *= 2;
+	pak->header.hashTableSize = tableSize;
+	pak->header.hashTable = malloc(sizeof(int) * tableSize);
+	memset(pak->header.hashTable, -1, sizeof(int) * tableSize);
+
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		VKSK_PakFileInfo *fileInfo = &pak->header.files[i];
+		fileInfo->hash = _vksk_HashString(fileInfo->filename);
+		int slot = fileInfo->hash & (tableSize - 1);
+		while (pak->header.hashTable[slot] != -1)
+			slot = (slot + 1) & (tableSize - 1);
+		pak->header.hashTable[slot] = i;
+	}
+}
+
+// Length of the directory part of a path including its slash, a trailing slash on the path itself is ignored so
+// directories give their parent directory -- "a/b/c" and "a/b/c/" both give 4
+static int _vksk_ParentLength(const char *path, int length) {
+	if (length > 0 && path[length - 1] == '/')
+		length--;
+	while (length > 0 && path[length - 1] != '/')
+		length--;
+	return length;
 }
 
-static bool _vksk_IsFromDirectory(const char *fname, const char *dir) {
-	if (strstr(fname, dir) == fname || dir[0] == 0)
+static int _vksk_CompareSpans(const char *a, int aLength, const char *b, int bLength) {
+	int c = memcmp(a, b, aLength < bLength ? aLength : bLength);
+	return c != 0 ? c : aLength - bLength;
+}
+
+// Orders paths by their parent directory and then by name, which keeps everything directly inside a directory together
+static int _vksk_ComparePaths(const char *a, int aLength, const char *b, int bLength) {
+	int aParent = _vksk_ParentLength(a, aLength);
+	int bParent = _vksk_ParentLength(b, bLength);
+	int c = _vksk_CompareSpans(a, aParent, b, bParent);
+	return c != 0 ? c : _vksk_CompareSpans(a + aParent, aLength - aParent, b + bParent, bLength - bParent);
+}
+
+static int _vksk_CompareFileInfos(const void *a, const void *b) {
+	const char *aName = (*(VKSK_PakFileInfo *const *)a)->filename;
+	const char *bName = (*(VKSK_PakFileInfo *const *)b)->filename;
+	return _vksk_ComparePaths(aName, strlen(aName), bName, strlen(bName));
+}
+
+typedef struct _vksk_PathSpan {
+	const char *path;
+	int length;
+} _vksk_PathSpan;
+
+static int _vksk_CompareSpansQsort(const void *a, const void *b) {
+	const _vksk_PathSpan *aSpan = a;
+	const _vksk_PathSpan *bSpan = b;
+	return _vksk_ComparePaths(aSpan->path, aSpan->length, bSpan->path, bSpan->length);
+}
+
+// Binary searches for a directory given its full path (ending in '/'), returns its index or -1
+static int _vksk_PakFindDir(VKSK_Pak pak, const char *path, int length) {
+	int low = 0;
+	int high = pak->header.dirCount - 1;
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		const char *midPath = pak->header.dirs[mid].path;
+		int c = _vksk_ComparePaths(midPath, strlen(midPath), path, length);
+		if (c == 0)
+			return mid;
+		if (c < 0)
+			low = mid + 1;
+		else
+			high = mid - 1;
+	}
+	return -1;
+}
+
+// Builds the directory tree for a loaded pak so listing a directory only touches that directory's contents
+static void _vksk_PakBuildTree(VKSK_Pak pak) {
+	VKSK_PakHeader *header = &pak->header;
+
+	// Sort the files so each directory's files are contiguous
+	VKSK_PakFileInfo **sorted = malloc(sizeof(VKSK_PakFileInfo *) * (header->fileCount + 1));
+	for (int i = 0; i < header->fileCount; i++)
+		sorted[i] = &header->files[i];
+	qsort(sorted, header->fileCount, sizeof(VKSK_PakFileInfo *), _vksk_CompareFileInfos);
+	header->sortedFiles = malloc(sizeof(int) * (header->fileCount + 1));
+	for (int i = 0; i < header->fileCount; i++)
+		header->sortedFiles[i] = sorted[i] - header->files;
+
+	// Every directory a file is in plus all of their parents, the root is the empty path
+	int spanCount = 1;
+	int spanCapacity = 16;
+	_vksk_PathSpan *spans = malloc(sizeof(_vksk_PathSpan) * spanCapacity);
+	spans[0].path = "";
+	spans[0].length = 0;
+	for (int i = 0; i < header->fileCount; i++) {
+		const char *name = sorted[i]->filename;
+		int parent = _vksk_ParentLength(name, strlen(name));
+		if (i > 0 && _vksk_CompareSpans(name, parent, sorted[i - 1]->filename, _vksk_ParentLength(sorted[i - 1]->filename, strlen(sorted[i - 1]->filename))) == 0)
+			continue;
+		for (int length = 1; length <= parent; length++) {
+			if (name[length - 1] == '/') {
+				if (spanCount == spanCapacity) {
+					spanCapacity *= 2;
+					spans = realloc(spans, sizeof(_vksk_PathSpan) * spanCapacity);
+				}
+				spans[spanCount].path = name;
+				spans[spanCount].length = length;
+				spanCount++;
+			}
+		}
+	}
+	qsort(spans, spanCount, sizeof(_vksk_PathSpan), _vksk_CompareSpansQsort);
+
+	// Drop duplicates and copy the paths into the arena
+	size_t arenaSize = 0;
+	int dirCount = 0;
+	for (int i = 0; i < spanCount; i++) {
+		if (i == 0 || _vksk_CompareSpans(spans[i].path, spans[i].length, spans[dirCount - 1].path, spans[dirCount - 1].length) != 0) {
+			spans[dirCount++] = spans[i];
+			arenaSize += spans[i].length + 1;
+		}
+	}
+	header->dirArena = malloc(arenaSize);
+	header->dirs = calloc(dirCount, sizeof(VKSK_PakDirNode));
+	header->dirCount = dirCount;
+	char *arena = header->dirArena;
+	for (int i = 0; i < dirCount; i++) {
+		memcpy(arena, spans[i].path, spans[i].length);
+		arena[spans[i].length] = 0;
+		header->dirs[i].path = arena;
+		arena += spans[i].length + 1;
+	}
+	free(spans);
+
+	// Link up the ranges, directories with the same parent are already next to each other and likewise for files
+	for (int i = 1; i < dirCount; i++) {
+		const char *path = header->dirs[i].path;
+		VKSK_PakDirNode *parent = &header->dirs[_vksk_PakFindDir(pak, path, _vksk_ParentLength(path, strlen(path)))];
+		if (parent->childCount++ == 0)
+			parent->firstChild = i;
+	}
+	VKSK_PakDirNode *dir = NULL;
+	for (int i = 0; i < header->fileCount; i++) {
+		const char *name = sorted[i]->filename;
+		int parent = _vksk_ParentLength(name, strlen(name));
+		if (dir == NULL || _vksk_CompareSpans(dir->path, strlen(dir->path), name, parent) != 0)
+			dir = &header->dirs[_vksk_PakFindDir(pak, name, parent)];
+		if (dir->fileCount++ == 0)
+			dir->firstFile = i;
+	}
+	free(sorted);
+}
+
+// Returns the header entry for a file or NULL if its not in the pak
+static VKSK_PakFileInfo *_vksk_PakFindFile(VKSK_Pak pak, const char *filename) {
+	if (pak == NULL || pak->header.hashTable == NULL)
+		return NULL;
+	uint32_t hash = _vksk_HashString(filename);
+	int mask = pak->header.hashTableSize - 1;
+	for (int slot = hash & mask; pak->header.hashTable[slot] != -1; slot = (slot + 1) & mask) {
+		VKSK_PakFileInfo *fileInfo = &pak->header.files[pak->header.hashTable[slot]];
+		if (fileInfo->hash == hash && strcmp(fileInfo->filename, filename) == 0)
+			return fileInfo;
+	}
+	return NULL;
+}
+
+// Opens the descriptor that all reads from this pak go through, it stays open until the pak is freed
+static bool _vksk_PakOpenFile(VKSK_Pak pak) {
+#ifdef _WIN32
+	pak->fileHandle = CreateFileA(pak->filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	return pak->fileHandle != INVALID_HANDLE_VALUE;
+#else
+	pak->fd = open(pak->filename, O_RDONLY);
+	return pak->fd != -1;
+#endif
+}
+
+static void _vksk_PakCloseFile(VKSK_Pak pak) {
+#ifdef _WIN32
+	if (pak->fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(pak->fileHandle);
+	pak->fileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (pak->fd != -1)
+		close(pak->fd);
+	pak->fd = -1;
+#endif
+}
+
+// Reads `size` bytes at `offset` without touching any shared file position, so it is safe to call from
+// several threads at once. Returns false if the whole range could not be read.
+static bool _vksk_PakReadAt(VKSK_Pak pak, void *dst, size_t size, uint64_t offset) {
+	uint8_t *out = dst;
+	offset += pak->base;
+	while (size > 0) {
+#ifdef _WIN32
+		OVERLAPPED overlapped = {0};
+		overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+		overlapped.OffsetHigh = (DWORD)(offset >> 32);
+		DWORD chunk = size > 0x40000000 ? 0x40000000 : (DWORD)size;
+		DWORD amount = 0;
+		if (!ReadFile(pak->fileHandle, out, chunk, &amount, &overlapped) || amount == 0)
+			return false;
+#else
+		ssize_t amount = pread(pak->fd, out, size, offset);
+		if (amount == -1 && errno == EINTR)
+			continue;
+		if (amount <= 0)
+			return false;
+#endif
+		out += amount;
+		size -= amount;
+		offset += amount;
+	}
+	return true;
+}
+
+static int _vksk_Seek(FILE *f, uint64_t offset) {
+#ifdef _WIN32
+	return _fseeki64(f, offset, SEEK_SET);
+#else
+	return fseeko(f, offset, SEEK_SET);
+#endif
+}
+
+// Size of an open file, leaves the file position at the end
+static uint64_t _vksk_FileLength(FILE *f) {
+#ifdef _WIN32
+	_fseeki64(f, 0, SEEK_END);
+	return _ftelli64(f);
+#else
+	fseeko(f, 0, SEEK_END);
+	return ftello(f);
+#endif
+}
+
+// Reads from the mapping if there is one, otherwise the same as _vksk_PakReadAt
+static bool _vksk_PakReadRange(VKSK_Pak pak, void *dst, size_t size, uint64_t offset) {
+	if (pak->mapping != NULL) {
+		if (offset > pak->mappingSize || size > pak->mappingSize - offset)
+			return false;
+		memcpy(dst, pak->mapping + offset, size);
 		return true;
-	return false;
+	}
+	return _vksk_PakReadAt(pak, dst, size, offset);
+}
+
+// Finds the size of the file a pak is read from
+static bool _vksk_PakFileSize(VKSK_Pak pak, uint64_t *size) {
+#ifdef _WIN32
+	LARGE_INTEGER fileSize;
+	if (pak->fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(pak->fileHandle, &fileSize))
+		return false;
+	*size = fileSize.QuadPart;
+#else
+	struct stat st;
+	if (pak->fd == -1 || fstat(pak->fd, &st) == -1)
+		return false;
+	*size = st.st_size;
+#endif
+	return true;
+}
+
+// Maps the whole pak file read-only into memory, returns false if the platform refuses. Embedded paks map the
+// whole executable and point the mapping at the start of the pak.
+static bool _vksk_PakMapFile(VKSK_Pak pak) {
+	uint64_t size;
+	if (!_vksk_PakFileSize(pak, &size) || size <= pak->base)
+		return false;
+#ifdef _WIN32
+	pak->mappingHandle = CreateFileMappingA(pak->fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (pak->mappingHandle == NULL)
+		return false;
+	const uint8_t *mapping = MapViewOfFile(pak->mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (mapping == NULL) {
+		CloseHandle(pak->mappingHandle);
+		pak->mappingHandle = NULL;
+		return false;
+	}
+#else
+	void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, pak->fd, 0);
+	if (mapping == MAP_FAILED)
+		return false;
+#endif
+	pak->mapping = (const uint8_t*)mapping + pak->base;
+	pak->mappingSize = size - pak->base;
+	return true;
+}
+
+static void _vksk_PakUnmapFile(VKSK_Pak pak) {
+	if (pak->mapping != NULL) {
+#ifdef _WIN32
+		UnmapViewOfFile(pak->mapping - pak->base);
+		CloseHandle(pak->mappingHandle);
+#else
+		munmap((void*)(pak->mapping - pak->base), pak->mappingSize + pak->base);
+#endif
+		pak->mapping = NULL;
+		pak->mappingSize = 0;
+	}
 }
 
 static int _vksk_SwapEndian(int valEnd, int val) {
@@ -188,90 +633,648 @@ static int _vksk_SwapEndian(int valEnd, int val) {
 		return val;
 }
 
+// Entries are only checked against their checksum the first time they're loaded so checking doesn't slow down
+// startup, vksk_PakVerify checks everything at once
+static bool _vksk_PakNeedsCheck(VKSK_PakFileInfo *info) {
+	return (info->flags & VKSK_PAK_ENTRY_CHECKSUM) && !SDL_AtomicGet(&info->verified);
+}
+
+// Compares the checksum of an entry's stored data against its record, marking it verified if they match. Several
+// threads reading the same entry may all check it, which is harmless since they all get the same result.
+static bool _vksk_PakCheckEntry(VKSK_PakFileInfo *info, uint32_t checksum) {
+	if (checksum != info->checksum) {
+		printf("Pak entry \"%s\" is corrupt, its checksum doesn't match.\n", info->filename);
+		return false;
+	}
+	SDL_AtomicSet(&info->verified, 1);
+	return true;
+}
+
+// Reads a whole entry into dst (which must hold info->size bytes), decompressing straight into it if need be. This
+// is safe to call from several threads at once.
+static bool _vksk_PakReadEntry(VKSK_Pak pak, VKSK_PakFileInfo *info, uint8_t *dst) {
+	if (pak->mapping != NULL) {
+		// Uncompressed entries copy size bytes, which the index makes sure is their stored size, but that's checked
+		// here too since running off the end of the mapping is a crash rather than a failed read
+		uint64_t length = info->flags & VKSK_PAK_ENTRY_COMPRESSED ? info->storedSize : info->size;
+		if (info->pointer > pak->mappingSize || info->storedSize > pak->mappingSize - info->pointer ||
+			length > pak->mappingSize - info->pointer)
+			return false;
+		if (_vksk_PakNeedsCheck(info) && !_vksk_PakCheckEntry(info, vksk_CRC32C(0, pak->mapping + info->pointer, info->storedSize)))
+			return false;
+		if (info->flags & VKSK_PAK_ENTRY_COMPRESSED)
+			return _vksk_PakDecompressBlocks(pak->mapping + info->pointer, info->storedSize, dst, info->size);
+		memcpy(dst, pak->mapping + info->pointer, info->size);
+		return true;
+	}
+
+	if (!(info->flags & VKSK_PAK_ENTRY_COMPRESSED)) {
+		if (!_vksk_PakReadAt(pak, dst, info->size, info->pointer))
+			return false;
+		return !_vksk_PakNeedsCheck(info) || _vksk_PakCheckEntry(info, vksk_CRC32C(0, dst, info->size));
+	}
+
+	// Compressed entries are read one block at a time, each read also grabs the header of the block after it
+	// so there is only ever one read per block
+	if (info->size == 0)
+		return true;
+	uint8_t blockHeader[4];
+	uint64_t pos = info->pointer + 4;
+	uint64_t end = info->pointer + info->storedSize;
+	if (info->storedSize < 4 || !_vksk_PakReadAt(pak, blockHeader, 4, info->pointer))
+		return false;
+	bool check = _vksk_PakNeedsCheck(info);
+	uint32_t checksum = check ? vksk_CRC32C(0, blockHeader, 4) : 0;
+	uint32_t header = _vksk_GetU32(blockHeader);
+	uint8_t *scratch = malloc(VKSK_PAK_BLOCK_SIZE + 4);
+	bool ok = scratch != NULL;
+	for (uint64_t written = 0; ok && written < info->size;) {
+		uint32_t storedLength = header & ~VKSK_PAK_BLOCK_RAW;
+		int blockSize = info->size - written > VKSK_PAK_BLOCK_SIZE ? VKSK_PAK_BLOCK_SIZE : info->size - written;
+		int readSize = storedLength + (written + blockSize < info->size ? 4 : 0);
+		if (storedLength > VKSK_PAK_BLOCK_SIZE || pos + readSize > end || !_vksk_PakReadAt(pak, scratch, readSize, pos)) {
+			ok = false;
+			break;
+		}
+		if (check)
+			checksum = vksk_CRC32C(checksum, scratch, readSize);
+		if (header & VKSK_PAK_BLOCK_RAW) {
+			ok = storedLength == blockSize;
+			if (ok)
+				memcpy(dst + written, scratch, blockSize);
+		} else {
+			ok = vksk_LZDecompress(scratch, storedLength, dst + written, blockSize);
+		}
+		if (ok && readSize > storedLength)
+			header = _vksk_GetU32(scratch + storedLength);
+		pos += readSize;
+		written += blockSize;
+	}
+	free(scratch);
+	if (ok && check)
+		ok = pos == end && _vksk_PakCheckEntry(info, checksum);
+	return ok;
+}
+
+// Loads the index of a version 2 pak
+static bool _vksk_PakLoadIndexV2(VKSK_Pak pak) {
+	uint8_t header[VKSK_PAK_HEADER_SIZE];
+	if (!_vksk_PakReadAt(pak, header, VKSK_PAK_HEADER_SIZE, 0))
+		return false;
+	pak->header.version = _vksk_GetU32(header + 8);
+	uint32_t fileCount = _vksk_GetU32(header + 12);
+	uint64_t indexOffset = _vksk_GetU64(header + 16);
+	uint64_t indexSize = _vksk_GetU64(header + 24);
+	uint32_t recordSize = _vksk_GetU32(header + 32);
+	if (pak->header.version != VKSK_PAK_VERSION || recordSize < VKSK_PAK_MIN_RECORD_SIZE || indexSize > INT32_MAX ||
+		(uint64_t)fileCount * recordSize > indexSize)
+		return false;
+
+	// The whole index is pulled in with one read, filenames can't take up more space than the index itself
+	pak->header.dataEnd = indexOffset + indexSize;
+	uint8_t *index = malloc(indexSize);
+	if (index == NULL || !_vksk_PakReadAt(pak, index, indexSize, indexOffset)) {
+		free(index);
+		return false;
+	}
+	pak->header.fileCount = fileCount;
+	pak->header.files = malloc(sizeof(struct VKSK_PakFileInfo) * (fileCount + 1));
+	pak->header.stringArena = malloc(indexSize + 1);
+	uint64_t pos = 0;
+	char *arena = pak->header.stringArena;
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		VKSK_PakFileInfo *fileInfo = &pak->header.files[i];
+		if (indexSize - pos < recordSize) {
+			free(index);
+			return false;
+		}
+		const uint8_t *record = index + pos;
+		fileInfo->pointer = _vksk_GetU64(record);
+		fileInfo->storedSize = _vksk_GetU64(record + 8);
+		fileInfo->size = _vksk_GetU64(record + 16);
+		fileInfo->flags = _vksk_GetU32(record + 24);
+		uint32_t stringSize = _vksk_GetU32(record + 28);
+		fileInfo->contentHash = recordSize >= 40 ? _vksk_GetU64(record + 32) : 0;
+		fileInfo->mtime = recordSize >= 48 ? (int64_t)_vksk_GetU64(record + 40) : 0;
+		fileInfo->checksum = recordSize >= 52 ? _vksk_GetU32(record + 48) : 0;
+		SDL_AtomicSet(&fileInfo->verified, 0);
+		if (recordSize < 52)
+			fileInfo->flags &= ~VKSK_PAK_ENTRY_CHECKSUM;
+		pos += recordSize;
+		bool sizesMatch = (fileInfo->flags & VKSK_PAK_ENTRY_COMPRESSED) || fileInfo->storedSize == fileInfo->size;
+		if (indexSize - pos < stringSize || fileInfo->size > INT32_MAX || !sizesMatch) {
+			free(index);
+			return false;
+		}
+		memcpy(arena, index + pos, stringSize);
+		arena[stringSize] = 0;
+		fileInfo->filename = arena;
+		arena += stringSize + 1;
+		pos += stringSize;
+	}
+	free(index);
+	return true;
+}
+
+// Loads the header of a version 1 pak
+static bool _vksk_PakLoadIndexV1(VKSK_Pak pak) {
+	FILE *f = fopen(pak->filename, "rb");
+	if (f == NULL)
+		return false;
+	int endian;
+	fread(&endian, 4, 1, f);
+	fread(&pak->header.fileCount, 4, 1, f);
+	pak->header.fileCount = _vksk_SwapEndian(endian, pak->header.fileCount);
+	pak->header.version = 1;
+	if (pak->header.fileCount < 0) {
+		fclose(f);
+		return false;
+	}
+
+	// Create header, filenames are placed into the arena as offsets and fixed up after
+	// since the arena moves as it grows
+	pak->header.files = malloc(sizeof(struct VKSK_PakFileInfo) * (pak->header.fileCount + 1));
+	int *nameOffsets = malloc(sizeof(int) * (pak->header.fileCount + 1));
+	int arenaSize = 0;
+	int arenaCapacity = 1024;
+	pak->header.stringArena = malloc(arenaCapacity);
+	int filesProcessed = 0;
+	for (int i = 0; i < pak->header.fileCount && !feof(f); i++) {
+		VKSK_PakFileInfo *fileInfo = &pak->header.files[i];
+		int stringSize, size, pointer;
+
+		// String size, file size and offset
+		fread(&stringSize, 4, 1, f);
+		fread(&size, 4, 1, f);
+		fread(&pointer, 4, 1, f);
+		stringSize = _vksk_SwapEndian(endian, stringSize);
+		fileInfo->size = fileInfo->storedSize = (uint32_t)_vksk_SwapEndian(endian, size);
+		fileInfo->pointer = (uint32_t)_vksk_SwapEndian(endian, pointer);
+		fileInfo->flags = 0;
+
+		// Filename
+		if (stringSize < 0)
+			break;
+		if (arenaSize + stringSize + 1 > arenaCapacity) {
+			while (arenaSize + stringSize + 1 > arenaCapacity)
+				arenaCapacity *= 2;
+			pak->header.stringArena = realloc(pak->header.stringArena, arenaCapacity);
+		}
+		if (fread(pak->header.stringArena + arenaSize, 1, stringSize, f) != stringSize)
+			break;
+		pak->header.stringArena[arenaSize + stringSize] = 0;
+		nameOffsets[i] = arenaSize;
+		arenaSize += stringSize + 1;
+		filesProcessed += 1;
+	}
+	fclose(f);
+
+	if (filesProcessed == pak->header.fileCount)
+		for (int i = 0; i < pak->header.fileCount; i++)
+			pak->header.files[i].filename = pak->header.stringArena + nameOffsets[i];
+	free(nameOffsets);
+	return filesProcessed == pak->header.fileCount;
+}
+
+// Cleans up a read pak whose index failed to load
+static VKSK_Pak _vksk_PakLoadFailed(VKSK_Pak pak) {
+	_vksk_PakCloseFile(pak);
+	free(pak->header.stringArena);
+	free(pak->header.files);
+	free((void *) pak->filename);
+	free(pak);
+	return NULL;
+}
+
 VKSK_Pak vksk_PakLoad(const char *filename) {
 	VKSK_Pak pak = _vksk_PakMakeEmpty(PAK_TYPE_READ);
 	pak->header.files = NULL;
 	pak->filename = _vksk_CopyString(filename);
+	if (_vksk_PakOpenFile(pak)) {
+		uint8_t magic[8];
+		bool loaded;
+		if (_vksk_PakReadAt(pak, magic, 8, 0) && memcmp(magic, VKSK_PAK_MAGIC, 8) == 0)
+			loaded = _vksk_PakLoadIndexV2(pak);
+		else
+			loaded = _vksk_PakLoadIndexV1(pak);
+
+		if (!loaded)
+			return _vksk_PakLoadFailed(pak);
+		_vksk_PakBuildIndex(pak);
+		_vksk_PakBuildTree(pak);
+	}
+
+	return pak;
+}
+
+// Finds the path of the running executable
+static bool _vksk_ExecutablePath(char *buffer, int size) {
+#if defined(_WIN32)
+	DWORD length = GetModuleFileNameA(NULL, buffer, size);
+	return length > 0 && length < size;
+#elif defined(__APPLE__)
+	uint32_t bufferSize = size;
+	return _NSGetExecutablePath(buffer, &bufferSize) == 0;
+#elif defined(__linux__)
+	snprintf(buffer, size, "/proc/self/exe");
+	return true;
+#else
+	return false;
+#endif
+}
+
+VKSK_Pak vksk_PakLoadEmbedded(bool mapped) {
+	char path[1024];
+	if (!_vksk_ExecutablePath(path, 1024))
+		return NULL;
+	VKSK_Pak pak = _vksk_PakMakeEmpty(PAK_TYPE_READ);
+	pak->filename = _vksk_CopyString(path);
+
+	// The trailer at the very end of the executable says where the pak starts
+	uint8_t trailer[VKSK_PAK_TRAILER_SIZE];
+	uint8_t magic[8];
+	uint64_t size;
+	if (!_vksk_PakOpenFile(pak) || !_vksk_PakFileSize(pak, &size) || size < VKSK_PAK_TRAILER_SIZE ||
+		!_vksk_PakReadAt(pak, trailer, VKSK_PAK_TRAILER_SIZE, size - VKSK_PAK_TRAILER_SIZE) ||
+		memcmp(trailer + 8, VKSK_PAK_EMBED_MAGIC, 8) != 0 || _vksk_GetU64(trailer) >= size - VKSK_PAK_TRAILER_SIZE)
+		return _vksk_PakLoadFailed(pak);
+	pak->base = _vksk_GetU64(trailer);
+	if (!_vksk_PakReadAt(pak, magic, 8, 0) || memcmp(magic, VKSK_PAK_MAGIC, 8) != 0 || !_vksk_PakLoadIndexV2(pak))
+		return _vksk_PakLoadFailed(pak);
+	_vksk_PakBuildIndex(pak);
+	_vksk_PakBuildTree(pak);
+	if (mapped)
+		_vksk_PakMapFile(pak);
+	return pak;
+}
+
+VKSK_Pak vksk_PakLoadMapped(const char *filename) {
+	VKSK_Pak pak = vksk_PakLoad(filename);
+	if (pak != NULL)
+		_vksk_PakMapFile(pak);
+	return pak;
+}
+
+VKSK_Pak vksk_PakLoadDirectory(const char *directory) {
+	VKSK_Pak pak = _vksk_PakMakeEmpty(PAK_TYPE_DIRECTORY);
+	pak->filename = _vksk_CopyString(directory);
+	_vksk_IterateDirectory(pak, directory);
+
+	// Filenames are relative to the directory
+	int prefixLength = strlen(directory) + 1;
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		const char *fullName = pak->header.files[i].filename;
+		pak->header.files[i].filename = _vksk_CopyString(fullName + prefixLength);
+		free((void*)fullName);
+	}
+	_vksk_PakBuildIndex(pak);
+	_vksk_PakBuildTree(pak);
+	return pak;
+}
+
+VKSK_Pak vksk_PakCreateLayered() {
+	return _vksk_PakMakeEmpty(PAK_TYPE_LAYERED);
+}
+
+bool vksk_PakMount(VKSK_Pak pak, VKSK_Pak layer) {
+	if (pak == NULL || layer == NULL || pak->type != PAK_TYPE_LAYERED || (layer->type != PAK_TYPE_READ && layer->type != PAK_TYPE_DIRECTORY))
+		return false;
+	pak->layers = realloc(pak->layers, sizeof(VKSK_Pak) * (pak->layerCount + 1));
+	pak->layers[pak->layerCount] = layer;
+	int layerIndex = pak->layerCount++;
+
+	// Files in the new layer replace files with the same name from lower layers, the rest are added to the end
+	VKSK_PakHeader *header = &pak->header;
+	header->files = realloc(header->files, sizeof(VKSK_PakFileInfo) * (header->fileCount + layer->header.fileCount + 1));
+	int fileCount = header->fileCount;
+	for (int i = 0; i < layer->header.fileCount; i++) {
+		VKSK_PakFileInfo *existing = _vksk_PakFindFile(pak, layer->header.files[i].filename);
+		if (existing == NULL)
+			existing = &header->files[fileCount++];
+		*existing = layer->header.files[i];
+		existing->layer = layerIndex;
+	}
+	header->fileCount = fileCount;
+
+	// Rebuild the merged index and tree
+	free(header->hashTable);
+	free(header->sortedFiles);
+	free(header->dirs);
+	free(header->dirArena);
+	_vksk_PakBuildIndex(pak);
+	_vksk_PakBuildTree(pak);
+	return true;
+}
+
+// Orders filenames alphabetically for qsort
+static int _vksk_CompareNames(const void *a, const void *b) {
+	return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+int vksk_PakMountPaks(VKSK_Pak pak, const char *directory, bool mapped) {
+	DIR *dfd = opendir(directory);
+	if (dfd == NULL)
+		return 0;
+
+	// Grab every .pak in the directory so they can be mounted in a predictable order
+	char **names = NULL;
+	int nameCount = 0;
+	for (struct dirent *dp = readdir(dfd); dp != NULL; dp = readdir(dfd)) {
+		const char *ext = strrchr(dp->d_name, '.');
+		if (ext != NULL && SDL_strcasecmp(ext, ".pak") == 0) {
+			names = realloc(names, sizeof(char *) * (nameCount + 1));
+			names[nameCount++] = (char*)_vksk_CopyString(dp->d_name);
+		}
+	}
+	closedir(dfd);
+	qsort(names, nameCount, sizeof(char *), _vksk_CompareNames);
+
+	int mounted = 0;
+	for (int i = 0; i < nameCount; i++) {
+		char path[1024];
+		snprintf(path, 1024, "%s/%s", directory, names[i]);
+		VKSK_Pak layer = mapped ? vksk_PakLoadMapped(path) : vksk_PakLoad(path);
+		if (vksk_PakMount(pak, layer))
+			mounted++;
+		else
+			vksk_PakFree(layer);
+		free(names[i]);
+	}
+	free(names);
+	return mounted;
+}
+
+// The pak that actually holds a file, which is only different from pak for layered paks
+static VKSK_Pak _vksk_PakOwner(VKSK_Pak pak, const VKSK_PakFileInfo *info) {
+	return pak->type == PAK_TYPE_LAYERED ? pak->layers[info->layer] : pak;
+}
+
+// Where a file from a directory pak is on disk
+static void _vksk_PakLoosePath(VKSK_Pak pak, const VKSK_PakFileInfo *info, char *buffer, int bufferSize) {
+	snprintf(buffer, bufferSize, "%s/%s", pak->filename, info->filename);
+}
+
+// Loads a whole file from disk
+static uint8_t *_vksk_LoadLooseFile(const char *filename, int *size) {
 	FILE *f = fopen(filename, "rb");
-	if (f != NULL) {
-		int endian;
-		fread(&endian, 4, 1, f);
-		fread(&pak->header.fileCount, 4, 1, f);
-		pak->header.fileCount = _vksk_SwapEndian(endian, pak->header.fileCount);
-
-		// Create header
-		pak->header.files = malloc(sizeof(struct VKSK_PakFileInfo) * pak->header.fileCount);
-		int filesProcessed = 0;
-		for (int i = 0; i < pak->header.fileCount && !feof(f); i++) {
-			VKSK_PakFileInfo *fileInfo = &pak->header.files[i];
-
-			// String size
-			int stringSize;
-			fread(&stringSize, 4, 1, f);
-			stringSize = _vksk_SwapEndian(endian, stringSize);
-
-			// File size
-			fread(&fileInfo->size, 4, 1, f);
-			fileInfo->size = _vksk_SwapEndian(endian, fileInfo->size);
-
-			// Offset
-			fread(&fileInfo->pointer, 4, 1, f);
-			fileInfo->pointer = _vksk_SwapEndian(endian, fileInfo->pointer);
-
-			// Filename
-			char *fname = malloc(stringSize + 1);
-			fname[stringSize] = 0;
-			fread(fname, 1, stringSize, f);
-			fileInfo->filename = fname;
-			filesProcessed += 1;
+	struct stat stbuf;
+	uint8_t *out = NULL;
+	if (f != NULL && fstat(fileno(f), &stbuf) == 0) {
+		out = malloc(stbuf.st_size + 1);
+		if (out != NULL && fread(out, 1, stbuf.st_size, f) == (size_t)stbuf.st_size) {
+			*size = stbuf.st_size;
+		} else {
+			free(out);
+			out = NULL;
 		}
+	}
+	if (f != NULL)
 		fclose(f);
+	return out;
+}
 
-		if (filesProcessed != pak->header.fileCount) {
-			for (int i = 0; i < filesProcessed; i++)
-				free((void *) pak->header.files[i].filename);
-			free(pak->header.files);
-			free((void *) pak->filename);
-			free(pak);
-			return NULL;
-		}
+uint64_t vksk_PakGetBlobID(VKSK_Pak pak, const char *filename) {
+	// Loose files have no blob, offsets are only unique within one pak so the layer goes in the top byte
+	VKSK_PakFileInfo *info = _vksk_PakFindFile(pak, filename);
+	if (info == NULL || info->size == 0 || _vksk_PakOwner(pak, info)->type == PAK_TYPE_DIRECTORY)
+		return 0;
+	return info->pointer | ((uint64_t)info->layer << 56);
+}
+
+uint64_t vksk_PakHashDirectory(VKSK_Pak pak, const char *directory) {
+	if (pak == NULL)
+		return 0;
+	uint64_t hash = VKSK_PAK_HASH_SEED;
+	size_t length = strlen(directory);
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		VKSK_PakFileInfo *info = &pak->header.files[pak->header.sortedFiles != NULL ? pak->header.sortedFiles[i] : i];
+		if (strncmp(info->filename, directory, length) != 0)
+			continue;
+
+		// Loose files don't have a content hash so their size and modification time stand in for it
+		hash = _vksk_HashCombine(hash, _vksk_HashBytes((const uint8_t*)info->filename, strlen(info->filename), VKSK_PAK_HASH_SEED));
+		hash = _vksk_HashCombine(hash, info->contentHash);
+		hash = _vksk_HashCombine(hash, info->size);
+		hash = _vksk_HashCombine(hash, (uint64_t)info->mtime);
 	}
+	return hash;
+}
 
-	return pak;
+bool vksk_PakIsMapped(VKSK_Pak pak) {
+	return pak != NULL && pak->mapping != NULL;
 }
 
 bool vksk_PakFileExists(VKSK_Pak pak, const char *filename) {
-	if (pak != NULL && pak->type == PAK_TYPE_READ)
-		for (int i = 0; i < pak->header.fileCount; i++)
-			if (strcmp(pak->header.files[i].filename, filename) == 0)
-				return true;
-	return false;
+	return _vksk_PakFindFile(pak, filename) != NULL;
+}
+
+// Loads a file from the pak that owns it into a new buffer
+static uint8_t *_vksk_PakLoadEntry(VKSK_Pak owner, VKSK_PakFileInfo *found, int *size) {
+	uint8_t *out = NULL;
+	if (owner->type == PAK_TYPE_DIRECTORY) {
+		char path[1024];
+		_vksk_PakLoosePath(owner, found, path, 1024);
+		out = _vksk_LoadLooseFile(path, size);
+	} else {
+		out = malloc(found->size);
+		if (out != NULL && _vksk_PakReadEntry(owner, found, out)) {
+			*size = found->size;
+		} else {
+			free(out);
+			out = NULL;
+		}
+	}
+	return out;
 }
 
 uint8_t *vksk_PakGetFile(VKSK_Pak pak, const char *filename, int *size) {
 	*size = -1;
-	uint8_t *out = NULL;
-	if (pak != NULL && pak->type == PAK_TYPE_READ) {
-		// Find the file
-		VKSK_PakFileInfo *found = NULL;
-		for (int i = 0; i < pak->header.fileCount && found == NULL; i++) {
-			if (strcmp(pak->header.files[i].filename, filename) == 0) {
-				found = &pak->header.files[i];
+	VKSK_PakFileInfo *found = _vksk_PakFindFile(pak, filename);
+	if (found == NULL)
+		return NULL;
+	return _vksk_PakLoadEntry(_vksk_PakOwner(pak, found), found, size);
+}
+
+typedef struct _vksk_PakBatchRequest {
+	VKSK_Pak owner;
+	VKSK_PakFileInfo *info;
+	int index;      // Where it goes in the caller's arrays
+	uint8_t *stored; // Where the stored data is read to, the output buffer itself unless its compressed
+} _vksk_PakBatchRequest;
+
+static int _vksk_CompareBatchRequests(const void *a, const void *b) {
+	const _vksk_PakBatchRequest *aRequest = a;
+	const _vksk_PakBatchRequest *bRequest = b;
+	if (aRequest->owner != bRequest->owner)
+		return aRequest->owner < bRequest->owner ? -1 : 1;
+	if (aRequest->info->pointer != bRequest->info->pointer)
+		return aRequest->info->pointer < bRequest->info->pointer ? -1 : 1;
+	return aRequest->index - bRequest->index;
+}
+
+#ifndef _WIN32
+// preadv that keeps going after short reads
+static bool _vksk_PakReadVector(VKSK_Pak pak, struct iovec *iov, int count, uint64_t offset) {
+	offset += pak->base;
+	while (count > 0) {
+		ssize_t amount = preadv(pak->fd, iov, count, offset);
+		if (amount == -1 && errno == EINTR)
+			continue;
+		if (amount <= 0)
+			return false;
+		offset += amount;
+		while (count > 0 && (size_t)amount >= iov->iov_len) {
+			amount -= iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0) {
+			iov->iov_base = (uint8_t*)iov->iov_base + amount;
+			iov->iov_len -= amount;
+		}
+	}
+	return true;
+}
+#endif
+
+// Reads the stored data of every request in a run with one read, requests are sorted by offset and any that
+// share data with the request before them have stored set to NULL
+static bool _vksk_PakReadRun(_vksk_PakBatchRequest *requests, int count, uint8_t *gapScratch) {
+	VKSK_Pak owner = requests[0].owner;
+	uint64_t start = requests[0].info->pointer;
+#ifdef _WIN32
+	// Windows has no vectored reads on regular files so the run is read into one buffer and copied out
+	VKSK_PakFileInfo *last = requests[count - 1].info;
+	uint8_t *staging = malloc(last->pointer + last->storedSize - start + 1);
+	bool ok = staging != NULL && _vksk_PakReadAt(owner, staging, last->pointer + last->storedSize - start, start);
+	for (int i = 0; ok && i < count; i++)
+		if (requests[i].stored != NULL)
+			memcpy(requests[i].stored, staging + (requests[i].info->pointer - start), requests[i].info->storedSize);
+	free(staging);
+	return ok;
+#else
+	// Gaps between files get read into scratch memory and thrown away
+	struct iovec iov[VKSK_PAK_BATCH_MAX_FILES * 2];
+	int iovCount = 0;
+	uint64_t end = start;
+	for (int i = 0; i < count; i++) {
+		if (requests[i].stored == NULL)
+			continue;
+		if (requests[i].info->pointer > end) {
+			iov[iovCount].iov_base = gapScratch;
+			iov[iovCount++].iov_len = requests[i].info->pointer - end;
+		}
+		iov[iovCount].iov_base = requests[i].stored;
+		iov[iovCount++].iov_len = requests[i].info->storedSize;
+		end = requests[i].info->pointer + requests[i].info->storedSize;
+	}
+	return _vksk_PakReadVector(owner, iov, iovCount, start);
+#endif
+}
+
+int vksk_PakGetFiles(VKSK_Pak pak, const char **filenames, int count, uint8_t **buffers, int *sizes) {
+	int loaded = 0;
+	_vksk_PakBatchRequest *requests = malloc(sizeof(_vksk_PakBatchRequest) * (count + 1));
+	int requestCount = 0;
+
+	// Anything that isn't a plain read from a pak file doesn't benefit from batching and is loaded right away
+	for (int i = 0; i < count; i++) {
+		buffers[i] = NULL;
+		sizes[i] = -1;
+		VKSK_PakFileInfo *found = _vksk_PakFindFile(pak, filenames[i]);
+		if (found == NULL)
+			continue;
+		VKSK_Pak owner = _vksk_PakOwner(pak, found);
+		if (found->size == 0) {
+			buffers[i] = malloc(1);
+			sizes[i] = 0;
+			loaded++;
+		} else if (owner->type == PAK_TYPE_READ && owner->mapping == NULL) {
+			requests[requestCount].owner = owner;
+			requests[requestCount].info = found;
+			requests[requestCount++].index = i;
+		} else {
+			buffers[i] = _vksk_PakLoadEntry(owner, found, &sizes[i]);
+			loaded += buffers[i] != NULL;
+		}
+	}
+	qsort(requests, requestCount, sizeof(_vksk_PakBatchRequest), _vksk_CompareBatchRequests);
+
+	// Split the requests into runs of files that are close enough together to read in one go
+	uint8_t *gapScratch = malloc(VKSK_PAK_BATCH_GAP);
+	for (int start = 0; start < requestCount;) {
+		int end = start;
+		uint64_t runStart = requests[start].info->pointer;
+		uint64_t runEnd = runStart;
+		while (end < requestCount && end - start < VKSK_PAK_BATCH_MAX_FILES && requests[end].owner == requests[start].owner) {
+			VKSK_PakFileInfo *info = requests[end].info;
+			bool shared = end > start && info->pointer == requests[end - 1].info->pointer && info->storedSize == requests[end - 1].info->storedSize;
+			if (!shared && end > start && (info->pointer < runEnd || info->pointer - runEnd > VKSK_PAK_BATCH_GAP || info->pointer + info->storedSize - runStart > VKSK_PAK_BATCH_MAX_RUN))
+				break;
+			if (shared) {
+				requests[end].stored = NULL;
+			} else {
+				bool compressed = (info->flags & VKSK_PAK_ENTRY_COMPRESSED) != 0;
+				requests[end].stored = malloc(info->storedSize + 1);
+				if (!compressed)
+					buffers[requests[end].index] = requests[end].stored;
+				runEnd = info->pointer + info->storedSize;
 			}
+			end++;
 		}
 
-		// Create a piece of memory for it
-		if (found != NULL) {
-			FILE *f = fopen(pak->filename, "rb");
-			out = malloc(found->size);
-			*size = found->size;
-			fseek(f, found->pointer, SEEK_SET);
-			fread(out, 1, *size, f);
-			fclose(f);
+		bool ok = _vksk_PakReadRun(requests + start, end - start, gapScratch);
+		for (int i = start; i < end; i++) {
+			VKSK_PakFileInfo *info = requests[i].info;
+			int index = requests[i].index;
+			if (!ok) {
+				free(requests[i].stored);
+				buffers[index] = NULL;
+				continue;
+			}
+			if (requests[i].stored == NULL) {
+				// Same data as the one before it
+				int previous = requests[i - 1].index;
+				if (buffers[previous] != NULL) {
+					buffers[index] = malloc(info->size + 1);
+					memcpy(buffers[index], buffers[previous], info->size);
+				}
+			} else if (_vksk_PakNeedsCheck(info) && !_vksk_PakCheckEntry(info, vksk_CRC32C(0, requests[i].stored, info->storedSize))) {
+				free(requests[i].stored);
+				buffers[index] = NULL;
+			} else if (info->flags & VKSK_PAK_ENTRY_COMPRESSED) {
+				buffers[index] = malloc(info->size + 1);
+				if (!_vksk_PakDecompressBlocks(requests[i].stored, info->storedSize, buffers[index], info->size)) {
+					free(buffers[index]);
+					buffers[index] = NULL;
+				}
+				free(requests[i].stored);
+			}
+			if (buffers[index] != NULL) {
+				sizes[index] = info->size;
+				loaded++;
+			}
 		}
+		start = end;
 	}
 
-	return out;
+	free(gapScratch);
+	free(requests);
+	return loaded;
+}
+
+const uint8_t *vksk_PakGetFileView(VKSK_Pak pak, const char *filename, int *size) {
+	*size = -1;
+	VKSK_PakFileInfo *found = _vksk_PakFindFile(pak, filename);
+	VKSK_Pak owner = found != NULL ? _vksk_PakOwner(pak, found) : NULL;
+	if (owner != NULL && owner->mapping != NULL && !(found->flags & VKSK_PAK_ENTRY_COMPRESSED) &&
+		found->pointer <= owner->mappingSize && found->size <= owner->mappingSize - found->pointer) {
+		if (_vksk_PakNeedsCheck(found) && !_vksk_PakCheckEntry(found, vksk_CRC32C(0, owner->mapping + found->pointer, found->size)))
+			return NULL;
+		*size = found->size;
+		return owner->mapping + found->pointer;
+	}
+	return NULL;
 }
 
 const char *vksk_PakGetFileString(VKSK_Pak pak, const char *filename) {
@@ -284,59 +1287,260 @@ const char *vksk_PakGetFileString(VKSK_Pak pak, const char *filename) {
 	return buffer;
 }
 
+struct VKSK_PakStream {
+	VKSK_Pak pak;   // NULL for streams over files on disk
+	FILE *file;     // Only for streams over files on disk
+	uint64_t pointer;    // Where the entry's data starts in the pak
+	uint64_t storedSize;
+	uint64_t size;
+	uint64_t position;
+	bool compressed;
+
+	// Compressed entries are decompressed one block at a time
+	uint8_t *block;        // The decompressed block at currentBlock
+	uint8_t *scratch;      // Compressed data of a block
+	uint64_t currentBlock; // UINT64_MAX if nothing is loaded
+	uint64_t *blockOffsets; // Where each block starts in the pak, found as the stream goes
+	uint64_t knownBlocks;
+
+	// Streams can't check the whole entry up front, instead it's checked as long as its read front to back
+	const char *filename;
+	bool check;
+	bool corrupt;
+	uint32_t checksum;
+	uint32_t expectedChecksum;
+	uint64_t checkedBytes; // Stored bytes that have gone into checksum so far
+};
+
+VKSK_PakStream vksk_PakStreamOpen(VKSK_Pak pak, const char *filename) {
+	VKSK_PakFileInfo *found = _vksk_PakFindFile(pak, filename);
+	if (found == NULL)
+		return NULL;
+	pak = _vksk_PakOwner(pak, found);
+	if (pak->type == PAK_TYPE_DIRECTORY) {
+		char path[1024];
+		_vksk_PakLoosePath(pak, found, path, 1024);
+		return vksk_PakStreamOpenFile(path);
+	}
+	VKSK_PakStream stream = calloc(1, sizeof(struct VKSK_PakStream));
+	stream->pak = pak;
+	stream->pointer = found->pointer;
+	stream->storedSize = found->storedSize;
+	stream->size = found->size;
+	stream->compressed = (found->flags & VKSK_PAK_ENTRY_COMPRESSED) != 0;
+	stream->currentBlock = UINT64_MAX;
+	stream->filename = found->filename;
+	stream->check = _vksk_PakNeedsCheck(found) && found->storedSize > 0;
+	stream->expectedChecksum = found->checksum;
+	if (stream->compressed && stream->size > 0) {
+		stream->block = malloc(VKSK_PAK_BLOCK_SIZE);
+		stream->scratch = malloc(VKSK_PAK_BLOCK_SIZE);
+		stream->blockOffsets = malloc(sizeof(uint64_t) * ((stream->size + VKSK_PAK_BLOCK_SIZE - 1) / VKSK_PAK_BLOCK_SIZE));
+		stream->blockOffsets[0] = stream->pointer;
+		stream->knownBlocks = 1;
+	}
+	return stream;
+}
+
+VKSK_PakStream vksk_PakStreamOpenFile(const char *filename) {
+	struct stat stbuf;
+	if (stat(filename, &stbuf) != 0 || (stbuf.st_mode & S_IFMT) != S_IFREG)
+		return NULL;
+	FILE *file = fopen(filename, "rb");
+	if (file == NULL)
+		return NULL;
+	VKSK_PakStream stream = calloc(1, sizeof(struct VKSK_PakStream));
+	stream->file = file;
+	stream->size = stbuf.st_size;
+	return stream;
+}
+
+// Adds stored data that was just read at offset (from the start of the entry) to the stream's checksum if it
+// continues from where the checksum is up to, returns false once the whole entry is read if it was corrupt
+static bool _vksk_PakStreamCheck(VKSK_PakStream stream, const uint8_t *data, uint64_t offset, size_t size) {
+	if (!stream->check || offset > stream->checkedBytes || offset + size <= stream->checkedBytes)
+		return true;
+	uint64_t skip = stream->checkedBytes - offset;
+	stream->checksum = vksk_CRC32C(stream->checksum, data + skip, size - skip);
+	stream->checkedBytes = offset + size;
+	if (stream->checkedBytes == stream->storedSize) {
+		stream->check = false;
+		if (stream->checksum != stream->expectedChecksum) {
+			printf("Pak entry \"%s\" is corrupt, its checksum doesn't match.\n", stream->filename);
+			stream->corrupt = true;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Decompresses a block of a compressed entry into the stream's block buffer
+static bool _vksk_PakStreamLoadBlock(VKSK_PakStream stream, uint64_t block) {
+	uint64_t end = stream->pointer + stream->storedSize;
+	uint64_t blockCount = (stream->size + VKSK_PAK_BLOCK_SIZE - 1) / VKSK_PAK_BLOCK_SIZE;
+	uint8_t header[4];
+
+	// Blocks don't have a fixed size so every block header before this one needs to be walked once
+	while (stream->knownBlocks <= block) {
+		uint64_t last = stream->blockOffsets[stream->knownBlocks - 1];
+		if (last + 4 > end || !_vksk_PakReadRange(stream->pak, header, 4, last) ||
+			!_vksk_PakStreamCheck(stream, header, last - stream->pointer, 4))
+			return false;
+		stream->blockOffsets[stream->knownBlocks++] = last + 4 + (_vksk_GetU32(header) & ~VKSK_PAK_BLOCK_RAW);
+	}
+
+	uint64_t offset = stream->blockOffsets[block];
+	int blockSize = stream->size - block * VKSK_PAK_BLOCK_SIZE > VKSK_PAK_BLOCK_SIZE ? VKSK_PAK_BLOCK_SIZE : stream->size - block * VKSK_PAK_BLOCK_SIZE;
+	if (offset + 4 > end || !_vksk_PakReadRange(stream->pak, header, 4, offset) ||
+		!_vksk_PakStreamCheck(stream, header, offset - stream->pointer, 4))
+		return false;
+	uint32_t blockHeader = _vksk_GetU32(header);
+	uint32_t storedLength = blockHeader & ~VKSK_PAK_BLOCK_RAW;
+	if (storedLength > VKSK_PAK_BLOCK_SIZE || offset + 4 + storedLength > end ||
+		!_vksk_PakReadRange(stream->pak, stream->scratch, storedLength, offset + 4) ||
+		!_vksk_PakStreamCheck(stream, stream->scratch, offset + 4 - stream->pointer, storedLength))
+		return false;
+	if (blockHeader & VKSK_PAK_BLOCK_RAW) {
+		if (storedLength != blockSize)
+			return false;
+		memcpy(stream->block, stream->scratch, blockSize);
+	} else if (!vksk_LZDecompress(stream->scratch, storedLength, stream->block, blockSize)) {
+		return false;
+	}
+
+	if (block + 1 == stream->knownBlocks && block + 1 < blockCount)
+		stream->blockOffsets[stream->knownBlocks++] = offset + 4 + storedLength;
+	stream->currentBlock = block;
+	return true;
+}
+
+size_t vksk_PakStreamRead(VKSK_PakStream stream, void *dst, size_t size) {
+	if (stream == NULL || stream->corrupt)
+		return 0;
+	if (size > stream->size - stream->position)
+		size = stream->size - stream->position;
+	uint8_t *out = dst;
+	size_t done = 0;
+
+	if (stream->file != NULL) {
+		if (_vksk_Seek(stream->file, stream->position) == 0)
+			done = fread(out, 1, size, stream->file);
+	} else if (!stream->compressed) {
+		if (_vksk_PakReadRange(stream->pak, out, size, stream->pointer + stream->position) &&
+			_vksk_PakStreamCheck(stream, out, stream->position, size))
+			done = size;
+	} else {
+		while (done < size) {
+			uint64_t block = stream->position / VKSK_PAK_BLOCK_SIZE;
+			if (block != stream->currentBlock && !_vksk_PakStreamLoadBlock(stream, block))
+				break;
+			size_t blockPosition = stream->position % VKSK_PAK_BLOCK_SIZE;
+			size_t amount = VKSK_PAK_BLOCK_SIZE - blockPosition;
+			if (amount > size - done)
+				amount = size - done;
+			memcpy(out + done, stream->block + blockPosition, amount);
+			done += amount;
+			stream->position += amount;
+		}
+		return done;
+	}
+
+	stream->position += done;
+	return done;
+}
+
+bool vksk_PakStreamSeek(VKSK_PakStream stream, uint64_t position) {
+	if (stream == NULL || position > stream->size)
+		return false;
+	stream->position = position;
+	return true;
+}
+
+uint64_t vksk_PakStreamTell(VKSK_PakStream stream) {
+	return stream != NULL ? stream->position : 0;
+}
+
+uint64_t vksk_PakStreamSize(VKSK_PakStream stream) {
+	return stream != NULL ? stream->size : 0;
+}
+
+void vksk_PakStreamClose(VKSK_PakStream stream) {
+	if (stream != NULL) {
+		if (stream->file != NULL)
+			fclose(stream->file);
+		free(stream->block);
+		free(stream->scratch);
+		free(stream->blockOffsets);
+		free(stream);
+	}
+}
+
+int vksk_PakVerify(VKSK_Pak pak) {
+	int corrupt = 0;
+	uint8_t *buffer = malloc(VKSK_PAK_BLOCK_SIZE);
+	for (int i = 0; pak != NULL && i < pak->header.fileCount; i++) {
+		VKSK_PakFileInfo *info = &pak->header.files[i];
+		VKSK_Pak owner = _vksk_PakOwner(pak, info);
+		if (owner->type != PAK_TYPE_READ || !(info->flags & VKSK_PAK_ENTRY_CHECKSUM))
+			continue;
+		uint32_t checksum = 0;
+		bool ok = true;
+		for (uint64_t done = 0; ok && done < info->storedSize;) {
+			size_t amount = info->storedSize - done > VKSK_PAK_BLOCK_SIZE ? VKSK_PAK_BLOCK_SIZE : info->storedSize - done;
+			ok = _vksk_PakReadRange(owner, buffer, amount, info->pointer + done);
+			checksum = vksk_CRC32C(checksum, buffer, amount);
+			done += amount;
+		}
+		if (!ok)
+			printf("Pak entry \"%s\" could not be read.\n", info->filename);
+		if (!ok || !_vksk_PakCheckEntry(info, checksum))
+			corrupt++;
+	}
+	free(buffer);
+	return corrupt;
+}
+
 void vksk_PakPrintContents(VKSK_Pak pak) {
 	for (int i = 0; i < pak->header.fileCount; i++) {
-		printf("%s\n  Size: %i\n  Offset: %i\n", pak->header.files[i].filename, pak->header.files[i].size, pak->header.files[i].pointer);
+		VKSK_PakFileInfo *info = &pak->header.files[i];
+		printf("%s\n  Size: %llu\n  Stored size: %llu\n  Offset: %llu\n  Compressed: %s\n", info->filename,
+			   (unsigned long long)info->size, (unsigned long long)info->storedSize, (unsigned long long)info->pointer,
+			   info->flags & VKSK_PAK_ENTRY_COMPRESSED ? "yes" : "no");
 	}
 }
 
 const char *vksk_PakBeginLoop(VKSK_Pak pak, VKSK_PakDir *pakdir, const char *dir) {
+	pakdir->root = pak;
+	pakdir->directory = -1;
+	pakdir->fileIndex = 0;
+	pakdir->dirIndex = 0;
+	if (pak->header.dirs == NULL)
+		return NULL;
+
 	// Make sure the directory is either blank or ends with a slash if not blank
+	char currentDir[1024];
 	if (strcmp("./", dir) != 0 && strcmp("../", dir) != 0 && strcmp(".", dir) != 0 && strcmp("..", dir) != 0) {
-		if (dir[strlen(dir) - 1] == '/')
-			strncpy(pakdir->currentDir, dir, 1024);
+		if (dir[0] != 0 && dir[strlen(dir) - 1] == '/')
+			snprintf(currentDir, 1024, "%s", dir);
 		else
-			snprintf(pakdir->currentDir, 1024, "%s/", dir);
-
-		// Count how many dirs deep
-		pakdir->dirsDeep = _vksk_DirectoriesDeep(pakdir->currentDir);
+			snprintf(currentDir, 1024, "%s/", dir);
 	} else {
-		pakdir->currentDir[0] = 0;
-		pakdir->dirsDeep = 0;
+		currentDir[0] = 0;
 	}
-	pakdir->root = pak;
-	pakdir->fileIndex = 0;
-	pakdir->returnDir[0] = 0;
+	pakdir->directory = _vksk_PakFindDir(pak, currentDir, strlen(currentDir));
 	return vksk_PakNext(pakdir);
 }
 
 const char *vksk_PakNext(VKSK_PakDir *pakdir) {
-	// We want to check that whatever index is next is the same levels deep and same start path.
-	// If that path is not the same depth we copy that next path down into
-	// the returnDir, then go down the list until we find the next entry that doesn't
-	// start with the same path as returnDir to get this function ready for the next
-	// call.
-	for (; pakdir->fileIndex < pakdir->root->header.fileCount; pakdir->fileIndex++) {
-		const char *file = pakdir->root->header.files[pakdir->fileIndex].filename;
-		if (_vksk_IsFromDirectory(file, pakdir->currentDir) && _vksk_DirectoriesDeep(file) == pakdir->dirsDeep) {
-			// This is a file inside the current directory
-			pakdir->fileIndex++;
-			return file;
-		} else if (_vksk_IsFromDirectory(file, pakdir->currentDir) && _vksk_DirectoriesDeep(file) > pakdir->dirsDeep) {
-			// This is a sub-directory of our current dir
-			_vksk_CopyDirectoryXDeep(file, pakdir->dirsDeep + 1, pakdir->returnDir, 1024);
-
-			// Find the next entry that isnt from there
-			for (; pakdir->fileIndex < pakdir->root->header.fileCount; pakdir->fileIndex++) {
-				const char *searchFile = pakdir->root->header.files[pakdir->fileIndex].filename;
-				if (!_vksk_IsFromDirectory(searchFile, pakdir->returnDir))
-					break;
-			}
-
-			return pakdir->returnDir;
-		}
-	}
-
+	// Files in the directory come first and then its sub-directories
+	if (pakdir->directory == -1)
+		return NULL;
+	VKSK_PakHeader *header = &pakdir->root->header;
+	VKSK_PakDirNode *dir = &header->dirs[pakdir->directory];
+	if (pakdir->fileIndex < dir->fileCount)
+		return header->files[header->sortedFiles[dir->firstFile + pakdir->fileIndex++]].filename;
+	if (pakdir->dirIndex < dir->childCount)
+		return header->dirs[dir->firstChild + pakdir->dirIndex++].path;
 	return NULL;
 }
 
@@ -350,45 +1554,714 @@ void vksk_PakAddDirectory(VKSK_Pak pak, const char *directory) {
 		_vksk_IterateDirectory(pak, directory);
 }
 
-void vksk_PakSave(VKSK_Pak pak, const char *file) {
-	if (pak->type == PAK_TYPE_WRITE) {
-		int pointer = _vksk_CalculateHeaderSize(pak);
+typedef struct _vksk_PakConvertState {
+	VKSK_PakFileInfo **files; // Files that need converting
+	char **outputs;           // Where each is converted to
+	bool *converted;
+	int count;
+	VKSK_PakConverter converter;
+	void *data;
+	SDL_atomic_t next;        // Next file for a worker to take
+} _vksk_PakConvertState;
+
+static int _vksk_PakConvertWorker(void *data) {
+	_vksk_PakConvertState *state = data;
+	for (int i = SDL_AtomicAdd(&state->next, 1); i < state->count; i = SDL_AtomicAdd(&state->next, 1)) {
+		state->converted[i] = state->converter(state->files[i]->filename, state->outputs[i], state->data);
+		if (!state->converted[i])
+			remove(state->outputs[i]);
+	}
+	return 0;
+}
+
+int vksk_PakConvertFiles(VKSK_Pak pak, const char *directory, const char *extension, VKSK_PakConverter converter, void *data, const char *cacheDirectory) {
+	if (pak->type != PAK_TYPE_WRITE)
+		return 0;
+#ifdef _WIN32
+	CreateDirectoryA(cacheDirectory, NULL);
+#else
+	mkdir(cacheDirectory, 0755);
+#endif
 
-		// Calculate pointers
-		for (int i = 0; i < pak->header.fileCount; i++) {
-			pak->header.files[i].pointer = pointer;
-			pointer += pak->header.files[i].size;
+	// Converted files are named after a hash of the original's name and reused while they're newer than it
+	_vksk_PakConvertState state = {0};
+	state.files = malloc(sizeof(VKSK_PakFileInfo *) * (pak->header.fileCount + 1));
+	state.outputs = malloc(sizeof(char *) * (pak->header.fileCount + 1));
+	state.converted = malloc(sizeof(bool) * (pak->header.fileCount + 1));
+	VKSK_PakFileInfo **cached = malloc(sizeof(VKSK_PakFileInfo *) * (pak->header.fileCount + 1));
+	char **cachedOutputs = malloc(sizeof(char *) * (pak->header.fileCount + 1));
+	int cachedCount = 0;
+	state.converter = converter;
+	state.data = data;
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		VKSK_PakFileInfo *info = &pak->header.files[i];
+		const char *ext = strrchr(info->filename, '.');
+		if (ext == NULL || SDL_strcasecmp(ext, extension) != 0 || info->source != NULL)
+			continue;
+		int length = directory != NULL ? strlen(directory) : 0;
+		if (directory != NULL && (strncmp(info->filename, directory, length) != 0 || info->filename[length] != '/' ||
+			strchr(info->filename + length + 1, '/') != NULL))
+			continue;
+		char output[1024];
+		uint64_t hash = _vksk_HashBytes((const uint8_t *)info->filename, strlen(info->filename), VKSK_PAK_HASH_SEED);
+		snprintf(output, 1024, "%s/%016llx%s", cacheDirectory, (unsigned long long)hash, extension);
+		struct stat stbuf;
+		if (stat(output, &stbuf) == 0 && stbuf.st_mtime > info->mtime) {
+			cached[cachedCount] = info;
+			cachedOutputs[cachedCount++] = (char *)_vksk_CopyString(output);
+		} else {
+			state.files[state.count] = info;
+			state.outputs[state.count++] = (char *)_vksk_CopyString(output);
 		}
+	}
 
-		FILE *f = fopen(file, "wb");
-		fwrite(&pak->header.endian, 4, 1, f);
-		fwrite(&pak->header.fileCount, 4, 1, f);
+	// Converters are usually decoding images so they get every core
+	int threadCount = SDL_GetCPUCount() > 1 ? SDL_GetCPUCount() : 1;
+	if (threadCount > state.count)
+		threadCount = state.count;
+	if (threadCount > 1) {
+		SDL_Thread **threads = malloc(sizeof(SDL_Thread *) * threadCount);
+		for (int i = 0; i < threadCount; i++)
+			threads[i] = SDL_CreateThread(_vksk_PakConvertWorker, "PakConvertWorker", &state);
+		for (int i = 0; i < threadCount; i++)
+			SDL_WaitThread(threads[i], NULL);
+		free(threads);
+	} else {
+		_vksk_PakConvertWorker(&state);
+	}
 
-		// Output header
-		for (int i = 0; i < pak->header.fileCount; i++) {
-			VKSK_PakFileInfo *pakFile = &pak->header.files[i];
-			int strsize = strlen(pakFile->filename);
-			fwrite(&strsize, 4, 1, f);
-			fwrite(&pakFile->size, 4, 1, f);
-			fwrite(&pakFile->pointer, 4, 1, f);
-			fwrite(pakFile->filename, 1, strsize, f);
+	// Files that failed to convert are packed as they are
+	for (int i = 0; i < state.count; i++) {
+		if (state.converted[i]) {
+			cached[cachedCount] = state.files[i];
+			cachedOutputs[cachedCount++] = state.outputs[i];
+		} else {
+			free(state.outputs[i]);
+		}
+	}
+	int converted = 0;
+	for (int i = 0; i < cachedCount; i++) {
+		struct stat stbuf;
+		if (stat(cachedOutputs[i], &stbuf) == 0) {
+			cached[i]->source = cachedOutputs[i];
+			cached[i]->size = stbuf.st_size;
+			cached[i]->mtime = stbuf.st_mtime;
+			converted++;
+		} else {
+			free(cachedOutputs[i]);
 		}
+	}
+
+	free(state.files);
+	free(state.outputs);
+	free(state.converted);
+	free(cached);
+	free(cachedOutputs);
+	return converted;
+}
+
+// Pads the file with zeros up to the next aligned offset, returning that offset
+static uint64_t _vksk_PakWritePadding(FILE *f, uint64_t pointer) {
+	static const uint8_t zeros[VKSK_PAK_ALIGNMENT] = {0};
+	uint64_t padding = (VKSK_PAK_ALIGNMENT - (pointer % VKSK_PAK_ALIGNMENT)) % VKSK_PAK_ALIGNMENT;
+	fwrite(zeros, 1, padding, f);
+	return pointer + padding;
+}
+
+// Writes the index for all of the pak's files at pointer and then the header at the top of the file
+static void _vksk_PakWriteIndex(VKSK_Pak pak, FILE *f, uint64_t pointer) {
+	uint8_t record[VKSK_PAK_RECORD_SIZE];
+	uint64_t indexSize = 0;
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		VKSK_PakFileInfo *info = &pak->header.files[i];
+		uint32_t strsize = strlen(info->filename);
+		_vksk_PutU64(record, info->pointer);
+		_vksk_PutU64(record + 8, info->storedSize);
+		_vksk_PutU64(record + 16, info->size);
+		_vksk_PutU32(record + 24, info->flags);
+		_vksk_PutU32(record + 28, strsize);
+		_vksk_PutU64(record + 32, info->contentHash);
+		_vksk_PutU64(record + 40, (uint64_t)info->mtime);
+		_vksk_PutU32(record + 48, info->checksum);
+		_vksk_PutU32(record + 52, 0);
+		fwrite(record, 1, VKSK_PAK_RECORD_SIZE, f);
+		fwrite(info->filename, 1, strsize, f);
+		indexSize += VKSK_PAK_RECORD_SIZE + strsize;
+	}
 
-		// Copy all files into the pak
-		for (int i = 0; i < pak->header.fileCount; i++) {
-			int fileSize = 0;
-			void *data = _vksk_LoadFileRaw(pak->header.files[i].filename, &fileSize);
-			fwrite(data, 1, fileSize, f);
+	uint8_t header[VKSK_PAK_HEADER_SIZE] = {0};
+	memcpy(header, VKSK_PAK_MAGIC, 8);
+	_vksk_PutU32(header + 8, VKSK_PAK_VERSION);
+	_vksk_PutU32(header + 12, pak->header.fileCount);
+	_vksk_PutU64(header + 16, pointer);
+	_vksk_PutU64(header + 24, indexSize);
+	_vksk_PutU32(header + 32, VKSK_PAK_RECORD_SIZE);
+	fseek(f, 0, SEEK_SET);
+	fwrite(header, 1, VKSK_PAK_HEADER_SIZE, f);
+}
+
+// Saving is a pipeline, worker threads each take the next block of the pak (in order), read it into a slot in a
+// ring buffer and hash/compress it there while the thread that called vksk_PakSave writes out finished slots in
+// order. The ring is the only place file data lives so memory use doesn't depend on how big the pak is.
+typedef enum {
+	SAVE_SLOT_FREE = 0,
+	SAVE_SLOT_READY = 1,
+} _vksk_PakSaveSlotState;
+
+typedef struct _vksk_PakSaveSlot {
+	_vksk_PakSaveSlotState state;
+	int sequence;   // Block of the pak this slot will hold next
+	int inputSize;
+	int outputSize; // 0 if the block didn't compress
+	uint64_t hash;
+	uint8_t *input;
+	uint8_t *output;
+} _vksk_PakSaveSlot;
+
+typedef struct _vksk_PakSaveState {
+	VKSK_Pak pak;
+	const bool *write; // Which files need writing
+	bool *tryCompress;
+	SDL_mutex *mutex;
+	SDL_cond *cond;
+	_vksk_PakSaveSlot *slots;
+	int slotCount;
+	int nextSequence; // Next block to hand out to a worker and the file/block it belongs to
+	int nextFile;
+	uint64_t nextBlock;
+} _vksk_PakSaveState;
+
+static int _vksk_PakSaveWorker(void *data) {
+	_vksk_PakSaveState *state = data;
+	VKSK_PakHeader *header = &state->pak->header;
+	int outputSize = vksk_LZCompressBound(VKSK_PAK_BLOCK_SIZE);
+	FILE *file = NULL;
+	int openFile = -1;
+
+	while (true) {
+		// Grab the next block, skipping empty files since they have none
+		SDL_LockMutex(state->mutex);
+		while (state->nextFile < header->fileCount && (state->nextBlock * VKSK_PAK_BLOCK_SIZE >= header->files[state->nextFile].size ||
+			   !state->write[state->nextFile])) {
+			state->nextFile++;
+			state->nextBlock = 0;
+		}
+		if (state->nextFile >= header->fileCount) {
+			SDL_UnlockMutex(state->mutex);
+			break;
+		}
+		int sequence = state->nextSequence++;
+		int fileIndex = state->nextFile;
+		uint64_t block = state->nextBlock++;
+		_vksk_PakSaveSlot *slot = &state->slots[sequence % state->slotCount];
+		while (slot->state != SAVE_SLOT_FREE || slot->sequence != sequence)
+			SDL_CondWait(state->cond, state->mutex);
+		SDL_UnlockMutex(state->mutex);
+
+		// Read it, workers usually get several blocks in a row from a file so it stays open between them
+		VKSK_PakFileInfo *info = &header->files[fileIndex];
+		if (openFile != fileIndex) {
+			if (file != NULL)
+				fclose(file);
+			file = fopen(_vksk_PakSourceOf(info), "rb");
+			openFile = fileIndex;
+		}
+		uint64_t remaining = info->size - (block * VKSK_PAK_BLOCK_SIZE);
+		slot->inputSize = remaining > VKSK_PAK_BLOCK_SIZE ? VKSK_PAK_BLOCK_SIZE : remaining;
+		size_t amount = 0;
+		if (file != NULL && _vksk_Seek(file, block * VKSK_PAK_BLOCK_SIZE) == 0)
+			amount = fread(slot->input, 1, slot->inputSize, file);
+		if (amount < slot->inputSize) {
+			printf("Failed to read all of \"%s\", it may have changed while packing.\n", info->filename);
+			memset(slot->input + amount, 0, slot->inputSize - amount);
+		}
+
+		// Hash and compress
+		slot->hash = _vksk_HashBytes(slot->input, slot->inputSize, VKSK_PAK_HASH_SEED);
+		slot->outputSize = 0;
+		if (state->tryCompress[fileIndex]) {
+			int compressedSize = vksk_LZCompress(slot->input, slot->inputSize, slot->output, outputSize);
+			if (compressedSize > 0 && compressedSize < slot->inputSize)
+				slot->outputSize = compressedSize;
+		}
+
+		SDL_LockMutex(state->mutex);
+		slot->state = SAVE_SLOT_READY;
+		SDL_CondBroadcast(state->cond);
+		SDL_UnlockMutex(state->mutex);
+	}
+
+	if (file != NULL)
+		fclose(file);
+	return 0;
+}
+
+// Writes every block of a file as the workers finish them, returns the sequence number after the file's last block
+static int _vksk_PakSaveWriteFile(_vksk_PakSaveState *state, FILE *f, VKSK_PakFileInfo *info, bool tryCompress, int sequence) {
+	bool compress = tryCompress;
+	uint64_t hash = VKSK_PAK_HASH_SEED;
+	uint32_t checksum = 0;
+	info->storedSize = 0;
+	info->flags = VKSK_PAK_ENTRY_CHECKSUM;
+
+	for (uint64_t done = 0; done < info->size; sequence++) {
+		_vksk_PakSaveSlot *slot = &state->slots[sequence % state->slotCount];
+		SDL_LockMutex(state->mutex);
+		while (slot->state != SAVE_SLOT_READY || slot->sequence != sequence)
+			SDL_CondWait(state->cond, state->mutex);
+		SDL_UnlockMutex(state->mutex);
+
+		// Whether or not the first block compresses well decides it for the whole file
+		if (done == 0 && compress) {
+			compress = slot->outputSize > 0 && slot->outputSize < slot->inputSize - (slot->inputSize / 16);
+			if (compress)
+				info->flags |= VKSK_PAK_ENTRY_COMPRESSED;
+		}
+
+		if (compress) {
+			uint8_t blockHeader[4];
+			_vksk_PutU32(blockHeader, slot->outputSize > 0 ? slot->outputSize : slot->inputSize | VKSK_PAK_BLOCK_RAW);
+			fwrite(blockHeader, 1, 4, f);
+			checksum = vksk_CRC32C(checksum, blockHeader, 4);
+			if (slot->outputSize > 0) {
+				fwrite(slot->output, 1, slot->outputSize, f);
+				checksum = vksk_CRC32C(checksum, slot->output, slot->outputSize);
+			} else {
+				fwrite(slot->input, 1, slot->inputSize, f);
+				checksum = vksk_CRC32C(checksum, slot->input, slot->inputSize);
+			}
+			info->storedSize += 4 + (slot->outputSize > 0 ? slot->outputSize : slot->inputSize);
+		} else {
+			fwrite(slot->input, 1, slot->inputSize, f);
+			checksum = vksk_CRC32C(checksum, slot->input, slot->inputSize);
+			info->storedSize += slot->inputSize;
+		}
+		hash = _vksk_HashCombine(hash, slot->hash);
+		done += slot->inputSize;
+
+		SDL_LockMutex(state->mutex);
+		slot->state = SAVE_SLOT_FREE;
+		slot->sequence += state->slotCount;
+		SDL_CondBroadcast(state->cond);
+		SDL_UnlockMutex(state->mutex);
+	}
+
+	info->contentHash = _vksk_HashCombine(hash, info->size);
+	info->checksum = checksum;
+	return sequence;
+}
+
+// Writes the data of every file marked in `write` starting at pointer and points duplicates (see
+// _vksk_PakDeduplicate) at what they're a copy of, returning where the data ends
+static uint64_t _vksk_PakWriteEntries(VKSK_Pak pak, FILE *f, uint64_t pointer, const bool *write, const int *sameAs) {
+	// Setup the pipeline
+	_vksk_PakSaveState state = {0};
+	int threadCount = SDL_GetCPUCount() > 1 ? SDL_GetCPUCount() : 1;
+	state.pak = pak;
+	state.write = write;
+	state.mutex = SDL_CreateMutex();
+	state.cond = SDL_CreateCond();
+	state.slotCount = threadCount * 4;
+	state.slots = calloc(state.slotCount, sizeof(struct _vksk_PakSaveSlot));
+	for (int i = 0; i < state.slotCount; i++) {
+		state.slots[i].sequence = i;
+		state.slots[i].input = malloc(VKSK_PAK_BLOCK_SIZE);
+		state.slots[i].output = malloc(vksk_LZCompressBound(VKSK_PAK_BLOCK_SIZE));
+	}
+	state.tryCompress = malloc(sizeof(bool) * (pak->header.fileCount + 1));
+	for (int i = 0; i < pak->header.fileCount; i++)
+		state.tryCompress[i] = _vksk_PakShouldCompress(pak->header.files[i].filename);
+	SDL_Thread **threads = malloc(sizeof(SDL_Thread *) * threadCount);
+	for (int i = 0; i < threadCount; i++)
+		threads[i] = SDL_CreateThread(_vksk_PakSaveWorker, "PakSaveWorker", &state);
+
+	int sequence = 0;
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		if (write[i]) {
+			VKSK_PakFileInfo *info = &pak->header.files[i];
+			pointer = _vksk_PakWritePadding(f, pointer);
+			info->pointer = pointer;
+			sequence = _vksk_PakSaveWriteFile(&state, f, info, state.tryCompress[i], sequence);
+			pointer += info->storedSize;
+		}
+	}
+
+	// Cleanup
+	for (int i = 0; i < threadCount; i++)
+		SDL_WaitThread(threads[i], NULL);
+	free(threads);
+	for (int i = 0; i < state.slotCount; i++) {
+		free(state.slots[i].input);
+		free(state.slots[i].output);
+	}
+	free(state.slots);
+	free(state.tryCompress);
+	SDL_DestroyCond(state.cond);
+	SDL_DestroyMutex(state.mutex);
+
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		if (sameAs[i] != -1) {
+			VKSK_PakFileInfo *original = &pak->header.files[sameAs[i]];
+			pak->header.files[i].pointer = original->pointer;
+			pak->header.files[i].storedSize = original->storedSize;
+			pak->header.files[i].flags = original->flags;
+			pak->header.files[i].contentHash = original->contentHash;
+			pak->header.files[i].checksum = original->checksum;
+		}
+	}
+	return pointer;
+}
+
+// Hashes a file on disk the same way the save pipeline does
+static uint64_t _vksk_HashFile(const char *filename, uint64_t size) {
+	FILE *f = fopen(filename, "rb");
+	if (f == NULL)
+		return 0;
+	uint8_t *buffer = malloc(VKSK_PAK_BLOCK_SIZE);
+	uint64_t hash = VKSK_PAK_HASH_SEED;
+	for (uint64_t done = 0; done < size;) {
+		int blockSize = size - done > VKSK_PAK_BLOCK_SIZE ? VKSK_PAK_BLOCK_SIZE : size - done;
+		size_t amount = fread(buffer, 1, blockSize, f);
+		memset(buffer + amount, 0, blockSize - amount);
+		hash = _vksk_HashCombine(hash, _vksk_HashBytes(buffer, blockSize, VKSK_PAK_HASH_SEED));
+		done += blockSize;
+	}
+	free(buffer);
+	fclose(f);
+	return _vksk_HashCombine(hash, size);
+}
+
+// Compares two files on disk byte for byte
+static bool _vksk_FilesEqual(const char *a, const char *b) {
+	FILE *fa = fopen(a, "rb");
+	FILE *fb = fopen(b, "rb");
+	bool equal = fa != NULL && fb != NULL;
+	uint8_t *bufferA = malloc(VKSK_PAK_BLOCK_SIZE);
+	uint8_t *bufferB = malloc(VKSK_PAK_BLOCK_SIZE);
+	while (equal) {
+		size_t amountA = fread(bufferA, 1, VKSK_PAK_BLOCK_SIZE, fa);
+		size_t amountB = fread(bufferB, 1, VKSK_PAK_BLOCK_SIZE, fb);
+		equal = amountA == amountB && memcmp(bufferA, bufferB, amountA) == 0;
+		if (amountA < VKSK_PAK_BLOCK_SIZE)
+			break;
+	}
+	free(bufferA);
+	free(bufferB);
+	if (fa != NULL)
+		fclose(fa);
+	if (fb != NULL)
+		fclose(fb);
+	return equal;
+}
+
+typedef struct _vksk_PakDedupKey {
+	uint64_t size;
+	uint64_t hash;
+	bool reused;
+	int index;
+} _vksk_PakDedupKey;
+
+// Orders by size then hash, with files that are already in the pak first so they become the original
+static int _vksk_CompareDedupKeys(const void *a, const void *b) {
+	const _vksk_PakDedupKey *aKey = a;
+	const _vksk_PakDedupKey *bKey = b;
+	if (aKey->size != bKey->size)
+		return aKey->size < bKey->size ? -1 : 1;
+	if (aKey->hash != bKey->hash)
+		return aKey->hash < bKey->hash ? -1 : 1;
+	if (aKey->reused != bKey->reused)
+		return aKey->reused ? -1 : 1;
+	return aKey->index - bKey->index;
+}
+
+// Finds files that are going to be written and have the same contents as another file, setting sameAs to the
+// original and unmarking them in write; sameAs is -1 for everything else. Only files that share a size with
+// another file are hashed and hash matches are compared in full, so most files are never read here.
+static void _vksk_PakDeduplicate(VKSK_Pak pak, bool *write, int *sameAs) {
+	int count = pak->header.fileCount;
+	_vksk_PakDedupKey *keys = malloc(sizeof(_vksk_PakDedupKey) * (count + 1));
+	for (int i = 0; i < count; i++) {
+		sameAs[i] = -1;
+		keys[i].size = pak->header.files[i].size;
+		keys[i].hash = 0;
+		keys[i].reused = !write[i];
+		keys[i].index = i;
+	}
+	qsort(keys, count, sizeof(_vksk_PakDedupKey), _vksk_CompareDedupKeys);
+
+	for (int start = 0; start < count;) {
+		int end = start + 1;
+		while (end < count && keys[end].size == keys[start].size)
+			end++;
+		if (end - start > 1 && keys[start].size > 0) {
+			for (int i = start; i < end; i++) {
+				VKSK_PakFileInfo *info = &pak->header.files[keys[i].index];
+				keys[i].hash = keys[i].reused ? info->contentHash : _vksk_HashFile(_vksk_PakSourceOf(info), info->size);
+			}
+			qsort(keys + start, end - start, sizeof(_vksk_PakDedupKey), _vksk_CompareDedupKeys);
+
+			// The first of each run of equal hashes is the original
+			int original = start;
+			for (int i = start + 1; i < end; i++) {
+				if (keys[i].hash != keys[original].hash) {
+					original = i;
+				} else if (!keys[i].reused) {
+					const char *originalName = _vksk_PakSourceOf(&pak->header.files[keys[original].index]);
+					if (_vksk_FilesEqual(originalName, _vksk_PakSourceOf(&pak->header.files[keys[i].index]))) {
+						sameAs[keys[i].index] = keys[original].index;
+						write[keys[i].index] = false;
+					}
+				}
+			}
 		}
+		start = end;
+	}
+	free(keys);
+}
+
+typedef struct _vksk_PakSpan {
+	uint64_t pointer;
+	uint64_t storedSize;
+} _vksk_PakSpan;
+
+static int _vksk_ComparePakSpans(const void *a, const void *b) {
+	const _vksk_PakSpan *aSpan = a;
+	const _vksk_PakSpan *bSpan = b;
+	if (aSpan->pointer != bSpan->pointer)
+		return aSpan->pointer < bSpan->pointer ? -1 : 1;
+	return 0;
+}
 
+void vksk_PakSave(VKSK_Pak pak, const char *file) {
+	if (pak->type == PAK_TYPE_WRITE) {
+		FILE *f = fopen(file, "wb");
+		if (f == NULL)
+			return;
+
+		bool *write = malloc(sizeof(bool) * (pak->header.fileCount + 1));
+		int *sameAs = malloc(sizeof(int) * (pak->header.fileCount + 1));
+		for (int i = 0; i < pak->header.fileCount; i++)
+			write[i] = true;
+		_vksk_PakDeduplicate(pak, write, sameAs);
+
+		// The header is written last once the index location is known
+		uint8_t header[VKSK_PAK_HEADER_SIZE] = {0};
+		fwrite(header, 1, VKSK_PAK_HEADER_SIZE, f);
+		uint64_t pointer = _vksk_PakWriteEntries(pak, f, VKSK_PAK_HEADER_SIZE, write, sameAs);
+		_vksk_PakWriteIndex(pak, f, _vksk_PakWritePadding(f, pointer));
 		fclose(f);
+		free(write);
+		free(sameAs);
 	}
 }
 
+bool vksk_PakSaveIncremental(VKSK_Pak pak, const char *file) {
+	if (pak->type != PAK_TYPE_WRITE)
+		return false;
+	struct stat stbuf;
+	VKSK_Pak previous = stat(file, &stbuf) == 0 ? vksk_PakLoad(file) : NULL;
+	if (previous == NULL || previous->header.version != VKSK_PAK_VERSION || previous->header.hashTable == NULL) {
+		vksk_PakFree(previous);
+		vksk_PakSave(pak, file);
+		return false;
+	}
+
+	// Files are reused if they look untouched or if they were touched but their contents are the same. Modification
+	// times are only trusted if they're older than the pak since they only have a resolution of seconds.
+	bool *write = malloc(sizeof(bool) * (pak->header.fileCount + 1));
+	_vksk_PakSpan *live = malloc(sizeof(_vksk_PakSpan) * (pak->header.fileCount + 1));
+	int liveCount = 0;
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		VKSK_PakFileInfo *info = &pak->header.files[i];
+		VKSK_PakFileInfo *old = _vksk_PakFindFile(previous, info->filename);
+		write[i] = true;
+		if (old != NULL && old->size == info->size &&
+			((old->mtime == info->mtime && info->mtime < stbuf.st_mtime) || old->contentHash == _vksk_HashFile(_vksk_PakSourceOf(info), info->size))) {
+			info->pointer = old->pointer;
+			info->storedSize = old->storedSize;
+			info->flags = old->flags;
+			info->contentHash = old->contentHash;
+			info->checksum = old->checksum;
+			write[i] = false;
+			live[liveCount].pointer = old->pointer;
+			live[liveCount++].storedSize = old->storedSize;
+		}
+	}
+	uint64_t end = previous->header.dataEnd;
+	vksk_PakFree(previous);
+
+	// Reused files may share data so each blob is only counted once, empty files have no data
+	uint64_t liveBytes = 0;
+	uint64_t lastPointer = 0;
+	qsort(live, liveCount, sizeof(_vksk_PakSpan), _vksk_ComparePakSpans);
+	for (int i = 0; i < liveCount; i++) {
+		if (live[i].storedSize > 0 && live[i].pointer != lastPointer) {
+			liveBytes += live[i].storedSize;
+			lastPointer = live[i].pointer;
+		}
+	}
+	free(live);
+
+	// Once enough of the pak is stale data it gets compacted by rebuilding it from scratch
+	uint64_t deadBytes = end > VKSK_PAK_HEADER_SIZE + liveBytes ? end - VKSK_PAK_HEADER_SIZE - liveBytes : 0;
+	FILE *f = NULL;
+	if (deadBytes <= end / 4)
+		f = fopen(file, "r+b");
+	if (f == NULL || _vksk_Seek(f, end) != 0) {
+		if (f != NULL)
+			fclose(f);
+		free(write);
+		vksk_PakSave(pak, file);
+		return false;
+	}
+
+	// New data goes after the old index so the pak stays valid until the header is rewritten at the very end
+	int *sameAs = malloc(sizeof(int) * (pak->header.fileCount + 1));
+	_vksk_PakDeduplicate(pak, write, sameAs);
+	uint64_t pointer = _vksk_PakWriteEntries(pak, f, end, write, sameAs);
+	_vksk_PakWriteIndex(pak, f, _vksk_PakWritePadding(f, pointer));
+	fclose(f);
+	free(write);
+	free(sameAs);
+	return true;
+}
+
+typedef struct _vksk_PakOrderKey {
+	int rank;
+	int index;
+	VKSK_PakFileInfo info;
+} _vksk_PakOrderKey;
+
+static int _vksk_CompareOrderKeys(const void *a, const void *b) {
+	const _vksk_PakOrderKey *aKey = a;
+	const _vksk_PakOrderKey *bKey = b;
+	if (aKey->rank != bKey->rank)
+		return aKey->rank - bKey->rank;
+	return aKey->index - bKey->index;
+}
+
+bool vksk_PakOrderFromTrace(VKSK_Pak pak, const char *traceFile) {
+	FILE *trace = fopen(traceFile, "r");
+	if (pak->type != PAK_TYPE_WRITE || trace == NULL) {
+		if (trace != NULL)
+			fclose(trace);
+		return false;
+	}
+
+	// Files get ranked by when they were first loaded, anything never loaded goes after in its current order
+	_vksk_PakOrderKey *keys = malloc(sizeof(_vksk_PakOrderKey) * (pak->header.fileCount + 1));
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		keys[i].rank = INT32_MAX;
+		keys[i].index = i;
+		keys[i].info = pak->header.files[i];
+	}
+	_vksk_PakBuildIndex(pak);
+	char line[1100];
+	int rank = 0;
+	while (fgets(line, sizeof(line), trace) != NULL) {
+		char *filename = strchr(line, '\t');
+		if (filename == NULL)
+			continue;
+		filename++;
+		filename[strcspn(filename, "\r\n")] = 0;
+		VKSK_PakFileInfo *info = _vksk_PakFindFile(pak, filename);
+		if (info != NULL && keys[info - pak->header.files].rank == INT32_MAX)
+			keys[info - pak->header.files].rank = rank++;
+	}
+	fclose(trace);
+	free(pak->header.hashTable);
+	pak->header.hashTable = NULL;
+
+	qsort(keys, pak->header.fileCount, sizeof(_vksk_PakOrderKey), _vksk_CompareOrderKeys);
+	for (int i = 0; i < pak->header.fileCount; i++)
+		pak->header.files[i] = keys[i].info;
+	free(keys);
+	return true;
+}
+
+void vksk_PakDropUnchanged(VKSK_Pak pak, const char *basePak) {
+	if (pak->type != PAK_TYPE_WRITE)
+		return;
+	VKSK_Pak base = vksk_PakLoad(basePak);
+	int kept = 0;
+	for (int i = 0; i < pak->header.fileCount; i++) {
+		VKSK_PakFileInfo *info = &pak->header.files[i];
+		VKSK_PakFileInfo *old = _vksk_PakFindFile(base, info->filename);
+		if (old != NULL && old->size == info->size && old->contentHash == _vksk_HashFile(_vksk_PakSourceOf(info), info->size)) {
+			free((void*)info->filename);
+			free((void*)info->source);
+		} else {
+			pak->header.files[kept++] = *info;
+		}
+	}
+	pak->header.fileCount = kept;
+	vksk_PakFree(base);
+}
+
+bool vksk_PakEmbed(const char *pakFile, const char *executable) {
+	FILE *exe = fopen(executable, "r+b");
+	FILE *pak = fopen(pakFile, "rb");
+	uint8_t *buffer = malloc(VKSK_PAK_BLOCK_SIZE);
+	uint8_t trailer[VKSK_PAK_TRAILER_SIZE];
+	bool ok = exe != NULL && pak != NULL && fread(trailer, 1, 8, pak) == 8 && memcmp(trailer, VKSK_PAK_MAGIC, 8) == 0;
+
+	// A pak that was already embedded is cut off and replaced
+	uint64_t end = ok ? _vksk_FileLength(exe) : 0;
+	if (ok && end >= VKSK_PAK_TRAILER_SIZE && _vksk_Seek(exe, end - VKSK_PAK_TRAILER_SIZE) == 0 &&
+		fread(trailer, 1, VKSK_PAK_TRAILER_SIZE, exe) == VKSK_PAK_TRAILER_SIZE &&
+		memcmp(trailer + 8, VKSK_PAK_EMBED_MAGIC, 8) == 0 && _vksk_GetU64(trailer) < end) {
+		end = _vksk_GetU64(trailer);
+		fflush(exe);
+#ifdef _WIN32
+		ok = _chsize_s(_fileno(exe), end) == 0;
+#else
+		ok = ftruncate(fileno(exe), end) == 0;
+#endif
+	}
+
+	// The pak is aligned the same as its contents expect and copied over as-is since its offsets are relative
+	if (ok && _vksk_Seek(exe, end) == 0) {
+		uint64_t pointer = _vksk_PakWritePadding(exe, end);
+		_vksk_Seek(pak, 0);
+		size_t amount;
+		while ((amount = fread(buffer, 1, VKSK_PAK_BLOCK_SIZE, pak)) > 0)
+			ok = ok && fwrite(buffer, 1, amount, exe) == amount;
+		_vksk_PutU64(trailer, pointer);
+		memcpy(trailer + 8, VKSK_PAK_EMBED_MAGIC, 8);
+		ok = ok && fwrite(trailer, 1, VKSK_PAK_TRAILER_SIZE, exe) == VKSK_PAK_TRAILER_SIZE;
+	} else {
+		ok = false;
+	}
+
+	free(buffer);
+	if (pak != NULL)
+		fclose(pak);
+	if (exe != NULL && fclose(exe) != 0)
+		ok = false;
+	return ok;
+}
+
 void vksk_PakFree(VKSK_Pak pak) {
 	if (pak != NULL) {
-		for (int i = 0; i < pak->header.fileCount; i++)
-			free((void*)pak->header.files[i].filename);
+		if (pak->type == PAK_TYPE_READ) {
+			_vksk_PakUnmapFile(pak);
+			_vksk_PakCloseFile(pak);
+			free(pak->header.stringArena);
+		} else if (pak->type == PAK_TYPE_LAYERED) {
+			// Filenames belong to the layers
+			for (int i = 0; i < pak->layerCount; i++)
+				vksk_PakFree(pak->layers[i]);
+			free(pak->layers);
+		} else {
+			for (int i = 0; i < pak->header.fileCount; i++) {
+				free((void*)pak->header.files[i].filename);
+				free((void*)pak->header.files[i].source);
+			}
+		}
+		free(pak->header.hashTable);
+		free(pak->header.sortedFiles);
+		free(pak->header.dirs);
+		free(pak->header.dirArena);
 		free(pak->header.files);
 		free((void*)pak->filename);
 		free(pak);
@@ -4,37 +4,112 @@
 #pragma once
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // Abstraction for packs
 typedef struct VKSK_Pak *VKSK_Pak;
 typedef struct VKSK_PakDir VKSK_PakDir;
+typedef struct VKSK_PakStream *VKSK_PakStream;
 
 struct VKSK_PakDir {
 	VKSK_Pak root;
+	int directory; // Index of the directory in the pak's directory tree, -1 if it doesn't exist
 	int fileIndex;
-	int dirsDeep;
-	char currentDir[1024];
-	char returnDir[1024];
+	int dirIndex;
 };
 
 // Loads a packs header into memory but not the contents -- you cannot modify these paks
 VKSK_Pak vksk_PakLoad(const char *filename);
 
+// Same as vksk_PakLoad but also maps the whole pak into memory so files can be viewed with vksk_PakGetFileView,
+// if the file can't be mapped the pak still works and views are simply unavailable
+VKSK_Pak vksk_PakLoadMapped(const char *filename);
+
+// Loads the pak appended to the running executable by vksk_PakEmbed, mapping it into memory the same way
+// vksk_PakLoadMapped does if `mapped` is true. Returns NULL if the executable has no pak.
+VKSK_Pak vksk_PakLoadEmbedded(bool mapped);
+
+// Makes a pak out of the loose files in a directory, filenames in it are relative to the directory so a pak of
+// "mods" will have "mods/data/thing.png" as "data/thing.png". Meant to be mounted with vksk_PakMount.
+VKSK_Pak vksk_PakLoadDirectory(const char *directory);
+
+// Creates an empty layered pak, every other pak function works on it as if it were one pak made of everything
+// mounted to it with vksk_PakMount
+VKSK_Pak vksk_PakCreateLayered();
+
+// Mounts a pak from vksk_PakLoad/vksk_PakLoadMapped/vksk_PakLoadDirectory on top of a layered pak, files in it
+// replace files with the same name in anything mounted before it. The layered pak takes ownership of `layer` and
+// frees it with itself. Returns false and does nothing if either pak is the wrong kind.
+bool vksk_PakMount(VKSK_Pak pak, VKSK_Pak layer);
+
+// Mounts every .pak file in a directory on top of a layered pak in alphabetical order, returns how many were mounted
+int vksk_PakMountPaks(VKSK_Pak pak, const char *directory, bool mapped);
+
+// Returns true if the pak was successfully mapped into memory
+bool vksk_PakIsMapped(VKSK_Pak pak);
+
 // Returns true if a file exists in a pak
 bool vksk_PakFileExists(VKSK_Pak pak, const char *filename);
 
-// Returns a binary buffer of the file, placing the size of the file into `size` (must free memory manually)
+// Returns a binary buffer of the file, placing the size of the file into `size` (must free memory manually). This
+// reads through the pak's own descriptor without any shared seek position so it may be called from several threads.
 uint8_t *vksk_PakGetFile(VKSK_Pak pak, const char *filename, int *size);
 
+// Loads several files at once, files that are near each other in the pak are read together in one read so this
+// is much faster than calling vksk_PakGetFile for each of them. buffers[i] and sizes[i] are set for filenames[i]
+// the same way vksk_PakGetFile would, and each buffer must be freed. Returns how many files were loaded.
+int vksk_PakGetFiles(VKSK_Pak pak, const char **filenames, int count, uint8_t **buffers, int *sizes);
+
+// Returns a read-only pointer directly into a mapped pak, placing the size of the file into `size`. The memory
+// belongs to the pak and is valid until it is freed. Returns NULL if the file isn't there or the pak isn't mapped.
+const uint8_t *vksk_PakGetFileView(VKSK_Pak pak, const char *filename, int *size);
+
+// Returns an ID for the data behind a file, files with identical contents share the same data in a pak so if two
+// files have the same non-zero ID their contents are the same. Returns 0 for missing or empty files.
+uint64_t vksk_PakGetBlobID(VKSK_Pak pak, const char *filename);
+
+// Returns a hash of the names and contents of every file whose name starts with `directory`, so it changes when
+// any of them are added, removed or changed. Only looks at the index so it's cheap even for big paks.
+uint64_t vksk_PakHashDirectory(VKSK_Pak pak, const char *directory);
+
 // Same as vksk_PakGetFile but ensures trailing 0
 const char *vksk_PakGetFileString(VKSK_Pak, const char *filename);
 
+// Opens a file in a pak so it can be read a piece at a time instead of all at once, compressed files are
+// decompressed as they're read. Returns NULL if the file isn't in the pak. Each stream may only be used by one
+// thread at a time but separate streams on the same pak are fine.
+VKSK_PakStream vksk_PakStreamOpen(VKSK_Pak pak, const char *filename);
+
+// Same as vksk_PakStreamOpen but for a file on disk, returns NULL if it can't be opened
+VKSK_PakStream vksk_PakStreamOpenFile(const char *filename);
+
+// Reads up to `size` bytes from the stream's current position into dst and moves past them, returns how many
+// bytes were read which is only less than `size` at the end of the file or if the read fails
+size_t vksk_PakStreamRead(VKSK_PakStream stream, void *dst, size_t size);
+
+// Moves the stream to a position in the file, returns false if the position is past the end
+bool vksk_PakStreamSeek(VKSK_PakStream stream, uint64_t position);
+
+// Returns the stream's position in the file
+uint64_t vksk_PakStreamTell(VKSK_PakStream stream);
+
+// Returns the size of the whole file
+uint64_t vksk_PakStreamSize(VKSK_PakStream stream);
+
+// Closes a stream
+void vksk_PakStreamClose(VKSK_PakStream stream);
+
+// Checks every file in a pak against its checksum right away instead of the first time each is loaded, printing
+// the ones that are corrupt and returning how many there are. Files from paks made before checksums aren't checked.
+int vksk_PakVerify(VKSK_Pak pak);
+
 // Prints a list of the pak's contents to stdout
 void vksk_PakPrintContents(VKSK_Pak);
 
 // Begins iterating through the contents of a pak starting at a given root directory, returns NULL if there are none
 // This will return either a file or a folder (folders will always end in '/'). If its a folder you will need to
-// perform another vksk_PakBeginLoop on another VKSK_PakDir to access that directory's contents.
+// perform another vksk_PakBeginLoop on another VKSK_PakDir to access that directory's contents. Files come first
+// followed by folders, each sorted by name. Only works on paks loaded with vksk_PakLoad.
 const char *vksk_PakBeginLoop(VKSK_Pak pak, VKSK_PakDir *pakdir, const char *dir);
 
 // Gets the next filename from vksk_PakBeginLoop, returns NULL if there are no more
@@ -48,8 +123,37 @@ VKSK_Pak vksk_PakCreate();
 // Places the contents of a directory into an existing pak, returns non-zero value on failure
 void vksk_PakAddDirectory(VKSK_Pak pak, const char *directory);
 
+// Converts the file `source` into some other form and writes it to `output`, returning false if the file should be
+// packed as it is instead. `data` is whatever was given to vksk_PakConvertFiles. Called from several threads at once.
+typedef bool (*VKSK_PakConverter)(const char *source, const char *output, void *data);
+
+// Runs every file in a pak being created whose name ends in `extension` through `converter`, packing what it
+// writes instead of the original under the original's name. Only files directly in `directory` are converted
+// unless it's NULL, and files that were already converted are left alone. Converted files are kept in
+// `cacheDirectory` and only converted again once the original changes, so anything in `data` that changes the
+// output needs its own cache directory. Returns how many files will be packed converted.
+int vksk_PakConvertFiles(VKSK_Pak pak, const char *directory, const char *extension, VKSK_PakConverter converter, void *data, const char *cacheDirectory);
+
 // Saves a pak created with vksk_PakCreate
 void vksk_PakSave(VKSK_Pak pak, const char *file);
 
+// Same as vksk_PakSave but if `file` is already a pak, files that haven't changed are reused and only new/changed
+// files are appended to it along with a new index. When too much of the old pak would be left unused it is rebuilt
+// from scratch instead. Returns true if the pak was updated in place and false if it was rebuilt.
+bool vksk_PakSaveIncremental(VKSK_Pak pak, const char *file);
+
+// Reorders the files in a pak being created to match the order they were first loaded in an access trace recorded
+// by the engine (see recordAccessTrace), so loading them reads the pak front to back. Files not in the trace go
+// at the end. Only takes effect on a full vksk_PakSave. Returns false if the trace couldn't be opened.
+bool vksk_PakOrderFromTrace(VKSK_Pak pak, const char *traceFile);
+
+// Removes every file from a pak being created that is identical to the same file in `basePak` so what's left
+// can be saved as a patch to be mounted on top of it
+void vksk_PakDropUnchanged(VKSK_Pak pak, const char *basePak);
+
+// Appends a saved pak to the end of an executable so vksk_PakLoadEmbedded finds it when that executable runs,
+// replacing any pak that was embedded in it before. Returns false if either file couldn't be used.
+bool vksk_PakEmbed(const char *pakFile, const char *executable);
+
 // Frees a pak from memory
 void vksk_PakFree(VKSK_Pak pak);
\ No newline at end of file
@@ -2,6 +2,7 @@
 /// \author Paolo Mazzon
 #include <VK2D/VK2D.h>
 #include <wren.h>
+#include <math.h>
 
 #include "src/JamUtil.h"
 #include "src/RendererBindings.h"
@@ -25,6 +26,7 @@ static int gLightSourcesCount = 0;
 static VK2DTexture gShadowMapTexture;
 static float gDrawnWidth;
 static float gDrawnHeight;
+static VK2DCameraIndex gLockedCamera = VK2D_DEFAULT_CAMERA; // For picking mip levels, the default camera if unlocked
 
 // For adding lights to the lighting setup
 int _vksk_RendererAddLightSource(float x, float y, float rotation, float originX, float originY, VK2DTexture tex) {
@@ -221,6 +223,53 @@ static void _vksk_DrawTexture(WrenVM *vm, VK2DTexture tex, float x, float y, flo
 		vk2dRendererDrawShader(gShader, vksk_GetShaderData(vm), tex, x, y, xScale, yScale, rot, xOrigin, yOrigin, xInTex, yInTex, wInTex, hInTex);
 }
 
+// Picks the smallest level of a texture's mip chain that is still at least as big as it will be on screen, taking
+// the camera being drawn to into account, and returns that level's scale relative to the full texture
+static VK2DTexture _vksk_PickMipLevel(_vksk_MipChain *mips, float xScale, float yScale, float *xFactor, float *yFactor) {
+	VK2DCameraSpec spec = vk2dCameraGetSpec(gLockedCamera);
+	float pixelsPerUnit = spec.zoom * (spec.w > 0 ? spec.wOnScreen / spec.w : 1);
+	float scale = fminf(fabsf(xScale), fabsf(yScale)) * pixelsPerUnit;
+	int level = 0;
+	while (level < mips->count && scale > 0 && scale <= 0.5f) {
+		scale *= 2;
+		level++;
+	}
+	if (level == 0)
+		return mips->base;
+	VK2DTexture tex = mips->levels[level - 1];
+	*xFactor = vk2dTextureWidth(mips->base) / vk2dTextureWidth(tex);
+	*yFactor = vk2dTextureHeight(mips->base) / vk2dTextureHeight(tex);
+	return tex;
+}
+
+// Draws part of a texture or surface, going through its atlas page if the texture was packed into one and drawing
+// from a smaller level of its mip chain if it's being scaled down
+static void _vksk_DrawForeignTexture(WrenVM *vm, VKSK_RuntimeForeign *tex, float x, float y, float xScale, float yScale, float rot, float xOrigin, float yOrigin, float xInTex, float yInTex, float wInTex, float hInTex) {
+	if (tex->type == FOREIGN_TEXTURE && tex->texture.region.page != NULL) {
+		if (vksk_MapTextureRegion(&tex->texture.region, &x, &y, xScale, yScale, &xOrigin, &yOrigin, &xInTex, &yInTex, &wInTex, &hInTex))
+			_vksk_DrawTexture(vm, tex->texture.tex, x, y, xScale, yScale, rot, xOrigin, yOrigin, xInTex, yInTex, wInTex, hInTex);
+	} else if (tex->type == FOREIGN_TEXTURE && tex->texture.mips != NULL && tex->texture.mipmaps) {
+		// Coordinates in the texture shrink with the level and the scale grows to make up for it
+		float xFactor = 1, yFactor = 1;
+		VK2DTexture level = _vksk_PickMipLevel(tex->texture.mips, xScale, yScale, &xFactor, &yFactor);
+		_vksk_DrawTexture(vm, level, x, y, xScale * xFactor, yScale * yFactor, rot, xOrigin / xFactor, yOrigin / yFactor, xInTex / xFactor, yInTex / yFactor, wInTex / xFactor, hInTex / yFactor);
+	} else {
+		_vksk_DrawTexture(vm, tex->texture.tex, x, y, xScale, yScale, rot, xOrigin, yOrigin, xInTex, yInTex, wInTex, hInTex);
+	}
+}
+
+static float _vksk_ForeignTextureWidth(VKSK_RuntimeForeign *tex) {
+	if (tex->type == FOREIGN_TEXTURE && tex->texture.region.page != NULL)
+		return tex->texture.region.w;
+	return vk2dTextureWidth(tex->texture.tex);
+}
+
+static float _vksk_ForeignTextureHeight(VKSK_RuntimeForeign *tex) {
+	if (tex->type == FOREIGN_TEXTURE && tex->texture.region.page != NULL)
+		return tex->texture.region.h;
+	return vk2dTextureHeight(tex->texture.tex);
+}
+
 void _vksk_RendererBindingsInit(void *textureData, int size) {
     gDefaultFontTexture = vk2dTextureFrom(textureData, size);
     gDefaultFont = juFontLoadFromTexture(gDefaultFontTexture, 32, 128, 7 * 3, 8 * 3);
@@ -281,7 +330,7 @@ void vksk_RuntimeRendererDrawTextureExt(WrenVM *vm) {
 	float rot = wrenGetSlotDouble(vm, 6);
 	float ox = wrenGetSlotDouble(vm, 7);
 	float oy = wrenGetSlotDouble(vm, 8);
-	_vksk_DrawTexture(vm, tex->texture.tex, x, y, xscale, yscale, rot, ox, oy, 0, 0, vk2dTextureWidth(tex->texture.tex), vk2dTextureHeight(tex->texture.tex));
+	_vksk_DrawForeignTexture(vm, tex, x, y, xscale, yscale, rot, ox, oy, 0, 0, _vksk_ForeignTextureWidth(tex), _vksk_ForeignTextureHeight(tex));
 }
 
 void vksk_RuntimeRendererDrawTexture(WrenVM *vm) {
@@ -290,7 +339,7 @@ void vksk_RuntimeRendererDrawTexture(WrenVM *vm) {
 	VKSK_RuntimeForeign *tex = wrenGetSlotForeign(vm, 1);
 	float x = wrenGetSlotDouble(vm, 2);
 	float y = wrenGetSlotDouble(vm, 3);
-	_vksk_DrawTexture(vm, tex->texture.tex, x, y, 1, 1, 0, 0, 0, 0, 0, vk2dTextureWidth(tex->texture.tex), vk2dTextureHeight(tex->texture.tex));
+	_vksk_DrawForeignTexture(vm, tex, x, y, 1, 1, 0, 0, 0, 0, 0, _vksk_ForeignTextureWidth(tex), _vksk_ForeignTextureHeight(tex));
 }
 
 void vksk_RuntimeRendererDrawTexturePartExt(WrenVM *vm) {
@@ -308,7 +357,7 @@ void vksk_RuntimeRendererDrawTexturePartExt(WrenVM *vm) {
 	float yt = wrenGetSlotDouble(vm, 10);
 	float tw = wrenGetSlotDouble(vm, 11);
 	float th = wrenGetSlotDouble(vm, 12);
-	_vksk_DrawTexture(vm, tex->texture.tex, x, y, xscale, yscale, rot, ox, oy, xt, yt, tw, th);
+	_vksk_DrawForeignTexture(vm, tex, x, y, xscale, yscale, rot, ox, oy, xt, yt, tw, th);
 }
 
 void vksk_RuntimeRendererDrawTexturePart(WrenVM *vm) {
@@ -321,7 +370,7 @@ void vksk_RuntimeRendererDrawTexturePart(WrenVM *vm) {
 	float yt = wrenGetSlotDouble(vm, 5);
 	float tw = wrenGetSlotDouble(vm, 6);
 	float th = wrenGetSlotDouble(vm, 7);
-	_vksk_DrawTexture(vm, tex->texture.tex, x, y, 1, 1, 0, 0, 0, xt, yt, tw, th);
+	_vksk_DrawForeignTexture(vm, tex, x, y, 1, 1, 0, 0, 0, xt, yt, tw, th);
 }
 
 // vksk_RuntimeRendererGetConfig() - get_config()
@@ -464,16 +513,19 @@ void vksk_RuntimeRendererGetAverageFrameTime(WrenVM *vm) {
 void vksk_RuntimeRendererLockCameras(WrenVM *vm) {
 	if (wrenGetSlotType(vm, 1) == WREN_TYPE_NULL) {
 		vk2dRendererLockCameras(VK2D_DEFAULT_CAMERA);
+		gLockedCamera = VK2D_DEFAULT_CAMERA;
 	} else {
 		VALIDATE_FOREIGN_ARGS(vm, FOREIGN_CAMERA, FOREIGN_END)
 		VKSK_RuntimeForeign *cam = wrenGetSlotForeign(vm, 1);
 		vk2dRendererLockCameras(cam->camera.index);
+		gLockedCamera = cam->camera.index;
 	}
 }
 
 // vksk_RuntimeRendererUnlockCameras() - unlock_cameras()
 void vksk_RuntimeRendererUnlockCameras(WrenVM *vm) {
 	vk2dRendererUnlockCameras();
+	gLockedCamera = VK2D_DEFAULT_CAMERA;
 }
 
 // vksk_RuntimeRendererClear() - clear()
@@ -595,6 +647,40 @@ void vksk_RuntimeRendererDrawFontExtWrapped(WrenVM *vm) {
 }
 
 
+// Draws one cell of a sprite, the cells go left to right from the sprite's x/y wrapping at the edge of its texture
+static void _vksk_DrawSpriteCell(WrenVM *vm, VKSK_RuntimeForeign *spr, int index, float x, float y) {
+	JUSprite sprite = spr->sprite.spr;
+	_vksk_TextureRegion *region = &spr->sprite.region;
+	float texWidth = region->page != NULL ? region->w : vk2dTextureWidth(sprite->Internal.tex);
+
+	// Calculate where in the texture to draw
+	float drawX = roundf(sprite->x + ((int)(index * sprite->Internal.w) % (int)(texWidth - sprite->x)));
+	float drawY = roundf(sprite->y + (sprite->Internal.h * floorf((index * sprite->Internal.w) / (texWidth - sprite->x))));
+	float drawW = sprite->Internal.w;
+	float drawH = sprite->Internal.h;
+	float originX = sprite->originX;
+	float originY = sprite->originY;
+	x -= sprite->originX * sprite->scaleX;
+	y -= sprite->originY * sprite->scaleY;
+	if (region->page != NULL && !vksk_MapTextureRegion(region, &x, &y, sprite->scaleX, sprite->scaleY, &originX, &originY, &drawX, &drawY, &drawW, &drawH))
+		return;
+
+	_vksk_DrawTexture(
+			vm,
+			sprite->Internal.tex,
+			x,
+			y,
+			sprite->scaleX,
+			sprite->scaleY,
+			sprite->rotation,
+			originX,
+			originY,
+			drawX,
+			drawY,
+			drawW,
+			drawH);
+}
+
 void vksk_RuntimeRendererDrawSpritePos(WrenVM *vm) {
 	VALIDATE_FOREIGN_ARGS(vm, FOREIGN_SPRITE, FOREIGN_NUM, FOREIGN_NUM, FOREIGN_END)
 	CHECK_VALID_DRAW()
@@ -605,24 +691,7 @@ void vksk_RuntimeRendererDrawSpritePos(WrenVM *vm) {
 		spr->sprite.spr->Internal.lastTime = SDL_GetPerformanceCounter();
 	}
 
-	// Calculate where in the texture to draw
-	float drawX = roundf(spr->sprite.spr->x + ((int)(spr->sprite.spr->Internal.frame * spr->sprite.spr->Internal.w) % (int)(vk2dTextureWidth(spr->sprite.spr->Internal.tex) - spr->sprite.spr->x)));
-	float drawY = roundf(spr->sprite.spr->y + (spr->sprite.spr->Internal.h * floorf((spr->sprite.spr->Internal.frame * spr->sprite.spr->Internal.w) / (vk2dTextureWidth(spr->sprite.spr->Internal.tex) - spr->sprite.spr->x))));
-
-	_vksk_DrawTexture(
-			vm,
-			spr->sprite.spr->Internal.tex,
-			wrenGetSlotDouble(vm, 2) - (spr->sprite.spr->originX * spr->sprite.spr->scaleX),
-			wrenGetSlotDouble(vm, 3) - (spr->sprite.spr->originY * spr->sprite.spr->scaleY),
-			spr->sprite.spr->scaleX,
-			spr->sprite.spr->scaleY,
-			spr->sprite.spr->rotation,
-			spr->sprite.spr->originX,
-			spr->sprite.spr->originY,
-			drawX,
-			drawY,
-			spr->sprite.spr->Internal.w,
-			spr->sprite.spr->Internal.h);
+	_vksk_DrawSpriteCell(vm, spr, spr->sprite.spr->Internal.frame, wrenGetSlotDouble(vm, 2), wrenGetSlotDouble(vm, 3));
 }
 
 void vksk_RuntimeRendererDrawSpriteFrame(WrenVM *vm) {
@@ -630,26 +699,8 @@ void vksk_RuntimeRendererDrawSpriteFrame(WrenVM *vm) {
 	CHECK_VALID_DRAW()
 	VKSK_RuntimeForeign *spr = wrenGetSlotForeign(vm, 1);
 	int index = (int)wrenGetSlotDouble(vm, 2);
-	if (index >= 0 && index < spr->sprite.spr->Internal.frames) {
-		// Calculate where in the texture to draw
-		float drawX = roundf(spr->sprite.spr->x + ((int)(index * spr->sprite.spr->Internal.w) % (int)(vk2dTextureWidth(spr->sprite.spr->Internal.tex) - spr->sprite.spr->x)));
-		float drawY = roundf(spr->sprite.spr->y + (spr->sprite.spr->Internal.h * floorf((index * spr->sprite.spr->Internal.w) / (vk2dTextureWidth(spr->sprite.spr->Internal.tex) - spr->sprite.spr->x))));
-
-		_vksk_DrawTexture(
-				vm,
-				spr->sprite.spr->Internal.tex,
-				wrenGetSlotDouble(vm, 3) - (spr->sprite.spr->originX * spr->sprite.spr->scaleX),
-				wrenGetSlotDouble(vm, 4) - (spr->sprite.spr->originY * spr->sprite.spr->scaleY),
-				spr->sprite.spr->scaleX,
-				spr->sprite.spr->scaleY,
-				spr->sprite.spr->rotation,
-				spr->sprite.spr->originX,
-				spr->sprite.spr->originY,
-				drawX,
-				drawY,
-				spr->sprite.spr->Internal.w,
-				spr->sprite.spr->Internal.h);
-	}
+	if (index >= 0 && index < spr->sprite.spr->Internal.frames)
+		_vksk_DrawSpriteCell(vm, spr, index, wrenGetSlotDouble(vm, 3), wrenGetSlotDouble(vm, 4));
 }
 
 void vksk_RuntimeRendererDrawModel(WrenVM *vm) {
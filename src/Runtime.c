@@ -11,6 +11,7 @@
 #include "src/Validation.h"
 #include "src/IntermediateTypes.h"
 #include "src/Blobs.h"
+#include "src/Util.h"
 
 extern Uint32 rmask, gmask, bmask, amask;
 
@@ -181,12 +182,26 @@ void vksk_Start() {
 
 	// Load game pak
 	vksk_Log("Locating game pak...");
-	// Load pak file
-	if (gEngineConfig.disableGamePak || !_vk2dFileExists("game.pak")) {
+	// Load pak file, a pak embedded in the executable is used over game.pak
+	VKSK_Pak basePak = NULL;
+	bool embedded = false;
+	if (!gEngineConfig.disableGamePak) {
+		basePak = vksk_PakLoadEmbedded(!gEngineConfig.disablePakMapping);
+		embedded = basePak != NULL;
+		if (basePak == NULL && _vk2dFileExists("game.pak"))
+			basePak = gEngineConfig.disablePakMapping ? vksk_PakLoad("game.pak") : vksk_PakLoadMapped("game.pak");
+	}
+	if (basePak == NULL) {
 		gGamePak = NULL;
 	} else {
-		gGamePak = vksk_PakLoad("game.pak");
-		vksk_Log("Game pak located and loaded.");
+		// game.pak is the base layer, paks in paks/ (DLC, patches) go on top of it in alphabetical order and loose
+		// files in override/ go on top of everything
+		gGamePak = vksk_PakCreateLayered();
+		vksk_PakMount(gGamePak, basePak);
+		int extraPaks = vksk_PakMountPaks(gGamePak, "paks", !gEngineConfig.disablePakMapping);
+		if (!gEngineConfig.disableOverrideDirectory)
+			vksk_PakMount(gGamePak, vksk_PakLoadDirectory("override"));
+		vksk_Log("Game pak located %sand loaded along with %i other paks.", embedded ? "in the executable " : "", extraPaks);
 	}
 
 	// Compile the assets code
@@ -282,7 +297,9 @@ void vksk_Start() {
 
 	// Load assets
 	vksk_Log("Loading assets...");
+	vksk_PrefetchAssetFiles();
 	wrenInterpret(vm, "__top__", "import \"Assets\" for Assets\nAssets.load_assets()\n");
+	vksk_DropPrefetchedFiles();
 
 	// Stop the garbage collector from deleting the assets
 	wrenEnsureSlots(vm, 1);
@@ -447,6 +464,7 @@ void vksk_Start() {
 	SDL_DestroyWindow(gWindow);
     SDL_Quit();
 	vksk_PakFree(gGamePak);
+	vksk_CloseAccessTrace();
 	vksk_Log("Cleanup complete.\n---------------FPS---------------\n   Average | Minimum | Maximum\n   %7.2f | %7.2f | %7.2f\n---------------------------------", totalFrameCount / finalTime, minFPS, maxFPS);
 }
 /*
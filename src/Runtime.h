@@ -15,6 +15,13 @@ typedef struct VKSK_EngineConfig {
 	bool enableDebugOverlay;
 	bool enableAssetsPrint;
 	bool disableGamePak;
+	bool disablePakMapping;
+	bool disableOverrideDirectory;
+	bool recordAccessTrace;
+	bool disableAssetCache;
+	bool disableFontCache;
+	bool lazyAssets;
+	bool atlasTextures;
 	bool gcBetweenLevels;
 	int argc;
 	const char **argv;
@@ -26,9 +33,23 @@ extern VKSK_Pak gGamePak;
 // Starts the runtime
 void vksk_Start();
 
-// Searches through the assets folder and makes a wren source file loading it all
+// Searches through the assets folder and makes a wren source file with getters for all of it, the assets themselves
+// are listed in a binary manifest that vksk_RuntimeAssetsLoadManifest loads them from
 const char *vksk_CompileAssetFile(const char *rootDir);
 
+// Lists every asset in the manifest of the last compiled assets file and returns a list for each directory for them
+// to go in, loading them all unless lazyAssets is set
+void vksk_RuntimeAssetsLoadManifest(WrenVM *vm);
+
+// Loads an asset from the manifest by its index or asset map key if it isn't loaded already, returning it
+void vksk_RuntimeAssetsLoadAsset(WrenVM *vm);
+
+// Loads every asset in a directory relative to the assets root and its sub-directories that isn't loaded already
+void vksk_RuntimeAssetsPreload(WrenVM *vm);
+
+// Prefetches every file the last compiled assets file loads from game.pak so load_assets doesn't wait on each one
+void vksk_PrefetchAssetFiles();
+
 // Returns teh wren vm
 WrenVM *vksk_GetVM();
 
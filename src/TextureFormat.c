@@ -0,0 +1,874 @@
+/// \file TextureFormat.c
+/// \author Paolo Mazzon
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <VK2D/stb_image.h>
+
+#include "src/TextureFormat.h"
+#include "src/Compression.h"
+
+/*
+ * Texture file specification (version 2)
+ *
+ * All numbers are little-endian. The file starts with a header of
+ *  + 8 bytes for the magic "ASTROTEX"
+ *  + 4 bytes for the version (2)
+ *  + 4 bytes for the format of the first level's pixels (VKSK_TEXTURE_FORMAT_*)
+ *  + 4 bytes for the width
+ *  + 4 bytes for the height
+ *  + 4 bytes for the number of levels
+ * followed by each level of the mip chain, starting with the full image. Level i is the image scaled down to
+ * max(1, width >> i) by max(1, height >> i), and there are at most enough levels to reach 1x1. Each level is
+ *  + 4 bytes for the format of the pixels (VKSK_TEXTURE_FORMAT_*)
+ *  + 4 bytes for the size of the pixels in bytes
+ *  + the pixels
+ * Version 1 files have no level count and are a single level whose pixels are the rest of the file, in the format
+ * from the header. VKSK_TEXTURE_FORMAT_RGBA is width * height RGBA pixels as-is, row by row from the top.
+ * VKSK_TEXTURE_FORMAT_QOI is the same pixels in the same order stored as a list of the following chunks, each
+ * describing one or more pixels in terms of the previous pixel (which starts as 0, 0, 0, 255) and a table of 64
+ * recently seen pixels (which starts as all zeros) indexed by (r * 3 + g * 5 + b * 7 + a * 11) % 64
+ *  + 0b00iiiiii: the pixel at index i in the table
+ *  + 0b01rrggbb: the previous pixel with each of r, g and b changed by the 2 bit value - 2
+ *  + 0b10gggggg 0brrrrbbbb: the previous pixel with g changed by g - 32, and r and b changed by the same amount
+ *    as g plus r - 8 and b - 8
+ *  + 0b11llllll (l < 62): the previous pixel repeated l + 1 times
+ *  + 0xFE r g b: the previous pixel's alpha with a new r, g and b
+ *  + 0xFF r g b a: a new pixel
+ * The pixel from every chunk but a run is put in the table. All arithmetic on components wraps around at 256.
+ * VKSK_TEXTURE_FORMAT_BC1, VKSK_TEXTURE_FORMAT_BC3 and VKSK_TEXTURE_FORMAT_BC7 are the GPU block compression
+ * formats of the same name, each 4x4 block of pixels stored as 8, 16 and 16 bytes respectively, blocks row by row
+ * from the top. Images that aren't a multiple of 4 have the partial blocks at their edges filled out by repeating
+ * the last row/column. BC7 blocks are always mode 6. VKSK_TEXTURE_FORMAT_ALPHA is just the alpha of each pixel in
+ * the same order compressed with vksk_LZCompress (see Compression.h), the colour of every pixel being white.
+ */
+
+#define VKSK_TEXTURE_MAGIC "ASTROTEX"
+#define VKSK_TEXTURE_VERSION 2
+#define VKSK_TEXTURE_HEADER_SIZE 24 // Version 1 header, version 2 adds the level count
+#define VKSK_TEXTURE_LEVEL_HEADER_SIZE 8
+#define VKSK_TEXTURE_MAX_SIZE 16384 // Largest width or height, keeps width * height * 4 in an int
+#define VKSK_TEXTURE_FORMAT_RGBA 0
+#define VKSK_TEXTURE_FORMAT_QOI 1
+#define VKSK_TEXTURE_FORMAT_BC1 2
+#define VKSK_TEXTURE_FORMAT_BC3 3
+#define VKSK_TEXTURE_FORMAT_BC7 4
+#define VKSK_TEXTURE_FORMAT_ALPHA 5
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF 0x40
+#define QOI_OP_LUMA 0x80
+#define QOI_OP_RUN 0xC0
+#define QOI_OP_RGB 0xFE
+#define QOI_OP_RGBA 0xFF
+#define QOI_MASK 0xC0
+#define QOI_MAX_RUN 62
+
+static uint32_t _vksk_GetU32(const uint8_t *p) {
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void _vksk_PutU32(uint8_t *p, uint32_t val) {
+	p[0] = val & 0xFF;
+	p[1] = (val >> 8) & 0xFF;
+	p[2] = (val >> 16) & 0xFF;
+	p[3] = (val >> 24) & 0xFF;
+}
+
+static int _vksk_QOIHash(const uint8_t *px) {
+	return (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+}
+
+// Writes the chunks for every pixel into out, which must hold at least w * h * 5 bytes, and returns how many bytes
+static int _vksk_QOIEncode(const uint8_t *pixels, int pixelCount, uint8_t *out) {
+	uint8_t table[64][4] = {0};
+	uint8_t prev[4] = {0, 0, 0, 255};
+	int pos = 0;
+	int run = 0;
+	for (int i = 0; i < pixelCount; i++) {
+		const uint8_t *px = &pixels[i * 4];
+		if (memcmp(px, prev, 4) == 0) {
+			run++;
+			if (run == QOI_MAX_RUN || i == pixelCount - 1) {
+				out[pos++] = QOI_OP_RUN | (run - 1);
+				run = 0;
+			}
+			continue;
+		}
+		if (run > 0) {
+			out[pos++] = QOI_OP_RUN | (run - 1);
+			run = 0;
+		}
+
+		int index = _vksk_QOIHash(px);
+		if (memcmp(table[index], px, 4) == 0) {
+			out[pos++] = QOI_OP_INDEX | index;
+		} else {
+			memcpy(table[index], px, 4);
+			if (px[3] == prev[3]) {
+				int8_t dr = px[0] - prev[0];
+				int8_t dg = px[1] - prev[1];
+				int8_t db = px[2] - prev[2];
+				int8_t drg = dr - dg;
+				int8_t dbg = db - dg;
+				if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+					out[pos++] = QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2);
+				} else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+					out[pos++] = QOI_OP_LUMA | (dg + 32);
+					out[pos++] = ((drg + 8) << 4) | (dbg + 8);
+				} else {
+					out[pos++] = QOI_OP_RGB;
+					memcpy(&out[pos], px, 3);
+					pos += 3;
+				}
+			} else {
+				out[pos++] = QOI_OP_RGBA;
+				memcpy(&out[pos], px, 4);
+				pos += 4;
+			}
+		}
+		memcpy(prev, px, 4);
+	}
+	return pos;
+}
+
+// Decodes exactly pixelCount pixels into out, returns false if the chunks run out first or don't end there
+static bool _vksk_QOIDecode(const uint8_t *data, int size, uint8_t *out, int pixelCount) {
+	uint8_t table[64][4] = {0};
+	uint8_t px[4] = {0, 0, 0, 255};
+	int pos = 0;
+	for (int i = 0; i < pixelCount;) {
+		if (pos >= size)
+			return false;
+		uint8_t op = data[pos++];
+		int run = 0; // Only set for runs
+		if (op == QOI_OP_RGB) {
+			if (size - pos < 3)
+				return false;
+			memcpy(px, &data[pos], 3);
+			pos += 3;
+		} else if (op == QOI_OP_RGBA) {
+			if (size - pos < 4)
+				return false;
+			memcpy(px, &data[pos], 4);
+			pos += 4;
+		} else if ((op & QOI_MASK) == QOI_OP_INDEX) {
+			memcpy(px, table[op], 4);
+		} else if ((op & QOI_MASK) == QOI_OP_DIFF) {
+			px[0] += ((op >> 4) & 3) - 2;
+			px[1] += ((op >> 2) & 3) - 2;
+			px[2] += (op & 3) - 2;
+		} else if ((op & QOI_MASK) == QOI_OP_LUMA) {
+			if (pos >= size)
+				return false;
+			int dg = (op & 0x3F) - 32;
+			uint8_t second = data[pos++];
+			px[0] += dg + (second >> 4) - 8;
+			px[1] += dg;
+			px[2] += dg + (second & 0x0F) - 8;
+		} else {
+			run = (op & 0x3F) + 1;
+			if (run > pixelCount - i)
+				return false;
+		}
+		if (run == 0) {
+			memcpy(table[_vksk_QOIHash(px)], px, 4);
+			run = 1;
+		}
+		for (; run > 0; run--, i++)
+			memcpy(&out[i * 4], px, 4);
+	}
+	return pos == size;
+}
+
+/*************** Block compression ***************/
+// 4 bit BC7 interpolation weights out of 64
+static const int gBC7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// Copies the 4x4 block at bx, by out of an image, repeating the last row/column past the edges
+static void _vksk_BlockGather(const uint8_t *pixels, int w, int h, int bx, int by, uint8_t block[16][4]) {
+	for (int y = 0; y < 4; y++) {
+		int py = by * 4 + y < h ? by * 4 + y : h - 1;
+		for (int x = 0; x < 4; x++) {
+			int px = bx * 4 + x < w ? bx * 4 + x : w - 1;
+			memcpy(block[y * 4 + x], &pixels[(py * w + px) * 4], 4);
+		}
+	}
+}
+
+// Copies the part of a 4x4 block that is inside the image into it
+static void _vksk_BlockScatter(uint8_t block[16][4], uint8_t *pixels, int w, int h, int bx, int by) {
+	for (int y = 0; y < 4 && by * 4 + y < h; y++)
+		for (int x = 0; x < 4 && bx * 4 + x < w; x++)
+			memcpy(&pixels[((by * 4 + y) * w + bx * 4 + x) * 4], block[y * 4 + x], 4);
+}
+
+// Finds the ends of the line that best fits the first `channels` components of the pixels in `use`, found along
+// their principal axis
+static void _vksk_BlockFitLine(uint8_t block[16][4], const bool *use, int channels, float lo[4], float hi[4]) {
+	float mean[4] = {0};
+	int count = 0;
+	for (int i = 0; i < 16; i++) {
+		if (use[i]) {
+			for (int c = 0; c < channels; c++)
+				mean[c] += block[i][c];
+			count++;
+		}
+	}
+	for (int c = 0; c < channels; c++)
+		mean[c] = count > 0 ? mean[c] / count : 0;
+
+	float covariance[4][4] = {0};
+	for (int i = 0; i < 16; i++)
+		for (int a = 0; a < channels && use[i]; a++)
+			for (int b = 0; b < channels; b++)
+				covariance[a][b] += (block[i][a] - mean[a]) * (block[i][b] - mean[b]);
+
+	// A few rounds of power iteration is plenty for 16 points
+	float axis[4] = {1, 1, 1, 1};
+	for (int round = 0; round < 8; round++) {
+		float next[4] = {0};
+		float length = 0;
+		for (int a = 0; a < channels; a++) {
+			for (int b = 0; b < channels; b++)
+				next[a] += covariance[a][b] * axis[b];
+			length += next[a] * next[a];
+		}
+		if (length < 1e-12f)
+			break;
+		length = sqrtf(length);
+		for (int a = 0; a < channels; a++)
+			axis[a] = next[a] / length;
+	}
+
+	float tMin = 0, tMax = 0;
+	for (int i = 0; i < 16; i++) {
+		if (use[i]) {
+			float t = 0;
+			for (int c = 0; c < channels; c++)
+				t += (block[i][c] - mean[c]) * axis[c];
+			tMin = t < tMin ? t : tMin;
+			tMax = t > tMax ? t : tMax;
+		}
+	}
+	for (int c = 0; c < 4; c++) {
+		lo[c] = c < channels ? mean[c] + axis[c] * tMin : 255;
+		hi[c] = c < channels ? mean[c] + axis[c] * tMax : 255;
+		lo[c] = lo[c] < 0 ? 0 : (lo[c] > 255 ? 255 : lo[c]);
+		hi[c] = hi[c] < 0 ? 0 : (hi[c] > 255 ? 255 : hi[c]);
+	}
+}
+
+static int _vksk_ColourDistance(const uint8_t *a, const uint8_t *b, int channels) {
+	int distance = 0;
+	for (int c = 0; c < channels; c++)
+		distance += (a[c] - b[c]) * (a[c] - b[c]);
+	return distance;
+}
+
+static uint16_t _vksk_To565(const float *colour) {
+	return ((int)(colour[0] * 31 / 255 + 0.5f) << 11) | ((int)(colour[1] * 63 / 255 + 0.5f) << 5) | (int)(colour[2] * 31 / 255 + 0.5f);
+}
+
+// Palette of a BC1 colour block, BC3 blocks are always decoded as four colours
+static void _vksk_BC1Palette(uint16_t c0, uint16_t c1, bool fourColour, uint8_t palette[4][4]) {
+	uint16_t ends[2] = {c0, c1};
+	for (int i = 0; i < 2; i++) {
+		int r = (ends[i] >> 11) & 31, g = (ends[i] >> 5) & 63, b = ends[i] & 31;
+		palette[i][0] = (r << 3) | (r >> 2);
+		palette[i][1] = (g << 2) | (g >> 4);
+		palette[i][2] = (b << 3) | (b >> 2);
+		palette[i][3] = 255;
+	}
+	for (int c = 0; c < 3; c++) {
+		if (fourColour) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+		} else {
+			palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+			palette[3][c] = 0;
+		}
+	}
+	palette[2][3] = 255;
+	palette[3][3] = fourColour ? 255 : 0;
+}
+
+// Pixels with alpha under 128 are made transparent unless `opaque`, which BC3 colour blocks are
+static void _vksk_BC1EncodeBlock(uint8_t block[16][4], bool opaque, uint8_t *out) {
+	bool use[16];
+	bool transparent = false;
+	bool any = false;
+	for (int i = 0; i < 16; i++) {
+		use[i] = opaque || block[i][3] >= 128;
+		transparent = transparent || !use[i];
+		any = any || use[i];
+	}
+
+	float lo[4], hi[4];
+	_vksk_BlockFitLine(block, use, 3, lo, hi);
+	uint16_t c0 = any ? _vksk_To565(hi) : 0;
+	uint16_t c1 = any ? _vksk_To565(lo) : 0;
+
+	// Four colours needs c0 > c1 and transparency needs c0 <= c1, except in BC3 which is always four colours
+	if ((c0 < c1 && !transparent) || (c0 > c1 && transparent)) {
+		uint16_t temp = c0;
+		c0 = c1;
+		c1 = temp;
+	}
+	bool fourColour = opaque || c0 > c1;
+	uint8_t palette[4][4];
+	_vksk_BC1Palette(c0, c1, fourColour, palette);
+
+	uint32_t indices = 0;
+	for (int i = 0; i < 16; i++) {
+		int best = 3;
+		if (use[i]) {
+			int bestDistance = INT_MAX;
+			for (int p = 0; p < (fourColour ? 4 : 3); p++) {
+				int distance = _vksk_ColourDistance(block[i], palette[p], 3);
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					best = p;
+				}
+			}
+		}
+		indices |= (uint32_t)best << (i * 2);
+	}
+	out[0] = c0 & 0xFF;
+	out[1] = c0 >> 8;
+	out[2] = c1 & 0xFF;
+	out[3] = c1 >> 8;
+	_vksk_PutU32(out + 4, indices);
+}
+
+static void _vksk_BC1DecodeBlock(const uint8_t *in, bool bc3, uint8_t block[16][4]) {
+	uint16_t c0 = in[0] | (in[1] << 8);
+	uint16_t c1 = in[2] | (in[3] << 8);
+	uint8_t palette[4][4];
+	_vksk_BC1Palette(c0, c1, bc3 || c0 > c1, palette);
+	uint32_t indices = _vksk_GetU32(in + 4);
+	for (int i = 0; i < 16; i++) {
+		// BC3 only takes colour from here
+		const uint8_t *colour = palette[(indices >> (i * 2)) & 3];
+		memcpy(block[i], colour, bc3 ? 3 : 4);
+	}
+}
+
+// Palette of a BC3 alpha block
+static void _vksk_BC3AlphaPalette(uint8_t a0, uint8_t a1, uint8_t palette[8]) {
+	palette[0] = a0;
+	palette[1] = a1;
+	if (a0 > a1) {
+		for (int i = 1; i < 7; i++)
+			palette[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+	} else {
+		for (int i = 1; i < 5; i++)
+			palette[i + 1] = ((5 - i) * a0 + i * a1 + 2) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+static void _vksk_BC3EncodeAlpha(uint8_t block[16][4], uint8_t *out) {
+	uint8_t a0 = 0, a1 = 255;
+	for (int i = 0; i < 16; i++) {
+		a0 = block[i][3] > a0 ? block[i][3] : a0;
+		a1 = block[i][3] < a1 ? block[i][3] : a1;
+	}
+	uint8_t palette[8];
+	_vksk_BC3AlphaPalette(a0, a1, palette);
+	uint64_t indices = 0;
+	for (int i = 0; i < 16; i++) {
+		int best = 0;
+		for (int p = 1; p < 8; p++)
+			if (abs(block[i][3] - palette[p]) < abs(block[i][3] - palette[best]))
+				best = p;
+		indices |= (uint64_t)best << (i * 3);
+	}
+	out[0] = a0;
+	out[1] = a1;
+	for (int i = 0; i < 6; i++)
+		out[2 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+static void _vksk_BC3DecodeAlpha(const uint8_t *in, uint8_t block[16][4]) {
+	uint8_t palette[8];
+	_vksk_BC3AlphaPalette(in[0], in[1], palette);
+	uint64_t indices = 0;
+	for (int i = 0; i < 6; i++)
+		indices |= (uint64_t)in[2 + i] << (i * 8);
+	for (int i = 0; i < 16; i++)
+		block[i][3] = palette[(indices >> (i * 3)) & 7];
+}
+
+// BC7 blocks are one 128 bit number stored from its lowest bit up
+static void _vksk_PutBits(uint8_t *block, int *pos, uint32_t value, int count) {
+	for (int i = 0; i < count; i++, (*pos)++)
+		if ((value >> i) & 1)
+			block[*pos / 8] |= 1 << (*pos % 8);
+}
+
+static uint32_t _vksk_GetBits(const uint8_t *block, int *pos, int count) {
+	uint32_t value = 0;
+	for (int i = 0; i < count; i++, (*pos)++)
+		value |= (uint32_t)((block[*pos / 8] >> (*pos % 8)) & 1) << i;
+	return value;
+}
+
+static void _vksk_BC7Interpolate(const uint8_t e0[4], const uint8_t e1[4], int index, uint8_t out[4]) {
+	for (int c = 0; c < 4; c++)
+		out[c] = ((64 - gBC7Weights[index]) * e0[c] + gBC7Weights[index] * e1[c] + 32) >> 6;
+}
+
+// Mode 6 only: one pair of 7 bit RGBA endpoints each with a shared low bit and 4 bit indices
+static void _vksk_BC7EncodeBlock(uint8_t block[16][4], uint8_t *out) {
+	bool use[16];
+	for (int i = 0; i < 16; i++)
+		use[i] = true;
+	float ends[2][4];
+	_vksk_BlockFitLine(block, use, 4, ends[0], ends[1]);
+
+	// Whichever low bit gets each endpoint closest to where it should be
+	uint8_t endpoints[2][4];
+	int codes[2][4];
+	int pBits[2];
+	for (int e = 0; e < 2; e++) {
+		int bestError = INT_MAX;
+		for (int p = 0; p < 2; p++) {
+			int error = 0;
+			int trial[4];
+			for (int c = 0; c < 4; c++) {
+				int code = (int)((ends[e][c] - p) / 2 + 0.5f);
+				trial[c] = code < 0 ? 0 : (code > 127 ? 127 : code);
+				int value = (trial[c] << 1) | p;
+				error += (value - ends[e][c]) * (value - ends[e][c]);
+			}
+			if (error < bestError) {
+				bestError = error;
+				pBits[e] = p;
+				for (int c = 0; c < 4; c++) {
+					codes[e][c] = trial[c];
+					endpoints[e][c] = (trial[c] << 1) | p;
+				}
+			}
+		}
+	}
+
+	int indices[16];
+	for (int i = 0; i < 16; i++) {
+		int bestDistance = INT_MAX;
+		for (int index = 0; index < 16; index++) {
+			uint8_t colour[4];
+			_vksk_BC7Interpolate(endpoints[0], endpoints[1], index, colour);
+			int distance = _vksk_ColourDistance(block[i], colour, 4);
+			if (distance < bestDistance) {
+				bestDistance = distance;
+				indices[i] = index;
+			}
+		}
+	}
+
+	// The first pixel's index is stored without its top bit so the endpoints are swapped if it has one, since the
+	// weights are symmetric that gives the same colours
+	int first = 0;
+	if (indices[0] >= 8) {
+		first = 1;
+		for (int i = 0; i < 16; i++)
+			indices[i] = 15 - indices[i];
+	}
+
+	memset(out, 0, 16);
+	int pos = 0;
+	_vksk_PutBits(out, &pos, 1 << 6, 7);
+	for (int c = 0; c < 4; c++) {
+		_vksk_PutBits(out, &pos, codes[first][c], 7);
+		_vksk_PutBits(out, &pos, codes[1 - first][c], 7);
+	}
+	_vksk_PutBits(out, &pos, pBits[first], 1);
+	_vksk_PutBits(out, &pos, pBits[1 - first], 1);
+	for (int i = 0; i < 16; i++)
+		_vksk_PutBits(out, &pos, indices[i], i == 0 ? 3 : 4);
+}
+
+static bool _vksk_BC7DecodeBlock(const uint8_t *in, uint8_t block[16][4]) {
+	int pos = 0;
+	if (_vksk_GetBits(in, &pos, 7) != 1 << 6)
+		return false;
+	uint8_t endpoints[2][4];
+	for (int c = 0; c < 4; c++) {
+		endpoints[0][c] = _vksk_GetBits(in, &pos, 7) << 1;
+		endpoints[1][c] = _vksk_GetBits(in, &pos, 7) << 1;
+	}
+	for (int e = 0; e < 2; e++) {
+		uint8_t p = _vksk_GetBits(in, &pos, 1);
+		for (int c = 0; c < 4; c++)
+			endpoints[e][c] |= p;
+	}
+	for (int i = 0; i < 16; i++)
+		_vksk_BC7Interpolate(endpoints[0], endpoints[1], _vksk_GetBits(in, &pos, i == 0 ? 3 : 4), block[i]);
+	return true;
+}
+
+static int _vksk_BlockBytes(uint32_t format) {
+	return format == VKSK_TEXTURE_FORMAT_BC1 ? 8 : 16;
+}
+
+static void _vksk_BlockEncode(const uint8_t *pixels, int w, int h, uint32_t format, uint8_t *out) {
+	int blocksWide = (w + 3) / 4;
+	int blocksHigh = (h + 3) / 4;
+	int blockBytes = _vksk_BlockBytes(format);
+	uint8_t block[16][4];
+	for (int by = 0; by < blocksHigh; by++) {
+		for (int bx = 0; bx < blocksWide; bx++, out += blockBytes) {
+			_vksk_BlockGather(pixels, w, h, bx, by, block);
+			if (format == VKSK_TEXTURE_FORMAT_BC1) {
+				_vksk_BC1EncodeBlock(block, false, out);
+			} else if (format == VKSK_TEXTURE_FORMAT_BC3) {
+				_vksk_BC3EncodeAlpha(block, out);
+				_vksk_BC1EncodeBlock(block, true, out + 8);
+			} else {
+				_vksk_BC7EncodeBlock(block, out);
+			}
+		}
+	}
+}
+
+static bool _vksk_BlockDecode(const uint8_t *data, int w, int h, uint32_t format, uint8_t *pixels) {
+	int blocksWide = (w + 3) / 4;
+	int blocksHigh = (h + 3) / 4;
+	int blockBytes = _vksk_BlockBytes(format);
+	uint8_t block[16][4];
+	for (int by = 0; by < blocksHigh; by++) {
+		for (int bx = 0; bx < blocksWide; bx++, data += blockBytes) {
+			if (format == VKSK_TEXTURE_FORMAT_BC1) {
+				_vksk_BC1DecodeBlock(data, false, block);
+			} else if (format == VKSK_TEXTURE_FORMAT_BC3) {
+				_vksk_BC3DecodeAlpha(data, block);
+				_vksk_BC1DecodeBlock(data + 8, true, block);
+			} else if (!_vksk_BC7DecodeBlock(data, block)) {
+				return false;
+			}
+			_vksk_BlockScatter(block, pixels, w, h, bx, by);
+		}
+	}
+	return true;
+}
+
+/*************** Mip chains ***************/
+int vksk_TextureLevelSize(int size, int level) {
+	return size >> level > 0 ? size >> level : 1;
+}
+
+// Halves an image with a 2x2 box filter, weighting colours by alpha so transparent pixels don't bleed their colour
+// into the edges of opaque ones. Odd sizes drop the last row/column, matching vksk_TextureLevelSize.
+static uint8_t *_vksk_Downsample(const uint8_t *pixels, int w, int h) {
+	int nw = vksk_TextureLevelSize(w, 1);
+	int nh = vksk_TextureLevelSize(h, 1);
+	uint8_t *out = malloc((size_t)nw * nh * 4);
+	for (int y = 0; y < nh; y++) {
+		const uint8_t *row0 = &pixels[(size_t)(y * 2) * w * 4];
+		const uint8_t *row1 = &pixels[(size_t)(y * 2 + 1 < h ? y * 2 + 1 : y * 2) * w * 4];
+		uint8_t *dst = &out[(size_t)y * nw * 4];
+		for (int x = 0; x < nw; x++, dst += 4) {
+			int x0 = x * 2 * 4;
+			int x1 = (x * 2 + 1 < w ? x * 2 + 1 : x * 2) * 4;
+			const uint8_t *px[4] = {&row0[x0], &row0[x1], &row1[x0], &row1[x1]};
+			int alpha = px[0][3] + px[1][3] + px[2][3] + px[3][3];
+			for (int c = 0; c < 3; c++) {
+				if (alpha > 0)
+					dst[c] = (px[0][c] * px[0][3] + px[1][c] * px[1][3] + px[2][c] * px[2][3] + px[3][c] * px[3][3] + alpha / 2) / alpha;
+				else
+					dst[c] = (px[0][c] + px[1][c] + px[2][c] + px[3][c] + 2) / 4;
+			}
+			dst[3] = (alpha + 2) / 4;
+		}
+	}
+	return out;
+}
+
+static int _vksk_LevelCount(int w, int h) {
+	int levels = 1;
+	while (w > 1 || h > 1) {
+		w = vksk_TextureLevelSize(w, 1);
+		h = vksk_TextureLevelSize(h, 1);
+		levels++;
+	}
+	return levels;
+}
+
+/*************** Files ***************/
+bool vksk_TextureIsEncoded(const uint8_t *data, int size) {
+	return data != NULL && size >= VKSK_TEXTURE_HEADER_SIZE && memcmp(data, VKSK_TEXTURE_MAGIC, 8) == 0;
+}
+
+// Encodes one level's pixels, returning them and placing their format and size into `format` and `size`. Returns
+// NULL if the pixels can't be stored with that encoding.
+static uint8_t *_vksk_EncodeLevel(const uint8_t *pixels, int w, int h, VKSK_TextureEncoding encoding, uint32_t *format, int *size) {
+	if (encoding == VKSK_TEXTURE_ENCODING_ALPHA) {
+		uint8_t *alpha = malloc((size_t)w * h);
+		for (int i = 0; i < w * h; i++) {
+			const uint8_t *px = &pixels[i * 4];
+			if (px[3] > 0 && (px[0] != 255 || px[1] != 255 || px[2] != 255)) {
+				free(alpha);
+				return NULL;
+			}
+			alpha[i] = px[3];
+		}
+		*format = VKSK_TEXTURE_FORMAT_ALPHA;
+		uint8_t *out = malloc(vksk_LZCompressBound(w * h));
+		*size = vksk_LZCompress(alpha, w * h, out, vksk_LZCompressBound(w * h));
+		free(alpha);
+		return out;
+	} else if (encoding != VKSK_TEXTURE_ENCODING_LOSSLESS) {
+		*format = encoding == VKSK_TEXTURE_ENCODING_BC1 ? VKSK_TEXTURE_FORMAT_BC1 :
+				  (encoding == VKSK_TEXTURE_ENCODING_BC3 ? VKSK_TEXTURE_FORMAT_BC3 : VKSK_TEXTURE_FORMAT_BC7);
+		*size = ((w + 3) / 4) * ((h + 3) / 4) * _vksk_BlockBytes(*format);
+		uint8_t *out = malloc(*size);
+		_vksk_BlockEncode(pixels, w, h, *format, out);
+		return out;
+	}
+
+	// Worst case for the chunks is 5 bytes a pixel, if they don't beat raw pixels the raw pixels are used instead
+	int rawSize = w * h * 4;
+	uint8_t *chunks = malloc((size_t)w * h * 5);
+	int chunkSize = _vksk_QOIEncode(pixels, w * h, chunks);
+	if (chunkSize >= rawSize) {
+		*format = VKSK_TEXTURE_FORMAT_RGBA;
+		*size = rawSize;
+		memcpy(chunks, pixels, rawSize);
+	} else {
+		*format = VKSK_TEXTURE_FORMAT_QOI;
+		*size = chunkSize;
+	}
+	return chunks;
+}
+
+// Decodes one level's pixels, returning NULL if they're malformed
+static uint8_t *_vksk_DecodeLevel(const uint8_t *payload, int payloadSize, uint32_t format, int width, int height) {
+	int pixelCount = width * height;
+	uint8_t *pixels = NULL;
+	if (format == VKSK_TEXTURE_FORMAT_RGBA && payloadSize == pixelCount * 4) {
+		pixels = malloc(payloadSize);
+		memcpy(pixels, payload, payloadSize);
+	} else if (format == VKSK_TEXTURE_FORMAT_QOI) {
+		pixels = malloc(pixelCount * 4);
+		if (!_vksk_QOIDecode(payload, payloadSize, pixels, pixelCount)) {
+			free(pixels);
+			pixels = NULL;
+		}
+	} else if (format == VKSK_TEXTURE_FORMAT_ALPHA) {
+		pixels = malloc(pixelCount * 4);
+		if (vksk_LZDecompress(payload, payloadSize, pixels + pixelCount * 3, pixelCount)) {
+			// The alpha is decompressed into the last quarter so it can be spread out front to back in place
+			const uint8_t *alpha = pixels + pixelCount * 3;
+			for (int i = 0; i < pixelCount; i++) {
+				uint8_t a = alpha[i];
+				pixels[i * 4] = 255;
+				pixels[i * 4 + 1] = 255;
+				pixels[i * 4 + 2] = 255;
+				pixels[i * 4 + 3] = a;
+			}
+		} else {
+			free(pixels);
+			pixels = NULL;
+		}
+	} else if ((format == VKSK_TEXTURE_FORMAT_BC1 || format == VKSK_TEXTURE_FORMAT_BC3 || format == VKSK_TEXTURE_FORMAT_BC7) &&
+			   payloadSize == ((width + 3) / 4) * ((height + 3) / 4) * _vksk_BlockBytes(format)) {
+		// Uploading blocks as they are is up to VK2D, which only takes RGBA, so they're decompressed here
+		pixels = malloc(pixelCount * 4);
+		if (!_vksk_BlockDecode(payload, width, height, format, pixels)) {
+			free(pixels);
+			pixels = NULL;
+		}
+	}
+	return pixels;
+}
+
+// Checks a texture's header, placing its size and level count into `w`, `h` and `levels`
+static bool _vksk_TextureReadHeader(const uint8_t *data, int size, int *w, int *h, int *levels) {
+	if (!vksk_TextureIsEncoded(data, size))
+		return false;
+	uint32_t version = _vksk_GetU32(data + 8);
+	uint32_t width = _vksk_GetU32(data + 16);
+	uint32_t height = _vksk_GetU32(data + 20);
+	if (width == 0 || height == 0 || width > VKSK_TEXTURE_MAX_SIZE || height > VKSK_TEXTURE_MAX_SIZE)
+		return false;
+	if (version == 1) {
+		*levels = 1;
+	} else if (version == VKSK_TEXTURE_VERSION && size >= VKSK_TEXTURE_HEADER_SIZE + 4) {
+		uint32_t count = _vksk_GetU32(data + VKSK_TEXTURE_HEADER_SIZE);
+		if (count == 0 || count > (uint32_t)_vksk_LevelCount(width, height))
+			return false;
+		*levels = count;
+	} else {
+		return false;
+	}
+	*w = width;
+	*h = height;
+	return true;
+}
+
+// Finds where a level's pixels are in a texture, returns false if the level isn't there or runs past the end
+static bool _vksk_TextureFindLevel(const uint8_t *data, int size, int level, uint32_t *format, const uint8_t **payload, int *payloadSize) {
+	int w, h, levels;
+	if (!_vksk_TextureReadHeader(data, size, &w, &h, &levels) || level < 0 || level >= levels)
+		return false;
+	if (_vksk_GetU32(data + 8) == 1) {
+		*format = _vksk_GetU32(data + 12);
+		*payload = data + VKSK_TEXTURE_HEADER_SIZE;
+		*payloadSize = size - VKSK_TEXTURE_HEADER_SIZE;
+		return true;
+	}
+	int pos = VKSK_TEXTURE_HEADER_SIZE + 4;
+	for (int i = 0; i <= level; i++) {
+		if (size - pos < VKSK_TEXTURE_LEVEL_HEADER_SIZE)
+			return false;
+		uint32_t levelSize = _vksk_GetU32(data + pos + 4);
+		if (levelSize > (uint32_t)(size - pos - VKSK_TEXTURE_LEVEL_HEADER_SIZE))
+			return false;
+		if (i == level) {
+			*format = _vksk_GetU32(data + pos);
+			*payload = data + pos + VKSK_TEXTURE_LEVEL_HEADER_SIZE;
+			*payloadSize = levelSize;
+		}
+		pos += VKSK_TEXTURE_LEVEL_HEADER_SIZE + levelSize;
+	}
+	return true;
+}
+
+uint8_t *vksk_TextureEncode(const uint8_t *pixels, int w, int h, VKSK_TextureEncoding encoding, bool mipmaps, int *size) {
+	if (w <= 0 || h <= 0 || w > VKSK_TEXTURE_MAX_SIZE || h > VKSK_TEXTURE_MAX_SIZE)
+		return NULL;
+	int levelCount = mipmaps ? _vksk_LevelCount(w, h) : 1;
+	uint8_t *levels[32];
+	uint32_t formats[32];
+	int sizes[32];
+	int total = VKSK_TEXTURE_HEADER_SIZE + 4;
+	bool failed = false;
+	const uint8_t *levelPixels = pixels;
+	for (int i = 0; i < levelCount; i++) {
+		int lw = vksk_TextureLevelSize(w, i);
+		int lh = vksk_TextureLevelSize(h, i);
+		levels[i] = _vksk_EncodeLevel(levelPixels, lw, lh, encoding, &formats[i], &sizes[i]);
+		if (levels[i] == NULL) {
+			failed = true;
+			levelCount = i;
+			break;
+		}
+		total += VKSK_TEXTURE_LEVEL_HEADER_SIZE + sizes[i];
+		if (i + 1 < levelCount) {
+			uint8_t *next = _vksk_Downsample(levelPixels, lw, lh);
+			if (levelPixels != pixels)
+				free((void*)levelPixels);
+			levelPixels = next;
+		}
+	}
+	if (levelPixels != pixels)
+		free((void*)levelPixels);
+	if (failed) {
+		for (int i = 0; i < levelCount; i++)
+			free(levels[i]);
+		return NULL;
+	}
+
+	uint8_t *out = malloc(total);
+	memcpy(out, VKSK_TEXTURE_MAGIC, 8);
+	_vksk_PutU32(out + 8, VKSK_TEXTURE_VERSION);
+	_vksk_PutU32(out + 12, formats[0]);
+	_vksk_PutU32(out + 16, w);
+	_vksk_PutU32(out + 20, h);
+	_vksk_PutU32(out + 24, levelCount);
+	int pos = VKSK_TEXTURE_HEADER_SIZE + 4;
+	for (int i = 0; i < levelCount; i++) {
+		_vksk_PutU32(out + pos, formats[i]);
+		_vksk_PutU32(out + pos + 4, sizes[i]);
+		memcpy(out + pos + VKSK_TEXTURE_LEVEL_HEADER_SIZE, levels[i], sizes[i]);
+		pos += VKSK_TEXTURE_LEVEL_HEADER_SIZE + sizes[i];
+		free(levels[i]);
+	}
+	*size = total;
+	return out;
+}
+
+int vksk_TextureLevelCount(const uint8_t *data, int size) {
+	int w, h, levels;
+	return _vksk_TextureReadHeader(data, size, &w, &h, &levels) ? levels : 0;
+}
+
+uint8_t *vksk_TextureDecodeLevel(const uint8_t *data, int size, int level, int *w, int *h) {
+	int width, height, levels;
+	uint32_t format;
+	const uint8_t *payload;
+	int payloadSize;
+	if (!_vksk_TextureReadHeader(data, size, &width, &height, &levels) ||
+		!_vksk_TextureFindLevel(data, size, level, &format, &payload, &payloadSize))
+		return NULL;
+	width = vksk_TextureLevelSize(width, level);
+	height = vksk_TextureLevelSize(height, level);
+	uint8_t *pixels = _vksk_DecodeLevel(payload, payloadSize, format, width, height);
+	if (pixels != NULL) {
+		*w = width;
+		*h = height;
+	}
+	return pixels;
+}
+
+uint8_t *vksk_TextureDecode(const uint8_t *data, int size, int *w, int *h) {
+	return vksk_TextureDecodeLevel(data, size, 0, w, h);
+}
+
+uint8_t *vksk_TextureDecodeAlpha(const uint8_t *data, int size, int *w, int *h) {
+	int width, height, levels;
+	uint32_t format;
+	const uint8_t *payload;
+	int payloadSize;
+	if (!_vksk_TextureReadHeader(data, size, &width, &height, &levels) ||
+		!_vksk_TextureFindLevel(data, size, 0, &format, &payload, &payloadSize) || format != VKSK_TEXTURE_FORMAT_ALPHA)
+		return NULL;
+	uint8_t *alpha = malloc((size_t)width * height);
+	if (!vksk_LZDecompress(payload, payloadSize, alpha, width * height)) {
+		free(alpha);
+		return NULL;
+	}
+	*w = width;
+	*h = height;
+	return alpha;
+}
+
+uint8_t *vksk_TextureLoadPixels(const uint8_t *data, int size, int *w, int *h, int *levels) {
+	// stbi_image_free is just free unless STBI_FREE is changed, which nothing here does
+	if (levels != NULL)
+		*levels = 1;
+	if (!vksk_TextureIsEncoded(data, size)) {
+		int channels;
+		return stbi_load_from_memory(data, size, w, h, &channels, 4);
+	}
+	int count = vksk_TextureLevelCount(data, size);
+	if (levels == NULL || count <= 1)
+		return vksk_TextureDecode(data, size, w, h);
+
+	// The whole chain goes in one buffer, each level right after the one before it
+	int width, height;
+	size_t total = 0;
+	_vksk_TextureReadHeader(data, size, &width, &height, &count);
+	for (int i = 0; i < count; i++)
+		total += (size_t)vksk_TextureLevelSize(width, i) * vksk_TextureLevelSize(height, i) * 4;
+	uint8_t *pixels = malloc(total);
+	size_t pos = 0;
+	for (int i = 0; i < count; i++) {
+		int lw, lh;
+		uint8_t *level = vksk_TextureDecodeLevel(data, size, i, &lw, &lh);
+		if (level == NULL) {
+			free(pixels);
+			return NULL;
+		}
+		memcpy(pixels + pos, level, (size_t)lw * lh * 4);
+		pos += (size_t)lw * lh * 4;
+		free(level);
+	}
+	*w = width;
+	*h = height;
+	*levels = count;
+	return pixels;
+}
@@ -0,0 +1,49 @@
+/// \file TextureFormat.h
+/// \author Paolo Mazzon
+/// \brief Texture files Packer converts images to so they don't need to be decoded from png/jpg at runtime
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// Returns true if `data` is a texture made by vksk_TextureEncode
+bool vksk_TextureIsEncoded(const uint8_t *data, int size);
+
+// How a texture file stores its pixels. Lossless is whichever of raw pixels or a QOI style encoding is smaller, the
+// rest are the GPU block compression formats which lose some quality.
+typedef enum {
+	VKSK_TEXTURE_ENCODING_LOSSLESS = 0,
+	VKSK_TEXTURE_ENCODING_BC1 = 1, // 4 bits a pixel, pixels are either opaque or fully transparent
+	VKSK_TEXTURE_ENCODING_BC3 = 2, // 8 bits a pixel with smooth alpha
+	VKSK_TEXTURE_ENCODING_BC7 = 3, // 8 bits a pixel, better colour than BC3
+	VKSK_TEXTURE_ENCODING_ALPHA = 4, // Lossless 8 bits a pixel before compression, only for white images like glyphs
+} VKSK_TextureEncoding;
+
+// Converts RGBA pixels into a texture file, returning the file and putting its size into `size` (must free
+// memory manually). If `mipmaps` is true the file also holds the image scaled down by half over and over until it's
+// 1x1. Returns NULL if the image is too big or, for VKSK_TEXTURE_ENCODING_ALPHA, has a visible pixel that isn't white.
+uint8_t *vksk_TextureEncode(const uint8_t *pixels, int w, int h, VKSK_TextureEncoding encoding, bool mipmaps, int *size);
+
+// Returns how many levels of mip chain a texture made by vksk_TextureEncode has, which is 1 for textures without one
+// and 0 if `data` isn't a texture
+int vksk_TextureLevelCount(const uint8_t *data, int size);
+
+// Width or height of a level of the mip chain for a texture that is `size` wide or high at level 0
+int vksk_TextureLevelSize(int size, int level);
+
+// Decodes one level of a texture's mip chain into RGBA pixels (must free memory manually), level 0 being the full
+// image. Returns NULL if the texture is malformed or doesn't have that level. Never reads outside of `data`.
+uint8_t *vksk_TextureDecodeLevel(const uint8_t *data, int size, int level, int *w, int *h);
+
+// Decodes a texture made by vksk_TextureEncode into RGBA pixels (must free memory manually), returns NULL if the
+// texture is malformed. Never reads outside of `data`.
+uint8_t *vksk_TextureDecode(const uint8_t *data, int size, int *w, int *h);
+
+// Decodes a texture made with VKSK_TEXTURE_ENCODING_ALPHA into one byte of alpha a pixel (must free memory
+// manually), returns NULL if the texture is malformed or was encoded some other way
+uint8_t *vksk_TextureDecodeAlpha(const uint8_t *data, int size, int *w, int *h);
+
+// Decodes either a texture made by vksk_TextureEncode or any image stb_image can read into RGBA pixels, returns
+// NULL if it's neither. The pixels are freed with stbi_image_free either way. If `levels` isn't NULL the texture's
+// whole mip chain is decoded with each level right after the one before it and `levels` is set to how many there
+// are (1 for anything without a mip chain), `w` and `h` are always the size of level 0.
+uint8_t *vksk_TextureLoadPixels(const uint8_t *data, int size, int *w, int *h, int *levels);
@@ -1,20 +1,337 @@
 /// \file Util.c
 /// \author Paolo Mazzon
+#include <string.h>
+
 #include "src/Util.h"
 #include "src/Runtime.h"
 #include "src/Packer.h"
+#include "src/Validation.h"
+
+extern VKSK_EngineConfig gEngineConfig;
+
+// Files loaded ahead of time by vksk_PrefetchFiles waiting to be picked up
+typedef struct _vksk_PrefetchedFile {
+	char *filename; // NULL once the file has been taken
+	uint8_t *buffer;
+	int size;
+} _vksk_PrefetchedFile;
+
+static _vksk_PrefetchedFile *gPrefetched = NULL;
+static int gPrefetchedCount = 0;
+static int gPrefetchedLeft = 0; // Files that haven't been taken yet
+static int gPrefetchedNext = 0; // Files are usually picked up in the order they were prefetched
+
+void vksk_PrefetchFiles(const char **filenames, int count) {
+	if (gGamePak == NULL || count <= 0)
+		return;
+
+	// Anything that can be viewed straight from a mapping is already as fast as it gets
+	const char **toLoad = malloc(sizeof(const char*) * count);
+	int toLoadCount = 0;
+	for (int i = 0; i < count; i++) {
+		int size;
+		if (vksk_PakGetFileView(gGamePak, filenames[i], &size) == NULL)
+			toLoad[toLoadCount++] = filenames[i];
+	}
+
+	uint8_t **buffers = malloc(sizeof(uint8_t*) * (toLoadCount + 1));
+	int *sizes = malloc(sizeof(int) * (toLoadCount + 1));
+	vksk_PakGetFiles(gGamePak, toLoad, toLoadCount, buffers, sizes);
+	gPrefetched = realloc(gPrefetched, sizeof(_vksk_PrefetchedFile) * (gPrefetchedCount + toLoadCount + 1));
+	for (int i = 0; i < toLoadCount; i++) {
+		if (buffers[i] == NULL)
+			continue;
+		gPrefetched[gPrefetchedCount].filename = malloc(strlen(toLoad[i]) + 1);
+		strcpy(gPrefetched[gPrefetchedCount].filename, toLoad[i]);
+		gPrefetched[gPrefetchedCount].buffer = buffers[i];
+		gPrefetched[gPrefetchedCount++].size = sizes[i];
+		gPrefetchedLeft++;
+	}
+
+	free(sizes);
+	free(buffers);
+	free(toLoad);
+}
+
+// Takes a prefetched file out of the list if its there, taken files are only marked as such so taking them in
+// the order they were prefetched finds each one right away
+static uint8_t *_vksk_TakePrefetchedFile(const char *filename, int *size) {
+	for (int n = 0; n < gPrefetchedCount && gPrefetchedLeft > 0; n++) {
+		int i = (gPrefetchedNext + n) % gPrefetchedCount;
+		if (gPrefetched[i].filename != NULL && strcmp(gPrefetched[i].filename, filename) == 0) {
+			uint8_t *buffer = gPrefetched[i].buffer;
+			*size = gPrefetched[i].size;
+			free(gPrefetched[i].filename);
+			gPrefetched[i].filename = NULL;
+			gPrefetched[i].buffer = NULL;
+			gPrefetchedNext = i + 1;
+			if (--gPrefetchedLeft == 0)
+				vksk_DropPrefetchedFiles();
+			return buffer;
+		}
+	}
+	return NULL;
+}
+
+void vksk_DropPrefetchedFiles() {
+	for (int i = 0; i < gPrefetchedCount; i++) {
+		free(gPrefetched[i].filename);
+		free(gPrefetched[i].buffer);
+	}
+	free(gPrefetched);
+	gPrefetched = NULL;
+	gPrefetchedCount = 0;
+	gPrefetchedLeft = 0;
+	gPrefetchedNext = 0;
+}
 
 unsigned char* loadFileRaw(const char *filename, int *size);
 void *vksk_GetFileBuffer(const char *filename, int *size) {
-	if (vksk_PakFileExists(gGamePak, filename)) {
-		return vksk_PakGetFile(gGamePak, filename, size);
-	}
+	vksk_TraceFileAccess(filename);
+	void *prefetched = _vksk_TakePrefetchedFile(filename, size);
+	if (prefetched != NULL)
+		return prefetched;
+	// vksk_PakGetFile already returns NULL for files not in the pak so theres no need to check first
+	void *buffer = vksk_PakGetFile(gGamePak, filename, size);
+	if (buffer != NULL)
+		return buffer;
 	return loadFileRaw(filename, size);
 }
 
+bool vksk_GetFileView(const char *filename, VKSK_FileView *view) {
+	vksk_TraceFileAccess(filename);
+	view->data = vksk_PakGetFileView(gGamePak, filename, &view->size);
+	view->owned = false;
+	if (view->data == NULL) {
+		view->data = _vksk_TakePrefetchedFile(filename, &view->size);
+		if (view->data == NULL && gGamePak != NULL)
+			view->data = vksk_PakGetFile(gGamePak, filename, &view->size);
+		if (view->data == NULL)
+			view->data = loadFileRaw(filename, &view->size);
+		view->owned = true;
+	}
+	return view->data != NULL;
+}
+
+void vksk_ReleaseFileView(VKSK_FileView *view) {
+	if (view->owned)
+		free((void*)view->data);
+	view->data = NULL;
+	view->size = 0;
+	view->owned = false;
+}
+
+VKSK_PakStream vksk_OpenFileStream(const char *filename) {
+	vksk_TraceFileAccess(filename);
+	VKSK_PakStream stream = vksk_PakStreamOpen(gGamePak, filename);
+	if (stream != NULL)
+		return stream;
+	return vksk_PakStreamOpenFile(filename);
+}
+
+// Trace of every file loaded, one "<milliseconds since the first load>\t<filename>" line per load
+static FILE *gAccessTrace = NULL;
+static uint64_t gAccessTraceStart = 0;
+
+void vksk_TraceFileAccess(const char *filename) {
+	if (!gEngineConfig.recordAccessTrace)
+		return;
+	if (gAccessTrace == NULL) {
+		gAccessTrace = fopen("access_trace.txt", "w");
+		gAccessTraceStart = SDL_GetPerformanceCounter();
+		if (gAccessTrace == NULL) {
+			vksk_Log("Failed to open access_trace.txt, access trace will not be recorded.");
+			gEngineConfig.recordAccessTrace = false;
+			return;
+		}
+	}
+	double time = (double)(SDL_GetPerformanceCounter() - gAccessTraceStart) * 1000 / SDL_GetPerformanceFrequency();
+	fprintf(gAccessTrace, "%.3f\t%s\n", time, filename);
+}
+
+void vksk_CloseAccessTrace() {
+	if (gAccessTrace != NULL)
+		fclose(gAccessTrace);
+	gAccessTrace = NULL;
+}
+
+uint64_t vksk_GetFileBlobID(const char *filename) {
+	return vksk_PakGetBlobID(gGamePak, filename);
+}
+
+// Decoded assets shared between files with the same contents
+typedef struct _vksk_CachedAsset {
+	uint64_t type;
+	uint64_t blob;
+	void *asset;
+	int references;
+} _vksk_CachedAsset;
+
+#define ASSET_CACHE_EMPTY -1
+#define ASSET_CACHE_REMOVED -2
+
+static _vksk_CachedAsset *gAssetCache = NULL;
+static int gAssetCacheCount = 0;
+static int gAssetCacheSize = 0;
+
+// Open addressed (linear probe) indices into gAssetCache, one keyed on type and blob for vksk_AssetCacheGet and
+// one on the asset for vksk_AssetCacheRelease. Released entries leave ASSET_CACHE_REMOVED behind until the tables
+// are rebuilt.
+static int *gAssetCacheByBlob = NULL;
+static int *gAssetCacheByAsset = NULL;
+static int gAssetCacheTableSize = 0; // Always a power of 2
+static int gAssetCacheByBlobUsed = 0; // Slots that aren't ASSET_CACHE_EMPTY
+static int gAssetCacheByAssetUsed = 0;
+
+static uint32_t _vksk_AssetCacheHash(uint64_t key) {
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+	return (uint32_t)key;
+}
+
+static uint32_t _vksk_AssetCacheBlobHash(uint64_t type, uint64_t blob) {
+	return _vksk_AssetCacheHash(blob ^ (type * 0x9e3779b97f4a7c15ull));
+}
+
+static uint32_t _vksk_AssetCacheAssetHash(void *asset) {
+	return _vksk_AssetCacheHash((uint64_t)(uintptr_t)asset);
+}
+
+// Returns the slot in a table holding `index`, which must be in it
+static int _vksk_AssetCacheFindSlot(int *table, uint32_t hash, int index) {
+	int mask = gAssetCacheTableSize - 1;
+	int slot = hash & mask;
+	while (table[slot] != index)
+		slot = (slot + 1) & mask;
+	return slot;
+}
+
+// Puts `index` in the first empty or removed slot, only empty ones taken count towards the table filling up
+static void _vksk_AssetCacheInsert(int *table, int *used, uint32_t hash, int index) {
+	int mask = gAssetCacheTableSize - 1;
+	int slot = hash & mask;
+	while (table[slot] >= 0)
+		slot = (slot + 1) & mask;
+	*used += table[slot] == ASSET_CACHE_EMPTY;
+	table[slot] = index;
+}
+
+// Makes the tables big enough for one more asset, clearing out removed slots while it's at it
+static void _vksk_AssetCacheReserve() {
+	int used = gAssetCacheByBlobUsed > gAssetCacheByAssetUsed ? gAssetCacheByBlobUsed : gAssetCacheByAssetUsed;
+	if ((used + 1) * 2 <= gAssetCacheTableSize)
+		return;
+	int size = 32;
+	while (size < (gAssetCacheCount + 1) * 4)
+		size *= 2;
+	gAssetCacheTableSize = size;
+	gAssetCacheByBlobUsed = 0;
+	gAssetCacheByAssetUsed = 0;
+	gAssetCacheByBlob = realloc(gAssetCacheByBlob, sizeof(int) * size);
+	gAssetCacheByAsset = realloc(gAssetCacheByAsset, sizeof(int) * size);
+	memset(gAssetCacheByBlob, ASSET_CACHE_EMPTY, sizeof(int) * size);
+	memset(gAssetCacheByAsset, ASSET_CACHE_EMPTY, sizeof(int) * size);
+	for (int i = 0; i < gAssetCacheCount; i++) {
+		_vksk_AssetCacheInsert(gAssetCacheByBlob, &gAssetCacheByBlobUsed, _vksk_AssetCacheBlobHash(gAssetCache[i].type, gAssetCache[i].blob), i);
+		_vksk_AssetCacheInsert(gAssetCacheByAsset, &gAssetCacheByAssetUsed, _vksk_AssetCacheAssetHash(gAssetCache[i].asset), i);
+	}
+}
+
+static _vksk_CachedAsset *_vksk_AssetCacheFind(uint64_t type, uint64_t blob) {
+	if (blob == 0 || gAssetCacheTableSize == 0)
+		return NULL;
+	int mask = gAssetCacheTableSize - 1;
+	for (int slot = _vksk_AssetCacheBlobHash(type, blob) & mask; gAssetCacheByBlob[slot] != ASSET_CACHE_EMPTY; slot = (slot + 1) & mask) {
+		_vksk_CachedAsset *cached = gAssetCacheByBlob[slot] >= 0 ? &gAssetCache[gAssetCacheByBlob[slot]] : NULL;
+		if (cached != NULL && cached->type == type && cached->blob == blob)
+			return cached;
+	}
+	return NULL;
+}
+
+void *vksk_AssetCacheGet(uint64_t type, uint64_t blob) {
+	_vksk_CachedAsset *cached = _vksk_AssetCacheFind(type, blob);
+	if (cached == NULL)
+		return NULL;
+	cached->references++;
+	return cached->asset;
+}
+
+bool vksk_AssetCacheContains(uint64_t type, uint64_t blob) {
+	return _vksk_AssetCacheFind(type, blob) != NULL;
+}
+
+void vksk_AssetCacheAdd(uint64_t type, uint64_t blob, void *asset) {
+	if (blob == 0 || asset == NULL)
+		return;
+	if (gAssetCacheCount == gAssetCacheSize) {
+		gAssetCacheSize = gAssetCacheSize == 0 ? 16 : gAssetCacheSize * 2;
+		gAssetCache = realloc(gAssetCache, sizeof(_vksk_CachedAsset) * gAssetCacheSize);
+	}
+	_vksk_AssetCacheReserve();
+	int index = gAssetCacheCount++;
+	_vksk_CachedAsset *cached = &gAssetCache[index];
+	cached->type = type;
+	cached->blob = blob;
+	cached->asset = asset;
+	cached->references = 1;
+	_vksk_AssetCacheInsert(gAssetCacheByBlob, &gAssetCacheByBlobUsed, _vksk_AssetCacheBlobHash(type, blob), index);
+	_vksk_AssetCacheInsert(gAssetCacheByAsset, &gAssetCacheByAssetUsed, _vksk_AssetCacheAssetHash(asset), index);
+}
+
+bool vksk_AssetCacheRelease(void *asset) {
+	if (asset == NULL || gAssetCacheTableSize == 0)
+		return true;
+	int mask = gAssetCacheTableSize - 1;
+	int slot = _vksk_AssetCacheAssetHash(asset) & mask;
+	while (gAssetCacheByAsset[slot] != ASSET_CACHE_EMPTY && (gAssetCacheByAsset[slot] < 0 || gAssetCache[gAssetCacheByAsset[slot]].asset != asset))
+		slot = (slot + 1) & mask;
+	if (gAssetCacheByAsset[slot] == ASSET_CACHE_EMPTY)
+		return true;
+	int index = gAssetCacheByAsset[slot];
+	_vksk_CachedAsset *cached = &gAssetCache[index];
+	if (--cached->references > 0)
+		return false;
+
+	// The last asset takes the released one's place so the tables need to point to where it went
+	gAssetCacheByAsset[slot] = ASSET_CACHE_REMOVED;
+	gAssetCacheByBlob[_vksk_AssetCacheFindSlot(gAssetCacheByBlob, _vksk_AssetCacheBlobHash(cached->type, cached->blob), index)] = ASSET_CACHE_REMOVED;
+	int last = --gAssetCacheCount;
+	if (index != last) {
+		_vksk_CachedAsset *moved = &gAssetCache[last];
+		gAssetCacheByBlob[_vksk_AssetCacheFindSlot(gAssetCacheByBlob, _vksk_AssetCacheBlobHash(moved->type, moved->blob), last)] = index;
+		gAssetCacheByAsset[_vksk_AssetCacheFindSlot(gAssetCacheByAsset, _vksk_AssetCacheAssetHash(moved->asset), last)] = index;
+		*cached = *moved;
+	}
+	return true;
+}
+
 VKSK_RuntimeForeign *vksk_NewForeignClass(WrenVM *vm, const char *module, const char *name, uint64_t type) {
     wrenGetVariable(vm, module, name, 0);
     VKSK_RuntimeForeign *f = wrenSetSlotNewForeign(vm, 0, 0, sizeof(struct VKSK_RuntimeForeign));
     f->type = type;
     return f;
-}
\ No newline at end of file
+}
+
+bool vksk_MapTextureRegion(const _vksk_TextureRegion *region, float *x, float *y, float xScale, float yScale, float *xOrigin, float *yOrigin, float *xInTex, float *yInTex, float *wInTex, float *hInTex) {
+	float left = *xInTex > region->trimX ? *xInTex : region->trimX;
+	float top = *yInTex > region->trimY ? *yInTex : region->trimY;
+	float right = *xInTex + *wInTex < region->trimX + region->trimW ? *xInTex + *wInTex : region->trimX + region->trimW;
+	float bottom = *yInTex + *hInTex < region->trimY + region->trimH ? *yInTex + *hInTex : region->trimY + region->trimH;
+	if (right <= left || bottom <= top)
+		return false;
+
+	// Whatever was trimmed off the top-left moves the drawn part over, and the origin back so it rotates the same
+	float dx = left - *xInTex;
+	float dy = top - *yInTex;
+	*x += dx * xScale;
+	*y += dy * yScale;
+	*xOrigin -= dx;
+	*yOrigin -= dy;
+	*xInTex = region->x + (left - region->trimX);
+	*yInTex = region->y + (top - region->trimY);
+	*wInTex = right - left;
+	*hInTex = bottom - top;
+	return true;
+}
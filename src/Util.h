@@ -5,8 +5,65 @@
 #include <wren.h>
 #include <IntermediateTypes.h>
 
+#include "src/Packer.h"
+
+// Read-only contents of a file, either borrowed straight from a mapped game.pak or loaded into a buffer
+typedef struct VKSK_FileView {
+	const uint8_t *data;
+	int size;
+	bool owned; // data was allocated for this view and is freed on release
+} VKSK_FileView;
+
 // Grabs a file buffer from either game.pak if it finds it or the filesystem
 void *vksk_GetFileBuffer(const char *filename, int *size);
 
+// Same as vksk_GetFileBuffer but avoids the copy if game.pak is mapped, returns false if the file couldn't be
+// loaded. The view must be released with vksk_ReleaseFileView when you're done with it.
+bool vksk_GetFileView(const char *filename, VKSK_FileView *view);
+
+// Loads a batch of files from game.pak in one go so the vksk_GetFileBuffer/vksk_GetFileView calls for them that
+// follow don't have to hit the disk. Files that can be viewed straight from a mapped pak are left alone.
+void vksk_PrefetchFiles(const char **filenames, int count);
+
+// Frees any prefetched files that were never loaded
+void vksk_DropPrefetchedFiles();
+
+// Releases a view from vksk_GetFileView
+void vksk_ReleaseFileView(VKSK_FileView *view);
+
+// Opens a file for reading a piece at a time from either game.pak if it finds it or the filesystem, returns NULL
+// if it can't be found. Use the vksk_PakStream* functions on it and close it with vksk_PakStreamClose.
+VKSK_PakStream vksk_OpenFileStream(const char *filename);
+
+// Records that a file was loaded into access_trace.txt if recordAccessTrace is enabled, everything that loads
+// files from game.pak should call this (the functions above already do)
+void vksk_TraceFileAccess(const char *filename);
+
+// Closes the access trace if one was being recorded
+void vksk_CloseAccessTrace();
+
+// Returns an ID for the contents of a file in game.pak, files with the same non-zero ID have identical contents.
+// Returns 0 if the file isn't in game.pak.
+uint64_t vksk_GetFileBlobID(const char *filename);
+
+// Looks for an already decoded asset of a given type (FOREIGN_*) made from a blob, adding a reference to it if its
+// found. Returns NULL if there is none or the blob ID is 0.
+void *vksk_AssetCacheGet(uint64_t type, uint64_t blob);
+
+// Same as vksk_AssetCacheGet but only checks if the asset is there without adding a reference
+bool vksk_AssetCacheContains(uint64_t type, uint64_t blob);
+
+// Adds a freshly decoded asset to the cache with one reference, does nothing if the blob ID is 0
+void vksk_AssetCacheAdd(uint64_t type, uint64_t blob, void *asset);
+
+// Drops a reference to an asset, returns true if the asset should now be freed which is either when this was the
+// last reference or the asset was never in the cache
+bool vksk_AssetCacheRelease(void *asset);
+
 // Puts a newly allocated foreign class into slot 0 and returns it
-VKSK_RuntimeForeign *vksk_NewForeignClass(WrenVM *vm, const char *module, const char *name, uint64_t type);
\ No newline at end of file
+VKSK_RuntimeForeign *vksk_NewForeignClass(WrenVM *vm, const char *module, const char *name, uint64_t type);
+
+// Turns drawing part of a texture packed into an atlas (in the original image's coordinates) into drawing the part
+// of its page that was kept, moving the position and origin so it lands in the same place. Returns false if none
+// of it was kept so there is nothing to draw.
+bool vksk_MapTextureRegion(const _vksk_TextureRegion *region, float *x, float *y, float xScale, float yScale, float *xOrigin, float *yOrigin, float *xInTex, float *yInTex, float *wInTex, float *hInTex);
@@ -8,6 +8,8 @@
 #include "src/Validation.h"
 #include "src/Util.h"
 #include "src/Runtime.h"
+#include "src/AssetDecoder.h"
+#include "src/TextureFormat.h"
 
 // From RendererBindings.c
 extern VK2DShadowEnvironment gShadowEnvironment;
@@ -17,20 +19,263 @@ void _vksk_RendererResetLights();
 void _vksk_RendererRemoveLightSource(int index);
 
 /*************** Texture ***************/
+// Textures made from decoded pixels own their image since vk2dTextureFree only frees images it loaded itself, and
+// the base texture of a mip chain owns the chain so its free takes the chain with it
+typedef struct _vksk_OwnedTexture {
+	VK2DTexture tex;
+	VK2DImage image;
+	_vksk_MipChain *mips; // NULL if the texture doesn't have one
+} _vksk_OwnedTexture;
+
+#define OWNED_TEXTURE_EMPTY -1
+#define OWNED_TEXTURE_REMOVED -2
+
+static _vksk_OwnedTexture *gOwnedTextures = NULL;
+static int gOwnedTextureCount = 0;
+static int gOwnedTextureSize = 0;
+
+// Open addressed (linear probe) indices into gOwnedTextures keyed on the texture, freed textures leave
+// OWNED_TEXTURE_REMOVED behind until the table is rebuilt
+static int *gOwnedTextureTable = NULL;
+static int gOwnedTextureTableSize = 0; // Always a power of 2
+static int gOwnedTextureTableUsed = 0; // Slots that aren't OWNED_TEXTURE_EMPTY
+
+static uint32_t _vksk_OwnedTextureHash(VK2DTexture tex) {
+	uint64_t key = (uint64_t)(uintptr_t)tex;
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+	return (uint32_t)key;
+}
+
+static void _vksk_OwnedTextureInsert(int index) {
+	int mask = gOwnedTextureTableSize - 1;
+	int slot = _vksk_OwnedTextureHash(gOwnedTextures[index].tex) & mask;
+	while (gOwnedTextureTable[slot] >= 0)
+		slot = (slot + 1) & mask;
+	gOwnedTextureTableUsed += gOwnedTextureTable[slot] == OWNED_TEXTURE_EMPTY;
+	gOwnedTextureTable[slot] = index;
+}
+
+// Returns the slot holding the texture's entry or -1 if it doesn't own anything
+static int _vksk_OwnedTextureFind(VK2DTexture tex) {
+	if (tex == NULL || gOwnedTextureTableSize == 0)
+		return -1;
+	int mask = gOwnedTextureTableSize - 1;
+	for (int slot = _vksk_OwnedTextureHash(tex) & mask; gOwnedTextureTable[slot] != OWNED_TEXTURE_EMPTY; slot = (slot + 1) & mask)
+		if (gOwnedTextureTable[slot] >= 0 && gOwnedTextures[gOwnedTextureTable[slot]].tex == tex)
+			return slot;
+	return -1;
+}
+
+static void _vksk_OwnedTextureAdd(VK2DTexture tex, VK2DImage image) {
+	if (gOwnedTextureCount == gOwnedTextureSize) {
+		gOwnedTextureSize = gOwnedTextureSize == 0 ? 16 : gOwnedTextureSize * 2;
+		gOwnedTextures = realloc(gOwnedTextures, sizeof(_vksk_OwnedTexture) * gOwnedTextureSize);
+	}
+
+	// Rebuilt at half full, which also clears out removed slots
+	if ((gOwnedTextureTableUsed + 1) * 2 > gOwnedTextureTableSize) {
+		int size = 32;
+		while (size < (gOwnedTextureCount + 1) * 4)
+			size *= 2;
+		gOwnedTextureTableSize = size;
+		gOwnedTextureTableUsed = 0;
+		gOwnedTextureTable = realloc(gOwnedTextureTable, sizeof(int) * size);
+		memset(gOwnedTextureTable, OWNED_TEXTURE_EMPTY, sizeof(int) * size);
+		for (int i = 0; i < gOwnedTextureCount; i++)
+			_vksk_OwnedTextureInsert(i);
+	}
+
+	int index = gOwnedTextureCount++;
+	gOwnedTextures[index].tex = tex;
+	gOwnedTextures[index].image = image;
+	gOwnedTextures[index].mips = NULL;
+	_vksk_OwnedTextureInsert(index);
+}
+
+// Takes the entry in `slot` out, the last entry is moved into its place
+static void _vksk_OwnedTextureRemove(int slot) {
+	int index = gOwnedTextureTable[slot];
+	int last = --gOwnedTextureCount;
+	gOwnedTextureTable[slot] = OWNED_TEXTURE_REMOVED;
+	if (index != last) {
+		gOwnedTextureTable[_vksk_OwnedTextureFind(gOwnedTextures[last].tex)] = index;
+		gOwnedTextures[index] = gOwnedTextures[last];
+	}
+}
+
+// Makes a texture that owns the image made from pixels, returns NULL if either couldn't be made
+static VK2DTexture _vksk_TextureFromPixels(uint8_t *pixels, int w, int h) {
+	VK2DImage image = vk2dImageFromPixels(vk2dRendererGetDevice(), pixels, w, h, true);
+	VK2DTexture tex = image != NULL ? vk2dTextureLoadFromImage(image) : NULL;
+	if (tex != NULL)
+		_vksk_OwnedTextureAdd(tex, image);
+	else if (image != NULL)
+		vk2dImageFree(image);
+	return tex;
+}
+
+// Same as _vksk_TextureFromPixels but for pixels with a mip chain after them (see vksk_TextureLoadPixels), the
+// levels past 0 go in the texture's mip chain
+static VK2DTexture _vksk_TextureFromLevels(uint8_t *pixels, int w, int h, int levels) {
+	VK2DTexture tex = _vksk_TextureFromPixels(pixels, w, h);
+	if (tex == NULL || levels <= 1)
+		return tex;
+	_vksk_MipChain *chain = malloc(sizeof(struct _vksk_MipChain));
+	chain->base = tex;
+	chain->levels = malloc(sizeof(VK2DTexture) * (levels - 1));
+	chain->count = 0;
+	for (int i = 1; i < levels; i++) {
+		pixels += (size_t)vksk_TextureLevelSize(w, i - 1) * vksk_TextureLevelSize(h, i - 1) * 4;
+		VK2DTexture level = _vksk_TextureFromPixels(pixels, vksk_TextureLevelSize(w, i), vksk_TextureLevelSize(h, i));
+		if (level == NULL)
+			break;
+		chain->levels[chain->count++] = level;
+	}
+	gOwnedTextures[gOwnedTextureTable[_vksk_OwnedTextureFind(tex)]].mips = chain;
+	return tex;
+}
+
+VK2DTexture vksk_TextureFromCoverage(const uint8_t *coverage, int w, int h) {
+	// VK2D only makes RGBA images so the coverage is widened to white in a temporary w * h * 4 copy right before
+	// the upload, this is the only place that has to change once it can make single-channel ones
+	uint8_t *pixels = malloc((size_t)w * h * 4);
+	if (pixels == NULL)
+		return NULL;
+	for (int i = 0; i < w * h; i++) {
+		pixels[i * 4] = 255;
+		pixels[i * 4 + 1] = 255;
+		pixels[i * 4 + 2] = 255;
+		pixels[i * 4 + 3] = coverage[i];
+	}
+	VK2DTexture tex = _vksk_TextureFromPixels(pixels, w, h);
+	free(pixels);
+	return tex;
+}
+
+VK2DTexture vksk_TextureFromFileData(const uint8_t *data, int size, bool mipmaps) {
+	// Textures Packer converted are decoded here since VK2D only knows the formats stb_image does
+	if (!vksk_TextureIsEncoded(data, size))
+		return vk2dTextureFrom((void*)data, size);
+	int w, h, levels;
+	uint8_t *coverage = vksk_TextureDecodeAlpha(data, size, &w, &h);
+	if (coverage != NULL) {
+		VK2DTexture tex = vksk_TextureFromCoverage(coverage, w, h);
+		free(coverage);
+		return tex;
+	}
+	uint8_t *pixels = vksk_TextureLoadPixels(data, size, &w, &h, mipmaps ? &levels : NULL);
+	if (pixels == NULL)
+		return NULL;
+	VK2DTexture tex = _vksk_TextureFromLevels(pixels, w, h, mipmaps ? levels : 1);
+	stbi_image_free(pixels);
+	return tex;
+}
+
+_vksk_MipChain *vksk_TextureGetMipChain(VK2DTexture tex) {
+	int slot = _vksk_OwnedTextureFind(tex);
+	return slot != -1 ? gOwnedTextures[gOwnedTextureTable[slot]].mips : NULL;
+}
+
+void vksk_TextureFree(VK2DTexture tex) {
+	if (tex == NULL)
+		return;
+	VK2DImage image = NULL;
+	_vksk_MipChain *chain = NULL;
+	int slot = _vksk_OwnedTextureFind(tex);
+	if (slot != -1) {
+		image = gOwnedTextures[gOwnedTextureTable[slot]].image;
+		chain = gOwnedTextures[gOwnedTextureTable[slot]].mips;
+		_vksk_OwnedTextureRemove(slot);
+	}
+	if (chain != NULL) {
+		for (int i = 0; i < chain->count; i++)
+			vksk_TextureFree(chain->levels[i]);
+		free(chain->levels);
+		free(chain);
+	}
+	vk2dRendererWait();
+	vk2dTextureFree(tex);
+	if (image != NULL)
+		vk2dImageFree(image);
+}
+
+_vksk_AtlasPage *vksk_AtlasPageCreate(const uint8_t *pixels, int w, int h) {
+	VK2DImage image = vk2dImageFromPixels(vk2dRendererGetDevice(), (void*)pixels, w, h, true);
+	if (image == NULL)
+		return NULL;
+	VK2DTexture tex = vk2dTextureLoadFromImage(image);
+	if (tex == NULL) {
+		vk2dImageFree(image);
+		return NULL;
+	}
+	_vksk_AtlasPage *page = malloc(sizeof(struct _vksk_AtlasPage));
+	page->tex = tex;
+	page->image = image;
+	page->references = 1;
+	return page;
+}
+
+void vksk_AtlasPageRelease(_vksk_AtlasPage *page) {
+	if (page != NULL && --page->references == 0) {
+		vk2dRendererWait();
+		vk2dTextureFree(page->tex);
+		vk2dImageFree(page->image);
+		free(page);
+	}
+}
+
+void vksk_RuntimeVK2DTextureFromRegion(WrenVM *vm, const _vksk_TextureRegion *region) {
+	VKSK_RuntimeForeign* tex = (VKSK_RuntimeForeign*)wrenSetSlotNewForeign(vm,0, 0, sizeof(VKSK_RuntimeForeign));
+	tex->type = FOREIGN_TEXTURE;
+	tex->texture.tex = region->page->tex;
+	tex->texture.region = *region;
+	tex->texture.mips = NULL;
+	tex->texture.mipmaps = false;
+	region->page->references++;
+}
+
 void vksk_RuntimeVK2DTextureAllocate(WrenVM *vm) {
 	VALIDATE_FOREIGN_ARGS(vm, FOREIGN_STRING, FOREIGN_END)
 	VKSK_RuntimeForeign* tex = (VKSK_RuntimeForeign*)wrenSetSlotNewForeign(vm,0, 0, sizeof(VKSK_RuntimeForeign));
+	tex->texture.region.page = NULL;
+	tex->texture.mips = NULL;
+	tex->texture.mipmaps = true;
+
+	// Files with the same contents in game.pak share one texture
+	uint64_t blob = vksk_GetFileBlobID(wrenGetSlotString(vm, 1));
+	tex->type = FOREIGN_TEXTURE;
+	tex->texture.tex = vksk_AssetCacheGet(FOREIGN_TEXTURE, blob);
+	if (tex->texture.tex != NULL) {
+		tex->texture.mips = vksk_TextureGetMipChain(tex->texture.tex);
+		return;
+	}
 
-	int size;
-	void *buffer = vksk_GetFileBuffer(wrenGetSlotString(vm, 1), &size);
-	if (buffer != NULL) {
-		tex->texture.tex = vk2dTextureFrom(buffer, size);
-		tex->type = FOREIGN_TEXTURE;
+	// Assets.load_assets decodes textures ahead of time on other threads, leaving just the upload
+	int w, h, levels;
+	uint8_t *pixels = vksk_TakeDecodedTexture(wrenGetSlotString(vm, 1), &w, &h, &levels);
+	if (pixels != NULL) {
+		tex->texture.tex = _vksk_TextureFromLevels(pixels, w, h, levels);
+		stbi_image_free(pixels);
+		if (tex->texture.tex != NULL) {
+			tex->texture.mips = vksk_TextureGetMipChain(tex->texture.tex);
+			vksk_AssetCacheAdd(FOREIGN_TEXTURE, blob, tex->texture.tex);
+			return;
+		}
+	}
+
+	VKSK_FileView view;
+	if (vksk_GetFileView(wrenGetSlotString(vm, 1), &view)) {
+		tex->texture.tex = vksk_TextureFromFileData(view.data, view.size, true);
+		tex->texture.mips = vksk_TextureGetMipChain(tex->texture.tex);
 		if (tex->texture.tex == NULL) {
 			vksk_Error(false, "Failed to load texture '%s'", wrenGetSlotString(vm, 1));
 			wrenSetSlotNull(vm, 0);
+		} else {
+			vksk_AssetCacheAdd(FOREIGN_TEXTURE, blob, tex->texture.tex);
 		}
-		free(buffer);
+		vksk_ReleaseFileView(&view);
 	} else {
 		vksk_Error(false, "Failed to load texture buffer '%s'", wrenGetSlotString(vm, 1));
 		wrenSetSlotNull(vm, 0);
@@ -38,25 +283,58 @@ void vksk_RuntimeVK2DTextureAllocate(WrenVM *vm) {
 }
 
 void vksk_RuntimeVK2DTextureFinalize(void *data) {
-	vk2dRendererWait();
-	vk2dTextureFree(((VKSK_RuntimeForeign*)data)->texture.tex);
+	VKSK_RuntimeForeign *tex = data;
+	if (tex->texture.region.page != NULL)
+		vksk_AtlasPageRelease(tex->texture.region.page);
+	else if (vksk_AssetCacheRelease(tex->texture.tex))
+		vksk_TextureFree(tex->texture.tex);
 }
 
 void vksk_RuntimeVK2DTextureFree(WrenVM *vm) {
 	VKSK_RuntimeForeign *tex = wrenGetSlotForeign(vm, 0);
-	vk2dRendererWait();
-	vk2dTextureFree(tex->texture.tex);
+	if (tex->texture.region.page != NULL)
+		vksk_AtlasPageRelease(tex->texture.region.page);
+	else if (vksk_AssetCacheRelease(tex->texture.tex))
+		vksk_TextureFree(tex->texture.tex);
 	tex->texture.tex = NULL;
+	tex->texture.region.page = NULL;
+	tex->texture.mips = NULL;
 }
 
 void vksk_RuntimeVK2DTextureWidth(WrenVM *vm) {
 	VKSK_RuntimeForeign *tex = wrenGetSlotForeign(vm, 0);
-	wrenSetSlotDouble(vm, 0, vk2dTextureWidth(tex->texture.tex));
+	if (tex->texture.region.page != NULL)
+		wrenSetSlotDouble(vm, 0, tex->texture.region.w);
+	else
+		wrenSetSlotDouble(vm, 0, vk2dTextureWidth(tex->texture.tex));
 }
 
 void vksk_RuntimeVK2DTextureHeight(WrenVM *vm) {
 	VKSK_RuntimeForeign *tex = wrenGetSlotForeign(vm, 0);
-	wrenSetSlotDouble(vm, 0, vk2dTextureHeight(tex->texture.tex));
+	if (tex->texture.region.page != NULL)
+		wrenSetSlotDouble(vm, 0, tex->texture.region.h);
+	else
+		wrenSetSlotDouble(vm, 0, vk2dTextureHeight(tex->texture.tex));
+}
+
+// Models and lights use the whole texture so they can't use one that's only part of an atlas page
+static bool _vksk_TextureIsInAtlas(VKSK_RuntimeForeign *tex, const char *use) {
+	if (tex->type == FOREIGN_TEXTURE && tex->texture.region.page != NULL) {
+		vksk_Error(false, "Textures packed into an atlas can't be used for %s, add \"atlas\": false to its directory's assets.json", use);
+		return true;
+	}
+	return false;
+}
+
+void vksk_RuntimeVK2DTextureGetMipmaps(WrenVM *vm) {
+	VKSK_RuntimeForeign *tex = wrenGetSlotForeign(vm, 0);
+	wrenSetSlotBool(vm, 0, tex->texture.mips != NULL && tex->texture.mipmaps);
+}
+
+void vksk_RuntimeVK2DTextureSetMipmaps(WrenVM *vm) {
+	VALIDATE_FOREIGN_ARGS(vm, FOREIGN_BOOL, FOREIGN_END)
+	VKSK_RuntimeForeign *tex = wrenGetSlotForeign(vm, 0);
+	tex->texture.mipmaps = wrenGetSlotBool(vm, 1);
 }
 
 /*************** Surface ***************/
@@ -336,18 +614,19 @@ void vksk_RuntimeVK2DShaderAllocate(WrenVM *vm) {
 	shader->type = FOREIGN_SHADER;
 
 	// Load shaders from pak or otherwise
-	void *vert, *frag;
-	int vertSize, fragSize;
-	vert = vksk_GetFileBuffer(wrenGetSlotString(vm, 1), &vertSize);
-	frag = vksk_GetFileBuffer(wrenGetSlotString(vm, 2), &fragSize);
+	VKSK_FileView vert, frag;
+	vksk_GetFileView(wrenGetSlotString(vm, 1), &vert);
+	vksk_GetFileView(wrenGetSlotString(vm, 2), &frag);
 
 	shader->shader.shader = vk2dShaderFrom(
-			vert,
-			vertSize,
-			frag,
-			fragSize,
+			(void*)vert.data,
+			vert.size,
+			(void*)frag.data,
+			frag.size,
 			(int)wrenGetSlotDouble(vm, 3)
 	);
+	vksk_ReleaseFileView(&vert);
+	vksk_ReleaseFileView(&frag);
 	shader->shader.size = (int)wrenGetSlotDouble(vm, 3);
 	shader->shader.data = NULL;
 	if (shader->shader.shader == NULL) {
@@ -435,6 +714,11 @@ void vksk_RuntimeVK2DModelAllocate(WrenVM *vm) {
 		target = tex->surface;
 	else
 		target = tex->texture.tex;
+	if (_vksk_TextureIsInAtlas(tex, "models")) {
+		model->model = NULL;
+		wrenSetSlotNull(vm, 0);
+		return;
+	}
 	// Slot 0 - Output model
 	// Slot 1 - Vertex list
 	// Slot 2 - Index list
@@ -495,11 +779,17 @@ void vksk_RuntimeVK2DModelLoad(WrenVM *vm) {
 		target = tex->surface;
 	else
 		target = tex->texture.tex;
+	if (_vksk_TextureIsInAtlas(tex, "models")) {
+		model->model = NULL;
+		wrenSetSlotNull(vm, 0);
+		return;
+	}
 
-	int size;
-	void *buffer = vksk_GetFileBuffer(fname, &size);
+	VKSK_FileView view;
+	vksk_GetFileView(fname, &view);
 	model->type = FOREIGN_MODEL;
-	model->model = vk2dModelFrom(buffer, size, target);
+	model->model = vk2dModelFrom((void*)view.data, view.size, target);
+	vksk_ReleaseFileView(&view);
 
 	if (model->model == NULL) {
 		wrenSetSlotNull(vm, 0);
@@ -589,7 +879,11 @@ void vksk_RuntimeLightingAddLight(WrenVM *vm) {
     const rotation = wrenGetSlotDouble(vm, 3);
     const originX = wrenGetSlotDouble(vm, 4);
     const originY = wrenGetSlotDouble(vm, 5);
-    const VKSK_RuntimeForeign *texture = wrenGetSlotForeign(vm, 6);
+    VKSK_RuntimeForeign *texture = wrenGetSlotForeign(vm, 6);
+    if (_vksk_TextureIsInAtlas(texture, "lights")) {
+        wrenSetSlotNull(vm, 0);
+        return;
+    }
     VKSK_RuntimeForeign *light = vksk_NewForeignClass(vm, "lib/Drawing", "LightSource", FOREIGN_LIGHT_SOURCE);
     light->lightSourceIndex = _vksk_RendererAddLightSource(
         x,
@@ -726,7 +1020,8 @@ void vksk_RuntimeLightSourceTextureSet(WrenVM *vm) {
     VKSK_RuntimeForeign *lightIndex = wrenGetSlotForeign(vm, 0);
     _vksk_LightSource *light = _vkskRendererGetLightSource(lightIndex->lightSourceIndex);
     VKSK_RuntimeForeign *tex = wrenGetSlotForeign(vm, 1);
-    light->tex = tex->texture.tex;
+    if (!_vksk_TextureIsInAtlas(tex, "lights"))
+        light->tex = tex->texture.tex;
 }
 
 void vksk_RuntimeLightSourceColourSet(WrenVM *vm) {
@@ -4,12 +4,35 @@
 #pragma once
 #include <wren.h>
 
+#include "src/IntermediateTypes.h"
+
 // For VK2D textures
 void vksk_RuntimeVK2DTextureAllocate(WrenVM *);
 void vksk_RuntimeVK2DTextureFinalize(void *data);
 void vksk_RuntimeVK2DTextureFree(WrenVM *vm);
 void vksk_RuntimeVK2DTextureWidth(WrenVM *vm);
 void vksk_RuntimeVK2DTextureHeight(WrenVM *vm);
+void vksk_RuntimeVK2DTextureGetMipmaps(WrenVM *vm);
+void vksk_RuntimeVK2DTextureSetMipmaps(WrenVM *vm);
+
+// Makes a texture from the contents of an image file, which may also be a texture Packer converted (see
+// TextureFormat.h). If `mipmaps` is true and the file has a mip chain it's loaded too and can be found with
+// vksk_TextureGetMipChain. Textures from this must be freed with vksk_TextureFree.
+VK2DTexture vksk_TextureFromFileData(const uint8_t *data, int size, bool mipmaps);
+_vksk_MipChain *vksk_TextureGetMipChain(VK2DTexture tex);
+void vksk_TextureFree(VK2DTexture tex);
+
+// Makes a white texture from one byte of alpha a pixel, like a font's glyph atlas, so it's drawn in whatever colour
+// the colour mod is. The texture is still RGBA, so it takes as much memory as any other. Must be freed with
+// vksk_TextureFree.
+VK2DTexture vksk_TextureFromCoverage(const uint8_t *coverage, int w, int h);
+
+// Atlas pages made from the pixels the asset compiler packed into them, released once nothing references them
+_vksk_AtlasPage *vksk_AtlasPageCreate(const uint8_t *pixels, int w, int h);
+void vksk_AtlasPageRelease(_vksk_AtlasPage *page);
+
+// Puts a new texture for a region of an atlas page into slot 0, the class must already be in slot 0
+void vksk_RuntimeVK2DTextureFromRegion(WrenVM *vm, const _vksk_TextureRegion *region);
 
 // For VK2D textures as render targets
 void vksk_RuntimeVK2DSurfaceAllocate(WrenVM *);
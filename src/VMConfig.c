@@ -231,6 +231,8 @@ WrenForeignMethodFn vksk_WrenBindForeignMethod(WrenVM* vm, const char* module, c
 		BIND_METHOD("Texture", false, "width", vksk_RuntimeVK2DTextureWidth)
 		BIND_METHOD("Texture", false, "height", vksk_RuntimeVK2DTextureHeight)
 		BIND_METHOD("Texture", false, "free()", vksk_RuntimeVK2DTextureFree)
+		BIND_METHOD("Texture", false, "mipmaps", vksk_RuntimeVK2DTextureGetMipmaps)
+		BIND_METHOD("Texture", false, "mipmaps=(_)", vksk_RuntimeVK2DTextureSetMipmaps)
 		BIND_METHOD("Surface", false, "width", vksk_RuntimeVK2DSurfaceWidth)
 		BIND_METHOD("Surface", false, "height", vksk_RuntimeVK2DSurfaceHeight)
 		BIND_METHOD("Surface", false, "free()", vksk_RuntimeVK2DSurfaceFree)
@@ -426,6 +428,10 @@ WrenForeignMethodFn vksk_WrenBindForeignMethod(WrenVM* vm, const char* module, c
         BIND_METHOD("Hitbox", false, "bb_right(_,_)", vksk_RuntimeUtilHitboxBbRight)
         BIND_METHOD("Hitbox", false, "bb_top(_,_)", vksk_RuntimeUtilHitboxBbTop)
         BIND_METHOD("Hitbox", false, "bb_bottom(_,_)", vksk_RuntimeUtilHitboxBbBottom)
-    }
+    } else if (strcmp(module, "Assets") == 0) {
+		BIND_METHOD("AssetsImpl", true, "load_manifest()", vksk_RuntimeAssetsLoadManifest)
+		BIND_METHOD("AssetsImpl", true, "load_asset(_)", vksk_RuntimeAssetsLoadAsset)
+		BIND_METHOD("AssetsImpl", true, "preload(_)", vksk_RuntimeAssetsPreload)
+	}
 	return NULL;
 }
\ No newline at end of file
@@ -142,365 +142,377 @@ const char DRAWING_WREN_SOURCE[] = {
     0x65, 0x69, 0x67, 0x68, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 
     0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
     0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 
-    0x74, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x46, 
-    0x6f, 0x72, 0x63, 0x65, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x69, 0x6e, 0x74, 
-    0x65, 0x72, 0x6e, 0x61, 0x6c, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 
-    0x20, 0x74, 0x6f, 0x20, 0x62, 0x65, 0x20, 0x66, 0x72, 0x65, 0x65, 0x64, 0x20, 
-    0x69, 0x66, 0x20, 0x79, 0x6f, 0x75, 0x20, 0x64, 0x6f, 0x6e, 0x27, 0x74, 0x20, 
-    0x77, 0x61, 0x6e, 0x74, 0x20, 0x74, 0x6f, 0x20, 0x77, 0x61, 0x69, 0x74, 0x20, 
-    0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x67, 0x61, 0x72, 0x62, 0x61, 
-    0x67, 0x65, 0x20, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x0d, 
-    0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
-    0x66, 0x72, 0x65, 0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 
-    0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x20, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x6e, 
-    0x61, 0x6c, 0x20, 0x75, 0x73, 0x65, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x6c, 
-    0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x53, 0x68, 0x61, 
-    0x64, 0x6f, 0x77, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
-    0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 
-    0x6e, 0x3d, 0x28, 0x70, 0x6f, 0x73, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 
-    0x65, 0x28, 0x78, 0x2c, 0x20, 0x79, 0x2c, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 
-    0x5f, 0x78, 0x2c, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x2c, 0x20, 
-    0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x6f, 0x72, 0x69, 
-    0x67, 0x69, 0x6e, 0x5f, 0x78, 0x2c, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 
-    0x5f, 0x79, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x3d, 0x28, 
-    0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
-    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x65, 0x6e, 0x61, 0x62, 
-    0x6c, 0x65, 0x64, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 
-    0x49, 0x6e, 0x74, 0x65, 0x72, 0x6e, 0x61, 0x6c, 0x20, 0x75, 0x73, 0x65, 0x20, 
-    0x66, 0x6f, 0x72, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x73, 0x0d, 0x0a, 
-    0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 
-    0x20, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 
-    0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 
-    0x6e, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x28, 0x70, 
-    0x6f, 0x73, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x0d, 
-    0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
-    0x78, 0x3d, 0x28, 0x78, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
-    0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x79, 0x3d, 0x28, 0x79, 0x29, 
+    0x74, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x57, 
+    0x68, 0x65, 0x74, 0x68, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 
+    0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x64, 0x72, 0x61, 0x77, 
+    0x6e, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x69, 0x74, 0x73, 0x20, 0x6d, 0x69, 
+    0x70, 0x20, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x77, 0x68, 0x65, 0x6e, 0x20, 
+    0x73, 0x63, 0x61, 0x6c, 0x65, 0x64, 0x20, 0x64, 0x6f, 0x77, 0x6e, 0x2c, 0x20, 
+    0x61, 0x6c, 0x77, 0x61, 0x79, 0x73, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x20, 
+    0x77, 0x69, 0x74, 0x68, 0x6f, 0x75, 0x74, 0x20, 0x6f, 0x6e, 0x65, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6d, 
+    0x69, 0x70, 0x6d, 0x61, 0x70, 0x73, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 
+    0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6d, 0x69, 0x70, 0x6d, 0x61, 0x70, 
+    0x73, 0x3d, 0x28, 0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x29, 0x0d, 0x0a, 
+    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x63, 
+    0x65, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x6e, 
+    0x61, 0x6c, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x20, 0x74, 0x6f, 
+    0x20, 0x62, 0x65, 0x20, 0x66, 0x72, 0x65, 0x65, 0x64, 0x20, 0x69, 0x66, 0x20, 
+    0x79, 0x6f, 0x75, 0x20, 0x64, 0x6f, 0x6e, 0x27, 0x74, 0x20, 0x77, 0x61, 0x6e, 
+    0x74, 0x20, 0x74, 0x6f, 0x20, 0x77, 0x61, 0x69, 0x74, 0x20, 0x66, 0x6f, 0x72, 
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x67, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x20, 
+    0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x65, 
+    0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 
+    0x46, 0x6f, 0x72, 0x20, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x6e, 0x61, 0x6c, 0x20, 
+    0x75, 0x73, 0x65, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x6c, 0x69, 0x67, 0x68, 
+    0x74, 0x69, 0x6e, 0x67, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
+    0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 
+    0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
+    0x67, 0x6e, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x28, 
+    0x70, 0x6f, 0x73, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 
+    0x65, 0x69, 0x67, 0x6e, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x28, 0x78, 
+    0x2c, 0x20, 0x79, 0x2c, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x2c, 
+    0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x2c, 0x20, 0x72, 0x6f, 0x74, 
+    0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 
+    0x5f, 0x78, 0x2c, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x29, 
+    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
+    0x20, 0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x3d, 0x28, 0x65, 0x6e, 0x61, 
+    0x62, 0x6c, 0x65, 0x64, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
+    0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x65, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 
+    0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 0x49, 0x6e, 0x74, 
+    0x65, 0x72, 0x6e, 0x61, 0x6c, 0x20, 0x75, 0x73, 0x65, 0x20, 0x66, 0x6f, 0x72, 
+    0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x73, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 
+    0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x4c, 0x69, 
+    0x67, 0x68, 0x74, 0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 0x7b, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x70, 
+    0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x28, 0x70, 0x6f, 0x73, 0x29, 
     0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
-    0x20, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
-    0x67, 0x6e, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x28, 
-    0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x0d, 0x0a, 0x20, 0x20, 
-    0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x72, 0x6f, 0x74, 
-    0x61, 0x74, 0x69, 0x6f, 0x6e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
+    0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x78, 0x3d, 0x28, 
+    0x78, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
+    0x67, 0x6e, 0x20, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 
+    0x65, 0x69, 0x67, 0x6e, 0x20, 0x79, 0x3d, 0x28, 0x79, 0x29, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x79, 0x0d, 
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
+    0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x28, 0x72, 0x6f, 0x74, 
+    0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 
+    0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 
+    0x6f, 0x6e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
+    0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x3d, 0x28, 
+    0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x29, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 
+    0x67, 0x69, 0x6e, 0x5f, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
     0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 
-    0x78, 0x3d, 0x28, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x29, 0x0d, 
+    0x79, 0x3d, 0x28, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x29, 0x0d, 
     0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
-    0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
-    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 0x67, 
-    0x69, 0x6e, 0x5f, 0x79, 0x3d, 0x28, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 
-    0x79, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
-    0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x0d, 0x0a, 
-    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 
-    0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x3d, 0x28, 0x73, 0x63, 0x61, 0x6c, 0x65, 
-    0x5f, 0x78, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x0d, 0x0a, 
-    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 
-    0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x3d, 0x28, 0x73, 0x63, 0x61, 0x6c, 0x65, 
-    0x5f, 0x79, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x0d, 0x0a, 
-    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x74, 
-    0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x3d, 0x28, 0x74, 0x65, 0x78, 0x74, 0x75, 
-    0x72, 0x65, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x75, 0x72, 0x0d, 0x0a, 0x20, 
-    0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 0x6f, 
-    0x6c, 0x6f, 0x75, 0x72, 0x3d, 0x28, 0x63, 0x6f, 0x6c, 0x6f, 0x75, 0x72, 0x29, 
+    0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
+    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 0x61, 0x6c, 
+    0x65, 0x5f, 0x78, 0x3d, 0x28, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x29, 
     0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
-    0x20, 0x64, 0x65, 0x6c, 0x65, 0x74, 0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d, 0x0d, 
-    0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x73, 
-    0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 
-    0x73, 0x73, 0x20, 0x4c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x20, 0x7b, 
+    0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
+    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 0x61, 0x6c, 
+    0x65, 0x5f, 0x79, 0x3d, 0x28, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x29, 
     0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
-    0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 0x61, 0x64, 0x64, 0x5f, 0x73, 
-    0x68, 0x61, 0x64, 0x6f, 0x77, 0x28, 0x65, 0x64, 0x67, 0x65, 0x73, 0x29, 0x20, 
-    0x2f, 0x2f, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x61, 0x20, 
-    0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x6f, 0x62, 0x6a, 0x65, 0x63, 0x74, 
+    0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
+    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x74, 0x65, 0x78, 0x74, 
+    0x75, 0x72, 0x65, 0x3d, 0x28, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x29, 
     0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
-    0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 0x61, 0x64, 0x64, 0x5f, 0x6c, 
-    0x69, 0x67, 0x68, 0x74, 0x28, 0x78, 0x2c, 0x20, 0x79, 0x2c, 0x20, 0x72, 0x6f, 
-    0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 
-    0x6e, 0x5f, 0x78, 0x2c, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 
-    0x2c, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x29, 0x20, 0x2f, 0x2f, 
-    0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x61, 0x20, 0x6e, 0x65, 
-    0x77, 0x20, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 
-    0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 
-    0x6e, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 0x72, 0x65, 0x73, 0x65, 
-    0x74, 0x28, 0x29, 0x20, 0x2f, 0x2f, 0x20, 0x64, 0x65, 0x73, 0x74, 0x72, 0x6f, 
-    0x79, 0x73, 0x20, 0x61, 0x6c, 0x6c, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 
-    0x20, 0x6f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x73, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
-    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x74, 0x61, 0x74, 
-    0x69, 0x63, 0x20, 0x66, 0x6c, 0x75, 0x73, 0x68, 0x5f, 0x76, 0x62, 0x6f, 0x28, 
-    0x29, 0x20, 0x2f, 0x2f, 0x20, 0x63, 0x61, 0x6c, 0x6c, 0x20, 0x6f, 0x6e, 0x63, 
-    0x65, 0x20, 0x64, 0x6f, 0x6e, 0x65, 0x20, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 
-    0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x6f, 0x62, 0x6a, 0x65, 0x63, 
-    0x74, 0x73, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 0x54, 
-    0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x73, 0x20, 0x79, 0x6f, 0x75, 0x20, 0x63, 
-    0x61, 0x6e, 0x20, 0x64, 0x72, 0x61, 0x77, 0x20, 0x74, 0x6f, 0x0d, 0x0a, 0x66, 
+    0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x75, 0x72, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+    0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x75, 
+    0x72, 0x3d, 0x28, 0x63, 0x6f, 0x6c, 0x6f, 0x75, 0x72, 0x29, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x64, 0x65, 
+    0x6c, 0x65, 0x74, 0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 
+    0x2f, 0x2f, 0x20, 0x53, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x73, 0x0d, 0x0a, 0x66, 
     0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 
-    0x53, 0x75, 0x72, 0x66, 0x61, 0x63, 0x65, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 
-    0x20, 0x20, 0x2f, 0x2f, 0x20, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x73, 0x20, 
-    0x61, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x73, 0x75, 0x72, 0x66, 0x61, 0x63, 0x65, 
-    0x20, 0x79, 0x6f, 0x75, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x64, 0x72, 0x61, 0x77, 
-    0x20, 0x6f, 0x6e, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x64, 0x72, 0x61, 0x77, 0x20, 
-    0x74, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 
-    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x72, 0x75, 
-    0x63, 0x74, 0x20, 0x6e, 0x65, 0x77, 0x28, 0x77, 0x69, 0x64, 0x74, 0x68, 0x2c, 
-    0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x29, 0x20, 0x7b, 0x7d, 0x0d, 0x0a, 
-    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 
-    0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 
-    0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 
-    0x72, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
-    0x67, 0x6e, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 
+    0x4c, 0x69, 0x67, 0x68, 0x74, 0x69, 0x6e, 0x67, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x74, 
+    0x61, 0x74, 0x69, 0x63, 0x20, 0x61, 0x64, 0x64, 0x5f, 0x73, 0x68, 0x61, 0x64, 
+    0x6f, 0x77, 0x28, 0x65, 0x64, 0x67, 0x65, 0x73, 0x29, 0x20, 0x2f, 0x2f, 0x20, 
+    0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x61, 0x20, 0x73, 0x68, 0x61, 
+    0x64, 0x6f, 0x77, 0x20, 0x6f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x74, 
+    0x61, 0x74, 0x69, 0x63, 0x20, 0x61, 0x64, 0x64, 0x5f, 0x6c, 0x69, 0x67, 0x68, 
+    0x74, 0x28, 0x78, 0x2c, 0x20, 0x79, 0x2c, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 
+    0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 
+    0x2c, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x2c, 0x20, 0x74, 
+    0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x29, 0x20, 0x2f, 0x2f, 0x20, 0x72, 0x65, 
+    0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x61, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x6c, 
+    0x69, 0x67, 0x68, 0x74, 0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 
+    0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 0x72, 0x65, 0x73, 0x65, 0x74, 0x28, 0x29, 
+    0x20, 0x2f, 0x2f, 0x20, 0x64, 0x65, 0x73, 0x74, 0x72, 0x6f, 0x79, 0x73, 0x20, 
+    0x61, 0x6c, 0x6c, 0x20, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x20, 0x6f, 0x62, 
+    0x6a, 0x65, 0x63, 0x74, 0x73, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
+    0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 
+    0x66, 0x6c, 0x75, 0x73, 0x68, 0x5f, 0x76, 0x62, 0x6f, 0x28, 0x29, 0x20, 0x2f, 
+    0x2f, 0x20, 0x63, 0x61, 0x6c, 0x6c, 0x20, 0x6f, 0x6e, 0x63, 0x65, 0x20, 0x64, 
+    0x6f, 0x6e, 0x65, 0x20, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x73, 0x68, 
+    0x61, 0x64, 0x6f, 0x77, 0x20, 0x6f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x73, 0x0d, 
+    0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 0x54, 0x65, 0x78, 0x74, 
+    0x75, 0x72, 0x65, 0x73, 0x20, 0x79, 0x6f, 0x75, 0x20, 0x63, 0x61, 0x6e, 0x20, 
+    0x64, 0x72, 0x61, 0x77, 0x20, 0x74, 0x6f, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 
+    0x69, 0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x53, 0x75, 0x72, 
+    0x66, 0x61, 0x63, 0x65, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 
+    0x2f, 0x20, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x73, 0x20, 0x61, 0x20, 0x6e, 
+    0x65, 0x77, 0x20, 0x73, 0x75, 0x72, 0x66, 0x61, 0x63, 0x65, 0x20, 0x79, 0x6f, 
+    0x75, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x64, 0x72, 0x61, 0x77, 0x20, 0x6f, 0x6e, 
+    0x20, 0x61, 0x6e, 0x64, 0x20, 0x64, 0x72, 0x61, 0x77, 0x20, 0x74, 0x6f, 0x20, 
+    0x74, 0x68, 0x65, 0x20, 0x73, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 
+    0x6e, 0x65, 0x77, 0x28, 0x77, 0x69, 0x64, 0x74, 0x68, 0x2c, 0x20, 0x68, 0x65, 
+    0x69, 0x67, 0x68, 0x74, 0x29, 0x20, 0x7b, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 
     0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 
-    0x20, 0x74, 0x68, 0x65, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x20, 0x6f, 
-    0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 
-    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
-    0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x20, 0x6f, 0x66, 
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x0d, 
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
+    0x77, 0x69, 0x64, 0x74, 0x68, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+    0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 
+    0x65, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x74, 
+    0x68, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x68, 0x65, 
+    0x69, 0x67, 0x68, 0x74, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 
+    0x2f, 0x20, 0x46, 0x6f, 0x72, 0x63, 0x65, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 
+    0x73, 0x75, 0x72, 0x66, 0x61, 0x63, 0x65, 0x20, 0x74, 0x6f, 0x20, 0x62, 0x65, 
+    0x20, 0x66, 0x72, 0x65, 0x65, 0x64, 0x20, 0x69, 0x66, 0x20, 0x79, 0x6f, 0x75, 
+    0x20, 0x64, 0x6f, 0x6e, 0x27, 0x74, 0x20, 0x77, 0x61, 0x6e, 0x74, 0x20, 0x74, 
+    0x6f, 0x20, 0x77, 0x61, 0x69, 0x74, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 
+    0x65, 0x20, 0x67, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x20, 0x63, 0x6f, 0x6c, 
+    0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 
+    0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x65, 0x65, 0x28, 0x29, 
+    0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 0x41, 0x6e, 0x69, 
+    0x6d, 0x61, 0x74, 0x65, 0x64, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x73, 
+    0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 
+    0x73, 0x73, 0x20, 0x53, 0x70, 0x72, 0x69, 0x74, 0x65, 0x20, 0x7b, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x4c, 0x6f, 0x61, 0x64, 0x73, 0x20, 
+    0x61, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x20, 0x66, 0x72, 0x6f, 0x6d, 
+    0x20, 0x61, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x73, 0x68, 0x65, 0x65, 
+    0x74, 0x2c, 0x20, 0x78, 0x2f, 0x79, 0x20, 0x69, 0x73, 0x20, 0x77, 0x68, 0x65, 
+    0x72, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x74, 0x68, 
+    0x65, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 
+    0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 
+    0x73, 0x68, 0x65, 0x65, 0x74, 0x2c, 0x20, 0x77, 0x2f, 0x68, 0x20, 0x69, 0x73, 
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x68, 0x65, 0x69, 
+    0x67, 0x68, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x65, 0x61, 0x63, 0x68, 0x20, 0x66, 
+    0x72, 0x61, 0x6d, 0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x66, 0x72, 0x61, 0x6d, 
+    0x65, 0x73, 0x20, 0x69, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6e, 0x75, 0x6d, 
+    0x62, 0x65, 0x72, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x6f, 
+    0x66, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x74, 0x6f, 0x20, 0x70, 
+    0x75, 0x6c, 0x6c, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x74, 0x68, 0x65, 0x20, 
+    0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x73, 0x68, 0x65, 0x65, 0x74, 0x20, 0x0d, 
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x72, 0x75, 0x63, 
+    0x74, 0x20, 0x6e, 0x65, 0x77, 0x28, 0x66, 0x69, 0x6c, 0x65, 0x6e, 0x61, 0x6d, 
+    0x65, 0x2c, 0x20, 0x78, 0x2c, 0x20, 0x79, 0x2c, 0x20, 0x77, 0x2c, 0x20, 0x68, 
+    0x2c, 0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x2c, 0x20, 0x66, 0x72, 0x61, 0x6d, 
+    0x65, 0x73, 0x29, 0x20, 0x7b, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
+    0x20, 0x2f, 0x2f, 0x20, 0x53, 0x61, 0x6d, 0x65, 0x20, 0x61, 0x73, 0x20, 0x6e, 
+    0x65, 0x77, 0x20, 0x62, 0x75, 0x74, 0x20, 0x75, 0x73, 0x65, 0x73, 0x20, 0x61, 
+    0x6e, 0x20, 0x61, 0x6c, 0x72, 0x65, 0x61, 0x64, 0x79, 0x20, 0x6c, 0x6f, 0x61, 
+    0x64, 0x65, 0x64, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 
+    0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x28, 0x74, 0x65, 
+    0x78, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x78, 0x2c, 0x20, 0x79, 0x2c, 0x20, 
+    0x77, 0x2c, 0x20, 0x68, 0x2c, 0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x2c, 0x20, 
+    0x66, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 
     0x20, 0x20, 0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x63, 0x65, 0x73, 0x20, 0x74, 
-    0x68, 0x65, 0x20, 0x73, 0x75, 0x72, 0x66, 0x61, 0x63, 0x65, 0x20, 0x74, 0x6f, 
-    0x20, 0x62, 0x65, 0x20, 0x66, 0x72, 0x65, 0x65, 0x64, 0x20, 0x69, 0x66, 0x20, 
-    0x79, 0x6f, 0x75, 0x20, 0x64, 0x6f, 0x6e, 0x27, 0x74, 0x20, 0x77, 0x61, 0x6e, 
-    0x74, 0x20, 0x74, 0x6f, 0x20, 0x77, 0x61, 0x69, 0x74, 0x20, 0x66, 0x6f, 0x72, 
-    0x20, 0x74, 0x68, 0x65, 0x20, 0x67, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x20, 
-    0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x0d, 0x0a, 0x20, 0x20, 
-    0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x65, 
-    0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 
-    0x41, 0x6e, 0x69, 0x6d, 0x61, 0x74, 0x65, 0x64, 0x20, 0x73, 0x70, 0x72, 0x69, 
-    0x74, 0x65, 0x73, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
-    0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x53, 0x70, 0x72, 0x69, 0x74, 0x65, 0x20, 
-    0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x4c, 0x6f, 0x61, 
-    0x64, 0x73, 0x20, 0x61, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x20, 0x66, 
-    0x72, 0x6f, 0x6d, 0x20, 0x61, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x73, 
-    0x68, 0x65, 0x65, 0x74, 0x2c, 0x20, 0x78, 0x2f, 0x79, 0x20, 0x69, 0x73, 0x20, 
-    0x77, 0x68, 0x65, 0x72, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 
-    0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x61, 
-    0x72, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x70, 0x72, 
-    0x69, 0x74, 0x65, 0x73, 0x68, 0x65, 0x65, 0x74, 0x2c, 0x20, 0x77, 0x2f, 0x68, 
-    0x20, 0x69, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 
-    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x61, 0x6e, 0x64, 0x20, 
-    0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x65, 0x61, 0x63, 
-    0x68, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x66, 
-    0x72, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x69, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 
-    0x6e, 0x75, 0x6d, 0x62, 0x65, 0x72, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 
-    0x2f, 0x20, 0x6f, 0x66, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x74, 
-    0x6f, 0x20, 0x70, 0x75, 0x6c, 0x6c, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x74, 
-    0x68, 0x65, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x73, 0x68, 0x65, 0x65, 
-    0x74, 0x20, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 
-    0x72, 0x75, 0x63, 0x74, 0x20, 0x6e, 0x65, 0x77, 0x28, 0x66, 0x69, 0x6c, 0x65, 
-    0x6e, 0x61, 0x6d, 0x65, 0x2c, 0x20, 0x78, 0x2c, 0x20, 0x79, 0x2c, 0x20, 0x77, 
-    0x2c, 0x20, 0x68, 0x2c, 0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x2c, 0x20, 0x66, 
-    0x72, 0x61, 0x6d, 0x65, 0x73, 0x29, 0x20, 0x7b, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 
-    0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x61, 0x6d, 0x65, 0x20, 0x61, 
-    0x73, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x62, 0x75, 0x74, 0x20, 0x75, 0x73, 0x65, 
-    0x73, 0x20, 0x61, 0x6e, 0x20, 0x61, 0x6c, 0x72, 0x65, 0x61, 0x64, 0x79, 0x20, 
-    0x6c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 
-    0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 
-    0x6e, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 0x66, 0x72, 0x6f, 0x6d, 
-    0x28, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x78, 0x2c, 0x20, 
-    0x79, 0x2c, 0x20, 0x77, 0x2c, 0x20, 0x68, 0x2c, 0x20, 0x64, 0x65, 0x6c, 0x61, 
-    0x79, 0x2c, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x29, 0x0d, 0x0a, 0x0d, 
-    0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x63, 0x65, 
-    0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x20, 
-    0x74, 0x6f, 0x20, 0x62, 0x65, 0x20, 0x66, 0x72, 0x65, 0x65, 0x64, 0x20, 0x69, 
-    0x66, 0x20, 0x79, 0x6f, 0x75, 0x20, 0x64, 0x6f, 0x6e, 0x27, 0x74, 0x20, 0x77, 
-    0x61, 0x6e, 0x74, 0x20, 0x74, 0x6f, 0x20, 0x77, 0x61, 0x69, 0x74, 0x20, 0x66, 
-    0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x67, 0x61, 0x72, 0x62, 0x61, 0x67, 
-    0x65, 0x20, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x0d, 0x0a, 
-    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 
-    0x72, 0x65, 0x65, 0x28, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x61, 0x20, 
-    0x63, 0x6f, 0x70, 0x79, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 
-    0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x6a, 
-    0x75, 0x73, 0x74, 0x20, 0x72, 0x65, 0x66, 0x65, 0x72, 0x65, 0x6e, 0x63, 0x65, 
-    0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x6e, 0x61, 
-    0x6c, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x74, 0x65, 0x78, 
-    0x74, 0x75, 0x72, 0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x64, 0x6f, 0x65, 0x73, 
-    0x6e, 0x27, 0x74, 0x20, 0x63, 0x6f, 0x70, 0x79, 0x20, 0x69, 0x74, 0x0d, 0x0a, 
-    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 
-    0x6f, 0x70, 0x79, 0x28, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x63, 0x75, 
-    0x72, 0x72, 0x65, 0x6e, 0x74, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x20, 0x69, 
-    0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x61, 0x6e, 0x69, 0x6d, 0x61, 0x74, 0x69, 
-    0x6f, 0x6e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
-    0x67, 0x6e, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
-    0x20, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x65, 0x74, 
-    0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 
-    0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 
-    0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x3d, 
-    0x28, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 
-    0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 
-    0x74, 0x68, 0x65, 0x20, 0x6e, 0x75, 0x6d, 0x62, 0x65, 0x72, 0x20, 0x6f, 0x66, 
-    0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 
-    0x65, 0x20, 0x61, 0x6e, 0x69, 0x6d, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0d, 
+    0x68, 0x65, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x20, 0x74, 0x6f, 0x20, 
+    0x62, 0x65, 0x20, 0x66, 0x72, 0x65, 0x65, 0x64, 0x20, 0x69, 0x66, 0x20, 0x79, 
+    0x6f, 0x75, 0x20, 0x64, 0x6f, 0x6e, 0x27, 0x74, 0x20, 0x77, 0x61, 0x6e, 0x74, 
+    0x20, 0x74, 0x6f, 0x20, 0x77, 0x61, 0x69, 0x74, 0x20, 0x66, 0x6f, 0x72, 0x20, 
+    0x74, 0x68, 0x65, 0x20, 0x67, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x20, 0x63, 
+    0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
+    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x65, 0x65, 
+    0x28, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 
+    0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x61, 0x20, 0x63, 0x6f, 0x70, 
+    0x79, 0x20, 0x6f, 0x66, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 
+    0x69, 0x74, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x6a, 0x75, 0x73, 0x74, 
+    0x20, 0x72, 0x65, 0x66, 0x65, 0x72, 0x65, 0x6e, 0x63, 0x65, 0x73, 0x20, 0x74, 
+    0x68, 0x65, 0x20, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x6e, 0x61, 0x6c, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 
+    0x65, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x64, 0x6f, 0x65, 0x73, 0x6e, 0x27, 0x74, 
+    0x20, 0x63, 0x6f, 0x70, 0x79, 0x20, 0x69, 0x74, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
+    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 0x6f, 0x70, 0x79, 
+    0x28, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 
+    0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 
+    0x6e, 0x74, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x74, 
+    0x68, 0x65, 0x20, 0x61, 0x6e, 0x69, 0x6d, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x0d, 
     0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
-    0x66, 0x72, 0x61, 0x6d, 0x65, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x0d, 0x0a, 
+    0x66, 0x72, 0x61, 0x6d, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 
+    0x68, 0x65, 0x20, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x20, 0x66, 0x72, 
+    0x61, 0x6d, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
+    0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x3d, 0x28, 0x66, 0x72, 
+    0x61, 0x6d, 0x65, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 
+    0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 
+    0x20, 0x6e, 0x75, 0x6d, 0x62, 0x65, 0x72, 0x20, 0x6f, 0x66, 0x20, 0x66, 0x72, 
+    0x61, 0x6d, 0x65, 0x73, 0x20, 0x69, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x61, 
+    0x6e, 0x69, 0x6d, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x61, 
+    0x6d, 0x65, 0x5f, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x47, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 
+    0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x64, 
+    0x65, 0x6c, 0x61, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 
+    0x65, 0x69, 0x67, 0x6e, 0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x0d, 0x0a, 0x0d, 
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 
+    0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 
+    0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 
+    0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x3d, 
+    0x28, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
     0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x47, 0x65, 0x74, 0x73, 
     0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 
-    0x73, 0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 
-    0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x65, 
-    0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 
-    0x65, 0x27, 0x73, 0x20, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x0d, 0x0a, 0x20, 0x20, 
-    0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x64, 0x65, 0x6c, 
-    0x61, 0x79, 0x3d, 0x28, 0x64, 0x65, 0x6c, 0x61, 0x79, 0x29, 0x0d, 0x0a, 0x20, 
-    0x20, 0x20, 0x20, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x47, 
-    0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 
-    0x74, 0x65, 0x27, 0x73, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 
-    0x0d, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6f, 0x72, 
-    0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
-    0x20, 0x2f, 0x2f, 0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 
-    0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x6f, 0x72, 0x69, 
-    0x67, 0x69, 0x6e, 0x5f, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
-    0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 
-    0x78, 0x3d, 0x28, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x29, 0x0d, 
-    0x0a, 0x20, 0x20, 0x20, 0x20, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 
-    0x20, 0x47, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 
-    0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 
-    0x5f, 0x79, 0x0d, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
-    0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 
-    0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 
-    0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x6f, 
-    0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+    0x73, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x0d, 0x0a, 0x09, 
     0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 
-    0x6e, 0x5f, 0x79, 0x3d, 0x28, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 
-    0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x2f, 0x2f, 0x20, 0x47, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 
-    0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x73, 0x63, 0x61, 0x6c, 
-    0x65, 0x5f, 0x78, 0x0d, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
-    0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 
-    0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 
-    0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x73, 
-    0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 
-    0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 
-    0x78, 0x3d, 0x28, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x29, 0x0d, 0x0a, 
+    0x6e, 0x5f, 0x78, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 
+    0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 
+    0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 
+    0x5f, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
+    0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x3d, 0x28, 
+    0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x78, 0x29, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x20, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x47, 0x65, 
+    0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 
+    0x65, 0x27, 0x73, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x0d, 
+    0x0a, 0x09, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 
+    0x67, 0x69, 0x6e, 0x5f, 0x79, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+    0x2f, 0x2f, 0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 
+    0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x6f, 0x72, 0x69, 0x67, 
+    0x69, 0x6e, 0x5f, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 
+    0x65, 0x69, 0x67, 0x6e, 0x20, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 
+    0x3d, 0x28, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x5f, 0x79, 0x29, 0x0d, 0x0a, 
     0x20, 0x20, 0x20, 0x20, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 
     0x47, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 
-    0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 
+    0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 
     0x0d, 0x0a, 0x09, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 
-    0x61, 0x6c, 0x65, 0x5f, 0x79, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+    0x61, 0x6c, 0x65, 0x5f, 0x78, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
     0x2f, 0x2f, 0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 
     0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x73, 0x63, 0x61, 0x6c, 
-    0x65, 0x5f, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x3d, 0x28, 
-    0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
+    0x65, 0x5f, 0x78, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
+    0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x3d, 0x28, 
+    0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x78, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
     0x20, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x47, 0x65, 0x74, 
     0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 
-    0x27, 0x73, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x0d, 0x0a, 
-    0x09, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x72, 0x6f, 0x74, 0x61, 
-    0x74, 0x69, 0x6f, 0x6e, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 
-    0x2f, 0x20, 0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 
-    0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 
-    0x69, 0x6f, 0x6e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 
-    0x28, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x0d, 0x0a, 0x0d, 
-    0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 0x72, 
-    0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 
-    0x27, 0x73, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
-    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x77, 0x69, 0x64, 0x74, 
-    0x68, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 
-    0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x70, 
-    0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 
+    0x27, 0x73, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x0d, 0x0a, 0x09, 
+    0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 
+    0x5f, 0x79, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 
+    0x53, 0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 
+    0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 
     0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
-    0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 
-    0x0a, 0x2f, 0x2f, 0x20, 0x54, 0x72, 0x75, 0x65, 0x54, 0x79, 0x70, 0x65, 0x20, 
-    0x66, 0x6f, 0x6e, 0x74, 0x73, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 
-    0x6e, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x46, 0x6f, 0x6e, 0x74, 0x20, 
-    0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x4f, 0x70, 0x65, 
-    0x6e, 0x73, 0x20, 0x61, 0x20, 0x74, 0x74, 0x66, 0x20, 0x61, 0x6e, 0x64, 0x20, 
-    0x63, 0x61, 0x63, 0x68, 0x65, 0x73, 0x20, 0x69, 0x74, 0x20, 0x73, 0x6f, 0x20, 
-    0x69, 0x74, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x62, 0x65, 0x20, 0x64, 0x72, 0x61, 
-    0x77, 0x6e, 0x20, 0x66, 0x61, 0x73, 0x74, 0x65, 0x72, 0x0d, 0x0a, 0x20, 0x20, 
-    0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x6f, 
-    0x70, 0x65, 0x6e, 0x28, 0x66, 0x69, 0x6c, 0x65, 0x6e, 0x61, 0x6d, 0x65, 0x2c, 
-    0x20, 0x73, 0x69, 0x7a, 0x65, 0x2c, 0x20, 0x61, 0x61, 0x2c, 0x20, 0x75, 0x6e, 
-    0x69, 0x63, 0x6f, 0x64, 0x65, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x2c, 0x20, 
-    0x75, 0x6e, 0x69, 0x63, 0x6f, 0x64, 0x65, 0x5f, 0x65, 0x6e, 0x64, 0x29, 0x20, 
-    0x7b, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 
-    0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 
-    0x69, 0x7a, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x73, 
-    0x20, 0x6f, 0x66, 0x20, 0x61, 0x20, 0x67, 0x69, 0x76, 0x65, 0x6e, 0x20, 0x73, 
-    0x74, 0x72, 0x69, 0x6e, 0x67, 0x20, 0x61, 0x73, 0x20, 0x5b, 0x77, 0x2c, 0x20, 
-    0x68, 0x5d, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
-    0x67, 0x6e, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x28, 0x73, 0x74, 0x72, 0x69, 0x6e, 
-    0x67, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 
-    0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 
-    0x69, 0x7a, 0x65, 0x20, 0x6f, 0x66, 0x20, 0x61, 0x20, 0x73, 0x74, 0x72, 0x69, 
-    0x6e, 0x67, 0x20, 0x61, 0x73, 0x20, 0x69, 0x66, 0x20, 0x69, 0x74, 0x20, 0x77, 
-    0x65, 0x72, 0x65, 0x20, 0x77, 0x72, 0x61, 0x70, 0x70, 0x65, 0x64, 0x0d, 0x0a, 
-    0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 
-    0x69, 0x7a, 0x65, 0x5f, 0x77, 0x72, 0x61, 0x70, 0x70, 0x65, 0x64, 0x28, 0x73, 
-    0x74, 0x72, 0x69, 0x6e, 0x67, 0x2c, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x29, 
-    0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x61, 
-    0x6d, 0x65, 0x20, 0x61, 0x73, 0x20, 0x61, 0x62, 0x6f, 0x76, 0x65, 0x20, 0x62, 
-    0x75, 0x74, 0x20, 0x69, 0x67, 0x6e, 0x6f, 0x72, 0x65, 0x73, 0x20, 0x74, 0x6f, 
-    0x6b, 0x65, 0x6e, 0x73, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 
-    0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x5f, 0x65, 0x78, 0x74, 
-    0x28, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 
-    0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x61, 0x6d, 0x65, 0x20, 0x61, 0x73, 
-    0x20, 0x61, 0x62, 0x6f, 0x76, 0x65, 0x20, 0x62, 0x75, 0x74, 0x20, 0x77, 0x72, 
-    0x61, 0x70, 0x70, 0x65, 0x64, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
-    0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x5f, 0x65, 0x78, 
-    0x74, 0x5f, 0x77, 0x72, 0x61, 0x70, 0x70, 0x65, 0x64, 0x28, 0x73, 0x74, 0x72, 
-    0x69, 0x6e, 0x67, 0x2c, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x29, 0x0d, 0x0a, 
-    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x65, 0x65, 
-    0x73, 0x20, 0x77, 0x69, 0x74, 0x68, 0x6f, 0x75, 0x74, 0x20, 0x77, 0x61, 0x69, 
-    0x74, 0x69, 0x6e, 0x67, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 
-    0x67, 0x63, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
-    0x67, 0x6e, 0x20, 0x66, 0x72, 0x65, 0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d, 0x0d, 
-    0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x20, 0x33, 0x44, 0x20, 
-    0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x73, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 
-    0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x4d, 0x6f, 0x64, 0x65, 
-    0x6c, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x76, 0x65, 0x72, 0x74, 
-    0x65, 0x78, 0x28, 0x78, 0x2c, 0x20, 0x79, 0x2c, 0x20, 0x7a, 0x2c, 0x20, 0x75, 
-    0x2c, 0x20, 0x76, 0x29, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 
-    0x20, 0x20, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x5b, 0x78, 0x2c, 
-    0x20, 0x79, 0x2c, 0x20, 0x7a, 0x2c, 0x20, 0x75, 0x2c, 0x20, 0x76, 0x5d, 0x0d, 
-    0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
-    0x20, 0x2f, 0x2f, 0x20, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x73, 0x20, 0x61, 
-    0x20, 0x33, 0x44, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x66, 0x72, 0x6f, 
-    0x6d, 0x20, 0x61, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x76, 
-    0x65, 0x72, 0x74, 0x69, 0x63, 0x65, 0x73, 0x20, 0x2d, 0x20, 0x65, 0x78, 0x70, 
-    0x65, 0x63, 0x74, 0x73, 0x20, 0x74, 0x72, 0x69, 0x61, 0x6e, 0x67, 0x6c, 0x65, 
-    0x73, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x72, 
-    0x75, 0x63, 0x74, 0x20, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x28, 0x76, 0x65, 
-    0x72, 0x74, 0x69, 0x63, 0x65, 0x73, 0x2c, 0x20, 0x69, 0x6e, 0x64, 0x69, 0x63, 
-    0x65, 0x73, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x29, 0x20, 
-    0x7b, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 
-    0x4c, 0x6f, 0x61, 0x64, 0x73, 0x20, 0x61, 0x20, 0x33, 0x44, 0x20, 0x6d, 0x6f, 
-    0x64, 0x65, 0x6c, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x61, 0x20, 0x2e, 0x6f, 
-    0x62, 0x6a, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 
-    0x63, 0x20, 0x6c, 0x6f, 0x61, 0x64, 0x28, 0x6f, 0x62, 0x6a, 0x5f, 0x66, 0x69, 
-    0x6c, 0x65, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x29, 0x0d, 
-    0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 
-    0x63, 0x65, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x65, 0x6e, 0x67, 0x69, 0x6e, 
-    0x65, 0x20, 0x74, 0x6f, 0x20, 0x66, 0x72, 0x65, 0x65, 0x20, 0x61, 0x20, 0x6d, 
-    0x6f, 0x64, 0x65, 0x6c, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 
-    0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x65, 0x65, 0x28, 0x29, 0x0d, 0x0a, 
-    0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 0x20, 0x41, 0x20, 0x32, 0x44, 0x20, 
-    0x70, 0x6f, 0x6c, 0x79, 0x67, 0x6f, 0x6e, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 
-    0x69, 0x67, 0x6e, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x50, 0x6f, 0x6c, 
-    0x79, 0x67, 0x6f, 0x6e, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 
-    0x6f, 0x6e, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x6e, 0x65, 0x77, 0x28, 
-    0x29, 0x20, 0x7b, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 
-    0x2f, 0x20, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x73, 0x20, 0x61, 0x20, 0x70, 
-    0x6f, 0x6c, 0x79, 0x67, 0x6f, 0x6e, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x61, 
-    0x20, 0x6c, 0x69, 0x73, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x76, 0x65, 0x72, 0x74, 
-    0x69, 0x63, 0x65, 0x73, 0x20, 0x2d, 0x20, 0x74, 0x72, 0x69, 0x61, 0x6e, 0x67, 
-    0x75, 0x6c, 0x61, 0x74, 0x65, 0x73, 0x20, 0x61, 0x75, 0x74, 0x6f, 0x6d, 0x61, 
-    0x74, 0x69, 0x63, 0x61, 0x6c, 0x6c, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 
-    0x63, 0x20, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x28, 0x76, 0x65, 0x72, 0x74, 
-    0x69, 0x63, 0x65, 0x73, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
-    0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x63, 0x65, 0x73, 0x20, 0x74, 0x68, 0x65, 
-    0x20, 0x65, 0x6e, 0x67, 0x69, 0x6e, 0x65, 0x20, 0x74, 0x6f, 0x20, 0x66, 0x72, 
-    0x65, 0x65, 0x20, 0x61, 0x20, 0x70, 0x6f, 0x6c, 0x79, 0x67, 0x6f, 0x6e, 0x0d, 
+    0x20, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x5f, 0x79, 0x3d, 0x28, 0x73, 0x63, 0x61, 
+    0x6c, 0x65, 0x5f, 0x79, 0x29, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x47, 0x65, 0x74, 0x73, 0x20, 0x74, 
+    0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 
+    0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x0d, 0x0a, 0x09, 0x66, 0x6f, 
+    0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 
+    0x6e, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 
+    0x65, 0x74, 0x73, 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x73, 0x70, 0x72, 0x69, 
+    0x74, 0x65, 0x27, 0x73, 0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 
+    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
+    0x20, 0x72, 0x6f, 0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x28, 0x72, 0x6f, 
+    0x74, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x73, 0x20, 
+    0x74, 0x68, 0x65, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 0x65, 0x27, 0x73, 0x20, 
+    0x77, 0x69, 0x64, 0x74, 0x68, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 
+    0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x0d, 0x0a, 
+    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 0x75, 
+    0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x70, 0x72, 0x69, 0x74, 
+    0x65, 0x27, 0x73, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x68, 0x65, 
+    0x69, 0x67, 0x68, 0x74, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x2f, 0x2f, 
+    0x20, 0x54, 0x72, 0x75, 0x65, 0x54, 0x79, 0x70, 0x65, 0x20, 0x66, 0x6f, 0x6e, 
+    0x74, 0x73, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x63, 
+    0x6c, 0x61, 0x73, 0x73, 0x20, 0x46, 0x6f, 0x6e, 0x74, 0x20, 0x7b, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x4f, 0x70, 0x65, 0x6e, 0x73, 0x20, 
+    0x61, 0x20, 0x74, 0x74, 0x66, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x63, 0x61, 0x63, 
+    0x68, 0x65, 0x73, 0x20, 0x69, 0x74, 0x20, 0x73, 0x6f, 0x20, 0x69, 0x74, 0x20, 
+    0x63, 0x61, 0x6e, 0x20, 0x62, 0x65, 0x20, 0x64, 0x72, 0x61, 0x77, 0x6e, 0x20, 
+    0x66, 0x61, 0x73, 0x74, 0x65, 0x72, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 
+    0x6f, 0x6e, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x6f, 0x70, 0x65, 0x6e, 
+    0x28, 0x66, 0x69, 0x6c, 0x65, 0x6e, 0x61, 0x6d, 0x65, 0x2c, 0x20, 0x73, 0x69, 
+    0x7a, 0x65, 0x2c, 0x20, 0x61, 0x61, 0x2c, 0x20, 0x75, 0x6e, 0x69, 0x63, 0x6f, 
+    0x64, 0x65, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x2c, 0x20, 0x75, 0x6e, 0x69, 
+    0x63, 0x6f, 0x64, 0x65, 0x5f, 0x65, 0x6e, 0x64, 0x29, 0x20, 0x7b, 0x7d, 0x0d, 
+    0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 
+    0x75, 0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x69, 0x7a, 0x65, 
+    0x20, 0x69, 0x6e, 0x20, 0x70, 0x69, 0x78, 0x65, 0x6c, 0x73, 0x20, 0x6f, 0x66, 
+    0x20, 0x61, 0x20, 0x67, 0x69, 0x76, 0x65, 0x6e, 0x20, 0x73, 0x74, 0x72, 0x69, 
+    0x6e, 0x67, 0x20, 0x61, 0x73, 0x20, 0x5b, 0x77, 0x2c, 0x20, 0x68, 0x5d, 0x0d, 
     0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
-    0x66, 0x72, 0x65, 0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d
+    0x73, 0x69, 0x7a, 0x65, 0x28, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x29, 0x0d, 
+    0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x52, 0x65, 0x74, 
+    0x75, 0x72, 0x6e, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x69, 0x7a, 0x65, 
+    0x20, 0x6f, 0x66, 0x20, 0x61, 0x20, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x20, 
+    0x61, 0x73, 0x20, 0x69, 0x66, 0x20, 0x69, 0x74, 0x20, 0x77, 0x65, 0x72, 0x65, 
+    0x20, 0x77, 0x72, 0x61, 0x70, 0x70, 0x65, 0x64, 0x0d, 0x0a, 0x20, 0x20, 0x20, 
+    0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x69, 0x7a, 0x65, 
+    0x5f, 0x77, 0x72, 0x61, 0x70, 0x70, 0x65, 0x64, 0x28, 0x73, 0x74, 0x72, 0x69, 
+    0x6e, 0x67, 0x2c, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x29, 0x0d, 0x0a, 0x0d, 
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x53, 0x61, 0x6d, 0x65, 0x20, 
+    0x61, 0x73, 0x20, 0x61, 0x62, 0x6f, 0x76, 0x65, 0x20, 0x62, 0x75, 0x74, 0x20, 
+    0x69, 0x67, 0x6e, 0x6f, 0x72, 0x65, 0x73, 0x20, 0x74, 0x6f, 0x6b, 0x65, 0x6e, 
+    0x73, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 
+    0x6e, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x5f, 0x65, 0x78, 0x74, 0x28, 0x73, 0x74, 
+    0x72, 0x69, 0x6e, 0x67, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 
+    0x2f, 0x2f, 0x20, 0x53, 0x61, 0x6d, 0x65, 0x20, 0x61, 0x73, 0x20, 0x61, 0x62, 
+    0x6f, 0x76, 0x65, 0x20, 0x62, 0x75, 0x74, 0x20, 0x77, 0x72, 0x61, 0x70, 0x70, 
+    0x65, 0x64, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 
+    0x67, 0x6e, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x5f, 0x65, 0x78, 0x74, 0x5f, 0x77, 
+    0x72, 0x61, 0x70, 0x70, 0x65, 0x64, 0x28, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 
+    0x2c, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 
+    0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x46, 0x72, 0x65, 0x65, 0x73, 0x20, 0x77, 
+    0x69, 0x74, 0x68, 0x6f, 0x75, 0x74, 0x20, 0x77, 0x61, 0x69, 0x74, 0x69, 0x6e, 
+    0x67, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x67, 0x63, 0x0d, 
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
+    0x66, 0x72, 0x65, 0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 
+    0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x20, 0x33, 0x44, 0x20, 0x6d, 0x6f, 0x64, 
+    0x65, 0x6c, 0x73, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 
+    0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x7b, 
+    0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x76, 0x65, 0x72, 0x74, 0x65, 0x78, 0x28, 
+    0x78, 0x2c, 0x20, 0x79, 0x2c, 0x20, 0x7a, 0x2c, 0x20, 0x75, 0x2c, 0x20, 0x76, 
+    0x29, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 
+    0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x5b, 0x78, 0x2c, 0x20, 0x79, 0x2c, 
+    0x20, 0x7a, 0x2c, 0x20, 0x75, 0x2c, 0x20, 0x76, 0x5d, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x20, 0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 
+    0x20, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x73, 0x20, 0x61, 0x20, 0x33, 0x44, 
+    0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x61, 
+    0x20, 0x6c, 0x69, 0x73, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x76, 0x65, 0x72, 0x74, 
+    0x69, 0x63, 0x65, 0x73, 0x20, 0x2d, 0x20, 0x65, 0x78, 0x70, 0x65, 0x63, 0x74, 
+    0x73, 0x20, 0x74, 0x72, 0x69, 0x61, 0x6e, 0x67, 0x6c, 0x65, 0x73, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 
+    0x20, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x28, 0x76, 0x65, 0x72, 0x74, 0x69, 
+    0x63, 0x65, 0x73, 0x2c, 0x20, 0x69, 0x6e, 0x64, 0x69, 0x63, 0x65, 0x73, 0x2c, 
+    0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x29, 0x20, 0x7b, 0x7d, 0x0d, 
+    0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x4c, 0x6f, 0x61, 
+    0x64, 0x73, 0x20, 0x61, 0x20, 0x33, 0x44, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x6c, 
+    0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x61, 0x20, 0x2e, 0x6f, 0x62, 0x6a, 0x20, 
+    0x66, 0x69, 0x6c, 0x65, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 
+    0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 0x6c, 
+    0x6f, 0x61, 0x64, 0x28, 0x6f, 0x62, 0x6a, 0x5f, 0x66, 0x69, 0x6c, 0x65, 0x2c, 
+    0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 
+    0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x46, 0x6f, 0x72, 0x63, 0x65, 0x73, 
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x65, 0x6e, 0x67, 0x69, 0x6e, 0x65, 0x20, 0x74, 
+    0x6f, 0x20, 0x66, 0x72, 0x65, 0x65, 0x20, 0x61, 0x20, 0x6d, 0x6f, 0x64, 0x65, 
+    0x6c, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 
+    0x6e, 0x20, 0x66, 0x72, 0x65, 0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d, 0x0d, 0x0a, 
+    0x0d, 0x0a, 0x2f, 0x2f, 0x20, 0x41, 0x20, 0x32, 0x44, 0x20, 0x70, 0x6f, 0x6c, 
+    0x79, 0x67, 0x6f, 0x6e, 0x0d, 0x0a, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 
+    0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x50, 0x6f, 0x6c, 0x79, 0x67, 0x6f, 
+    0x6e, 0x20, 0x7b, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 
+    0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x6e, 0x65, 0x77, 0x28, 0x29, 0x20, 0x7b, 
+    0x7d, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x43, 
+    0x72, 0x65, 0x61, 0x74, 0x65, 0x73, 0x20, 0x61, 0x20, 0x70, 0x6f, 0x6c, 0x79, 
+    0x67, 0x6f, 0x6e, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20, 0x61, 0x20, 0x6c, 0x69, 
+    0x73, 0x74, 0x20, 0x6f, 0x66, 0x20, 0x76, 0x65, 0x72, 0x74, 0x69, 0x63, 0x65, 
+    0x73, 0x20, 0x2d, 0x20, 0x74, 0x72, 0x69, 0x61, 0x6e, 0x67, 0x75, 0x6c, 0x61, 
+    0x74, 0x65, 0x73, 0x20, 0x61, 0x75, 0x74, 0x6f, 0x6d, 0x61, 0x74, 0x69, 0x63, 
+    0x61, 0x6c, 0x6c, 0x79, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x72, 
+    0x65, 0x69, 0x67, 0x6e, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x20, 0x63, 
+    0x72, 0x65, 0x61, 0x74, 0x65, 0x28, 0x76, 0x65, 0x72, 0x74, 0x69, 0x63, 0x65, 
+    0x73, 0x29, 0x0d, 0x0a, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 
+    0x46, 0x6f, 0x72, 0x63, 0x65, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x65, 0x6e, 
+    0x67, 0x69, 0x6e, 0x65, 0x20, 0x74, 0x6f, 0x20, 0x66, 0x72, 0x65, 0x65, 0x20, 
+    0x61, 0x20, 0x70, 0x6f, 0x6c, 0x79, 0x67, 0x6f, 0x6e, 0x0d, 0x0a, 0x20, 0x20, 
+    0x20, 0x20, 0x66, 0x6f, 0x72, 0x65, 0x69, 0x67, 0x6e, 0x20, 0x66, 0x72, 0x65, 
+    0x65, 0x28, 0x29, 0x0d, 0x0a, 0x7d
 };
 
 const char ENGINE_WREN_SOURCE[] = {
@@ -8,6 +8,7 @@
 #include "src/WrenHeaders.h"
 #include "src/Packer.h"
 #include "src/Runtime.h"
+#include "src/Util.h"
 
 const char WREN_SOURCE_HEADER[] = "import \"lib/Audio\" for AudioData, Audio\n"
 								  "import \"lib/Drawing\" for Surface, Font, BitmapFont, Sprite, Texture, Model, Polygon, LightSource, Shadow, Lighting\n"
@@ -50,6 +51,7 @@ const char *vksk_PreprocessSource(const char *filename) {
 			strcmp(filename, "data/game/lib/Audio.wren") != 0 && strcmp(filename, "data/game/lib/Tiled.wren") != 0 && strcmp(filename, "Assets.wren") != 0) {
 		const char *temp;
 
+		vksk_TraceFileAccess(filename);
 		if (vksk_PakFileExists(gGamePak, filename)) {
 			temp = vksk_PakGetFileString(gGamePak, filename);
 		} else {